@@ -0,0 +1,14 @@
+#version 330 core
+
+// Streamed debug geometry (DebugDraw): world-space position, RGBA8 color
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec4 aColor;
+
+uniform mat4 uViewProjection;
+
+out vec4 Color;
+
+void main() {
+    Color = aColor;
+    gl_Position = uViewProjection * vec4(aPos, 1.0);
+}
@@ -3,11 +3,16 @@
 in vec3 FragPos;
 in vec3 Normal;
 in vec2 TexCoord;
+in float TexLayer;
+in vec3 InstanceColor;
 
 out vec4 FragColor;
 
 // Material
 uniform sampler2D uTexture;
+uniform sampler2DArray uTextureArrays[4];   // World materials, one array per size class
+uniform int uLayerSlots[256];               // Vertex layer -> array << 16 | slice
+uniform bool uUseTextureArray;
 uniform vec3 uColor;
 
 // Lighting
@@ -20,9 +25,25 @@ uniform float uAmbientStrength;
 uniform float uSpecularStrength;
 uniform float uShininess;
 
+vec3 SampleMaterial() {
+    int slot = uLayerSlots[clamp(int(TexLayer + 0.5), 0, 255)];
+    vec3 coord = vec3(TexCoord, float(slot & 0xFFFF));
+
+    // Sampler arrays need constant indices here; gradients are taken outside the
+    // branches so mip selection stays defined where neighbouring faces differ
+    vec2 dx = dFdx(TexCoord);
+    vec2 dy = dFdy(TexCoord);
+    int arrayIndex = slot >> 16;
+    if (arrayIndex == 0) return textureGrad(uTextureArrays[0], coord, dx, dy).rgb;
+    if (arrayIndex == 1) return textureGrad(uTextureArrays[1], coord, dx, dy).rgb;
+    if (arrayIndex == 2) return textureGrad(uTextureArrays[2], coord, dx, dy).rgb;
+    return textureGrad(uTextureArrays[3], coord, dx, dy).rgb;
+}
+
 void main() {
     // Sample texture
-    vec3 textureColor = texture(uTexture, TexCoord).rgb * uColor;
+    vec3 textureColor = uUseTextureArray ? SampleMaterial() : texture(uTexture, TexCoord).rgb;
+    textureColor *= uColor * InstanceColor;
     
     // Normalize vectors
     vec3 norm = normalize(Normal);
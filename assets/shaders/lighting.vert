@@ -1,26 +1,39 @@
 #version 330 core
 
+// Locations 0-3 are fed either from float vertices or from PackedVertex
+// (10:10:10:2 normal, half-float UVs, uint16 layer); the vertex fetch converts
+// both to float (the fragment shader renormalizes the slightly off-unit normal)
 layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec3 aNormal;
 layout(location = 2) in vec2 aTexCoord;
+layout(location = 3) in float aTexLayer;
+layout(location = 4) in mat4 aInstanceModel;    // Locations 4-7, per instance
+layout(location = 8) in vec4 aInstanceColor;
 
 uniform mat4 uModel;
+uniform bool uInstanced;    // Take model/color from instance attributes instead of uModel
 uniform mat4 uView;
 uniform mat4 uProjection;
 
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoord;
+out float TexLayer;
+out vec3 InstanceColor;
 
 void main() {
+    mat4 model = uInstanced ? aInstanceModel : uModel;
+    InstanceColor = uInstanced ? aInstanceColor.rgb : vec3(1.0);
+
     // Transform position to world space
-    FragPos = vec3(uModel * vec4(aPos, 1.0));
+    FragPos = vec3(model * vec4(aPos, 1.0));
     
     // Transform normal to world space (use normal matrix to handle non-uniform scaling)
-    Normal = mat3(transpose(inverse(uModel))) * aNormal;
+    Normal = mat3(transpose(inverse(model))) * aNormal;
     
     // Pass texture coordinates
     TexCoord = aTexCoord;
+    TexLayer = aTexLayer;
     
     // Final position in clip space
     gl_Position = uProjection * uView * vec4(FragPos, 1.0);
@@ -0,0 +1,163 @@
+#include "Broadphase.h"
+#include <algorithm>
+#include <cmath>
+
+namespace VibeReaper {
+
+    namespace {
+        // Cell coordinates are packed into 21 bits each (about +-1M cells per axis)
+        const int CELL_BIAS = 1 << 20;
+        const int CELL_LIMIT = CELL_BIAS - 1;
+
+        int ToCell(float value, float inverseCellSize) {
+            int cell = static_cast<int>(std::floor(value * inverseCellSize));
+            return std::clamp(cell, -CELL_LIMIT, CELL_LIMIT);
+        }
+    }
+
+    bool Broadphase::CellRange::operator==(const CellRange& other) const {
+        return minX == other.minX && minY == other.minY && minZ == other.minZ &&
+               maxX == other.maxX && maxY == other.maxY && maxZ == other.maxZ;
+    }
+
+    Broadphase::Broadphase(float cellSize)
+        : cellSize(cellSize), inverseCellSize(1.0f / cellSize), queryStamp(0), updateCount(0), rebinCount(0) {
+    }
+
+    void Broadphase::Clear() {
+        proxies.clear();
+        freeProxies.clear();
+        cells.clear();
+        queryStamps.clear();
+        queryStamp = 0;
+        updateCount = 0;
+        rebinCount = 0;
+    }
+
+    uint32_t Broadphase::Insert(const AABB& bounds, uint32_t userData) {
+        uint32_t proxy;
+        if (!freeProxies.empty()) {
+            proxy = freeProxies.back();
+            freeProxies.pop_back();
+        } else {
+            proxy = static_cast<uint32_t>(proxies.size());
+            proxies.emplace_back();
+            queryStamps.push_back(0);
+        }
+
+        Proxy& entry = proxies[proxy];
+        entry.bounds = bounds;
+        entry.cells = GetCellRange(bounds);
+        entry.userData = userData;
+        entry.active = true;
+        AddToCells(proxy, entry.cells);
+        return proxy;
+    }
+
+    void Broadphase::Update(uint32_t proxy, const AABB& bounds) {
+        Proxy& entry = proxies[proxy];
+        entry.bounds = bounds;
+        updateCount++;
+
+        CellRange range = GetCellRange(bounds);
+        if (range == entry.cells) return;
+
+        RemoveFromCells(proxy, entry.cells);
+        entry.cells = range;
+        AddToCells(proxy, range);
+        rebinCount++;
+    }
+
+    void Broadphase::Remove(uint32_t proxy) {
+        Proxy& entry = proxies[proxy];
+        if (!entry.active) return;
+
+        RemoveFromCells(proxy, entry.cells);
+        entry.active = false;
+        freeProxies.push_back(proxy);
+    }
+
+    void Broadphase::Query(const AABB& bounds, std::vector<uint32_t>& out) const {
+        // Stamps wrap after 4G queries; reset them rather than risk a stale match
+        if (++queryStamp == 0) {
+            std::fill(queryStamps.begin(), queryStamps.end(), 0);
+            queryStamp = 1;
+        }
+
+        CellRange range = GetCellRange(bounds);
+        for (int x = range.minX; x <= range.maxX; x++) {
+            for (int y = range.minY; y <= range.maxY; y++) {
+                for (int z = range.minZ; z <= range.maxZ; z++) {
+                    auto it = cells.find(CellKey(x, y, z));
+                    if (it == cells.end()) continue;
+
+                    for (uint32_t proxy : it->second) {
+                        if (queryStamps[proxy] == queryStamp) continue;
+                        queryStamps[proxy] = queryStamp;
+                        if (proxies[proxy].bounds.Intersects(bounds)) {
+                            out.push_back(proxy);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    BroadphaseStats Broadphase::GetStats() const {
+        BroadphaseStats stats;
+        stats.proxies = proxies.size() - freeProxies.size();
+        stats.cells = cells.size();
+        stats.updates = updateCount;
+        stats.rebins = rebinCount;
+        return stats;
+    }
+
+    Broadphase::CellRange Broadphase::GetCellRange(const AABB& bounds) const {
+        CellRange range;
+        range.minX = ToCell(bounds.min.x, inverseCellSize);
+        range.minY = ToCell(bounds.min.y, inverseCellSize);
+        range.minZ = ToCell(bounds.min.z, inverseCellSize);
+        range.maxX = ToCell(bounds.max.x, inverseCellSize);
+        range.maxY = ToCell(bounds.max.y, inverseCellSize);
+        range.maxZ = ToCell(bounds.max.z, inverseCellSize);
+        return range;
+    }
+
+    uint64_t Broadphase::CellKey(int x, int y, int z) {
+        return (static_cast<uint64_t>(x + CELL_BIAS) << 42) |
+               (static_cast<uint64_t>(y + CELL_BIAS) << 21) |
+               static_cast<uint64_t>(z + CELL_BIAS);
+    }
+
+    void Broadphase::AddToCells(uint32_t proxy, const CellRange& range) {
+        for (int x = range.minX; x <= range.maxX; x++) {
+            for (int y = range.minY; y <= range.maxY; y++) {
+                for (int z = range.minZ; z <= range.maxZ; z++) {
+                    cells[CellKey(x, y, z)].push_back(proxy);
+                }
+            }
+        }
+    }
+
+    void Broadphase::RemoveFromCells(uint32_t proxy, const CellRange& range) {
+        for (int x = range.minX; x <= range.maxX; x++) {
+            for (int y = range.minY; y <= range.maxY; y++) {
+                for (int z = range.minZ; z <= range.maxZ; z++) {
+                    auto it = cells.find(CellKey(x, y, z));
+                    if (it == cells.end()) continue;
+
+                    std::vector<uint32_t>& list = it->second;
+                    auto found = std::find(list.begin(), list.end(), proxy);
+                    if (found != list.end()) {
+                        *found = list.back();
+                        list.pop_back();
+                    }
+                    if (list.empty()) {
+                        cells.erase(it);
+                    }
+                }
+            }
+        }
+    }
+
+} // namespace VibeReaper
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Collision.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace VibeReaper {
+
+    struct BroadphaseStats {
+        size_t proxies = 0;
+        size_t cells = 0;           // Occupied grid cells
+        size_t updates = 0;         // Update() calls
+        size_t rebins = 0;          // Updates that changed the covered cells
+    };
+
+    /**
+     * @brief Uniform grid (spatial hash) over world AABBs
+     *
+     * Each proxy is listed in every cell its box touches. Update() only touches
+     * the grid when the covered cell range changes, so a door sliding inside its
+     * cells costs a bounds copy. Static level geometry and moving brush entities
+     * share one grid; Query() replaces testing every object.
+     */
+    class Broadphase {
+    public:
+        explicit Broadphase(float cellSize = 256.0f);
+
+        void Clear();
+
+        // Returns a proxy handle; userData is whatever the owner needs to find the object
+        uint32_t Insert(const AABB& bounds, uint32_t userData);
+        void Update(uint32_t proxy, const AABB& bounds);
+        void Remove(uint32_t proxy);
+
+        // Appends every proxy overlapping bounds, each once (out is not cleared).
+        // Not thread-safe: dedup stamps are shared between queries.
+        void Query(const AABB& bounds, std::vector<uint32_t>& out) const;
+
+        const AABB& GetBounds(uint32_t proxy) const { return proxies[proxy].bounds; }
+        uint32_t GetUserData(uint32_t proxy) const { return proxies[proxy].userData; }
+        float GetCellSize() const { return cellSize; }
+        BroadphaseStats GetStats() const;
+
+    private:
+        struct CellRange {
+            int minX, minY, minZ;
+            int maxX, maxY, maxZ;
+            bool operator==(const CellRange& other) const;
+        };
+
+        struct Proxy {
+            AABB bounds;
+            CellRange cells;
+            uint32_t userData;
+            bool active;
+        };
+
+        CellRange GetCellRange(const AABB& bounds) const;
+        static uint64_t CellKey(int x, int y, int z);
+        void AddToCells(uint32_t proxy, const CellRange& range);
+        void RemoveFromCells(uint32_t proxy, const CellRange& range);
+
+        float cellSize;
+        float inverseCellSize;
+        std::vector<Proxy> proxies;
+        std::vector<uint32_t> freeProxies;
+        std::unordered_map<uint64_t, std::vector<uint32_t>> cells;
+
+        // Query() dedup: a proxy is skipped once its stamp matches the query's
+        mutable std::vector<uint32_t> queryStamps;
+        mutable uint32_t queryStamp;
+
+        size_t updateCount;
+        size_t rebinCount;
+    };
+
+} // namespace VibeReaper
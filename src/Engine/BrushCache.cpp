@@ -0,0 +1,262 @@
+#include "BrushCache.h"
+#include "JobSystem.h"
+#include "../Utils/Logger.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+namespace VibeReaper {
+
+    namespace {
+        const char CACHE_MAGIC[4] = { 'V', 'B', 'R', 'C' };
+        const uint32_t CACHE_VERSION = 1;           // Bump when BrushConverter's output changes
+        const uint32_t MAX_ELEMENTS = 1u << 20;     // Per array; anything larger is corruption
+        const size_t CONVERT_GRAIN = 16;
+
+        const uint64_t FNV_PRIME = 1099511628211ull;
+
+        void MixBytes(uint64_t& hash, const void* data, size_t size) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; i++) {
+                hash ^= bytes[i];
+                hash *= FNV_PRIME;
+            }
+        }
+
+        template <typename T>
+        void WriteArray(std::ofstream& file, const std::vector<T>& values) {
+            file.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+        }
+
+        template <typename T>
+        void ReadArray(std::ifstream& file, std::vector<T>& values, uint32_t count) {
+            values.resize(count);
+            file.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+        }
+
+        void WriteBounds(std::ofstream& file, const AABB& bounds) {
+            file.write(reinterpret_cast<const char*>(&bounds.min), sizeof(float) * 3);
+            file.write(reinterpret_cast<const char*>(&bounds.max), sizeof(float) * 3);
+        }
+
+        void ReadBounds(std::ifstream& file, AABB& bounds) {
+            file.read(reinterpret_cast<char*>(&bounds.min), sizeof(float) * 3);
+            file.read(reinterpret_cast<char*>(&bounds.max), sizeof(float) * 3);
+        }
+
+        bool IsFinite(const glm::vec3& value) {
+            return std::isfinite(value.x) && std::isfinite(value.y) && std::isfinite(value.z);
+        }
+
+        bool AreIndicesValid(const std::vector<unsigned int>& indices, size_t vertexCount) {
+            if (indices.size() % 3 != 0) return false;
+            for (unsigned int index : indices) {
+                if (index >= vertexCount) return false;
+            }
+            return true;
+        }
+
+        // Lengths alone are not enough: an index past its vertices would be read
+        // out of bounds by glDrawElements, and NaNs break culling and collision
+        bool IsValidGeometry(const BrushGeometry& geometry) {
+            if (!AreIndicesValid(geometry.indices, geometry.vertices.size()) ||
+                !AreIndicesValid(geometry.collision.indices, geometry.collision.positions.size())) {
+                return false;
+            }
+            for (const Vertex& vertex : geometry.vertices) {
+                if (!IsFinite(vertex.position) || !IsFinite(vertex.normal) || !std::isfinite(vertex.texCoord.x) ||
+                    !std::isfinite(vertex.texCoord.y) || !std::isfinite(vertex.texLayer)) {
+                    return false;
+                }
+            }
+            for (const glm::vec3& position : geometry.collision.positions) {
+                if (!IsFinite(position)) return false;
+            }
+            return IsFinite(geometry.bounds.min) && IsFinite(geometry.bounds.max) &&
+                   IsFinite(geometry.collision.bounds.min) && IsFinite(geometry.collision.bounds.max);
+        }
+
+        double ElapsedMs(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    uint64_t BrushCache::MakeKey(const Brush& brush, const MaterialPacker* materials, bool buildCollision) {
+        uint64_t key = brush.Hash();
+        uint8_t flags = (materials ? 1 : 0) | (buildCollision ? 2 : 0);
+        MixBytes(key, &flags, sizeof(flags));
+
+        // Layers are baked into the vertices, and depend on the level's texture order
+        if (materials) {
+            for (const Plane& plane : brush.planes) {
+                int32_t layer = materials->GetLayer(plane.texture);
+                MixBytes(key, &layer, sizeof(layer));
+            }
+        }
+        return key;
+    }
+
+    std::string BrushCache::GetCachePath(const std::string& mapPath) {
+        size_t dot = mapPath.find_last_of('.');
+        size_t slash = mapPath.find_last_of("/\\");
+        if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+            return mapPath + ".brushes";
+        }
+        return mapPath.substr(0, dot) + ".brushes";
+    }
+
+    bool BrushCache::Load(const std::string& path) {
+        Clear();
+
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+
+        auto start = std::chrono::steady_clock::now();
+
+        char magic[4];
+        uint32_t version = 0;
+        uint32_t count = 0;
+        file.read(magic, sizeof(magic));
+        file.read(reinterpret_cast<char*>(&version), sizeof(version));
+        file.read(reinterpret_cast<char*>(&count), sizeof(count));
+        if (!file || std::memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0 || version != CACHE_VERSION) {
+            LOG_WARNING("Ignoring incompatible brush cache: " + path);
+            return false;
+        }
+
+        entries.reserve(count);
+        for (uint32_t i = 0; i < count; i++) {
+            uint64_t key = 0;
+            uint32_t sizes[4] = {};     // vertices, indices, collision positions, collision indices
+            BrushGeometry geometry;
+            file.read(reinterpret_cast<char*>(&key), sizeof(key));
+            ReadBounds(file, geometry.bounds);
+            ReadBounds(file, geometry.collision.bounds);
+            file.read(reinterpret_cast<char*>(sizes), sizeof(sizes));
+            if (!file || sizes[0] > MAX_ELEMENTS || sizes[1] > MAX_ELEMENTS || sizes[2] > MAX_ELEMENTS ||
+                sizes[3] > MAX_ELEMENTS) {
+                LOG_WARNING("Corrupt brush cache: " + path);
+                Clear();
+                return false;
+            }
+
+            ReadArray(file, geometry.vertices, sizes[0]);
+            ReadArray(file, geometry.indices, sizes[1]);
+            ReadArray(file, geometry.collision.positions, sizes[2]);
+            ReadArray(file, geometry.collision.indices, sizes[3]);
+            if (!file) {
+                LOG_WARNING("Truncated brush cache: " + path);
+                Clear();
+                return false;
+            }
+            if (!IsValidGeometry(geometry)) {
+                LOG_WARNING("Corrupt brush cache: " + path);
+                Clear();
+                return false;
+            }
+            entries.emplace(key, std::move(geometry));
+        }
+
+        stats.loaded = entries.size();
+        stats.loadMs = ElapsedMs(start);
+        LOG_CAT_INFO(Map, "Brush cache loaded from {}: {} meshes in {} ms", path, stats.loaded, stats.loadMs);
+        return true;
+    }
+
+    bool BrushCache::Save(const std::string& path) const {
+        // Written beside the cache and renamed over it, so a crash mid-save leaves
+        // the old file (or none) instead of a half-written one
+        std::string tempPath = path + ".tmp";
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            LOG_WARNING("Failed to write brush cache: " + path);
+            return false;
+        }
+
+        uint32_t count = static_cast<uint32_t>(used.size());
+        file.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        file.write(reinterpret_cast<const char*>(&CACHE_VERSION), sizeof(CACHE_VERSION));
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+
+        for (uint64_t key : used) {
+            const BrushGeometry& geometry = entries.at(key);
+            uint32_t sizes[4] = {
+                static_cast<uint32_t>(geometry.vertices.size()), static_cast<uint32_t>(geometry.indices.size()),
+                static_cast<uint32_t>(geometry.collision.positions.size()),
+                static_cast<uint32_t>(geometry.collision.indices.size())
+            };
+            file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+            WriteBounds(file, geometry.bounds);
+            WriteBounds(file, geometry.collision.bounds);
+            file.write(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+            WriteArray(file, geometry.vertices);
+            WriteArray(file, geometry.indices);
+            WriteArray(file, geometry.collision.positions);
+            WriteArray(file, geometry.collision.indices);
+        }
+
+        file.close();
+        std::error_code error;
+        if (!file) {
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+        std::filesystem::rename(tempPath, path, error);
+        if (error) {
+            LOG_WARNING("Failed to replace brush cache " + path + ": " + error.message());
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+        return true;
+    }
+
+    std::vector<BrushGeometry> BrushCache::Convert(const std::vector<Brush>& brushes, const std::vector<uint64_t>& keys,
+                                                   const std::vector<uint32_t>& indices, JobSystem& jobs,
+                                                   const MaterialPacker* materials, bool buildCollision) {
+        std::vector<BrushGeometry> result(indices.size());
+        std::vector<size_t> missing;
+        for (size_t j = 0; j < indices.size(); j++) {
+            uint64_t key = keys[indices[j]];
+            auto it = entries.find(key);
+            if (it != entries.end()) {
+                result[j] = it->second;
+                used.insert(key);
+                stats.hits++;
+            } else {
+                missing.push_back(j);
+            }
+        }
+
+        // The packer is only read, as in BrushConverter::ConvertBrushes
+        jobs.ParallelFor(missing.size(), CONVERT_GRAIN, [&](size_t begin, size_t end) {
+            for (size_t m = begin; m < end; m++) {
+                size_t j = missing[m];
+                result[j] = BrushConverter::ConvertBrush(brushes[indices[j]], materials, buildCollision);
+            }
+        });
+
+        for (size_t j : missing) {
+            uint64_t key = keys[indices[j]];
+            entries[key] = result[j];
+            used.insert(key);
+            stats.misses++;
+        }
+        return result;
+    }
+
+    void BrushCache::MarkUsed(uint64_t key) {
+        if (entries.count(key)) {
+            used.insert(key);
+        }
+    }
+
+    void BrushCache::Clear() {
+        entries.clear();
+        used.clear();
+        stats = BrushCacheStats();
+    }
+
+} // namespace VibeReaper
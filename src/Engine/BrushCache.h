@@ -0,0 +1,71 @@
+#pragma once
+
+#include "BrushConverter.h"
+#include "MapLoader.h"
+#include "MaterialPacker.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace VibeReaper {
+
+    class JobSystem;
+
+    struct BrushCacheStats {
+        size_t loaded = 0;          // Entries read by the last Load()
+        size_t hits = 0;            // Convert() served from the cache since Load()
+        size_t misses = 0;          // Converted and added since Load()
+        double loadMs = 0.0;
+    };
+
+    /**
+     * @brief Converted brush geometry keyed by brush content, persisted next to the map
+     *
+     * Keys (MakeKey) combine Brush::Hash() with the conversion inputs that live
+     * outside the brush: each face's texture array layer and whether a collision
+     * copy is built. Convert() copies cached geometry for known keys and converts
+     * the rest in parallel, so after Load() a level whose brushes are mostly
+     * unchanged skips almost all triangulation. Save() writes only the entries
+     * used since Load(), which drops brushes deleted from the map.
+     *
+     * Not thread-safe; Convert() parallelizes internally.
+     */
+    class BrushCache {
+    public:
+        static uint64_t MakeKey(const Brush& brush, const MaterialPacker* materials, bool buildCollision);
+
+        // foo.map -> foo.brushes
+        static std::string GetCachePath(const std::string& mapPath);
+
+        // Replace the contents with a cache file; false (and empty) if it is missing,
+        // from another version or corrupt
+        bool Load(const std::string& path);
+        bool Save(const std::string& path) const;
+
+        // result[j] is the geometry of brushes[indices[j]] under keys[indices[j]]: cached
+        // entries are copied, the rest converted on the job system and added
+        std::vector<BrushGeometry> Convert(const std::vector<Brush>& brushes, const std::vector<uint64_t>& keys,
+                                           const std::vector<uint32_t>& indices, JobSystem& jobs,
+                                           const MaterialPacker* materials, bool buildCollision);
+
+        // Keep an entry in the next Save() without converting (its mesh was reused elsewhere)
+        void MarkUsed(uint64_t key);
+
+        // New entries were added or loaded ones went unused since Load()
+        bool IsDirty() const { return stats.misses > 0 || used.size() != entries.size(); }
+
+        void Clear();
+
+        size_t GetEntryCount() const { return entries.size(); }
+        const BrushCacheStats& GetStats() const { return stats; }
+
+    private:
+        std::unordered_map<uint64_t, BrushGeometry> entries;
+        std::unordered_set<uint64_t> used;
+        BrushCacheStats stats;
+    };
+
+} // namespace VibeReaper
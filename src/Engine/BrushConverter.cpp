@@ -1,15 +1,29 @@
 #include "BrushConverter.h"
+#include "JobSystem.h"
 #include "../Utils/Logger.h"
 #include <glm/gtc/matrix_inverse.hpp>
 #include <algorithm>
+#include <cfloat>
 #include <cmath>
+#include <utility>
 
 namespace VibeReaper {
 
-    Mesh BrushConverter::ConvertBrushToMesh(const Brush& brush) {
+    namespace {
+        // Brushes per job: a box brush converts in a few microseconds
+        const size_t BRUSH_GRAIN = 16;
+    }
+
+    Mesh BrushConverter::ConvertBrushToMesh(const Brush& brush, const MaterialPacker* materials) {
+        BrushGeometry geometry = ConvertBrush(brush, materials);
+        return Mesh(std::move(geometry.vertices), std::move(geometry.indices));
+    }
+
+    BrushGeometry BrushConverter::ConvertBrush(const Brush& brush, const MaterialPacker* materials, bool buildCollision) {
+        BrushGeometry geometry;
         if (brush.planes.size() < 4) {
             LOG_WARNING("Brush has less than 4 planes, cannot form a 3D solid");
-            return Mesh();
+            return geometry;
         }
 
         // Step 1: Calculate all vertices
@@ -17,37 +31,48 @@ namespace VibeReaper {
 
         if (vertices.empty()) {
             LOG_WARNING("Brush generated no vertices");
-            return Mesh();
+            return geometry;
         }
 
-        LOG_INFO("Brush has " + std::to_string(vertices.size()) + " vertices");
+        LOG_CAT_DEBUG(Map, "Brush has {} vertices", vertices.size());
 
         // Step 2: Build faces
-        std::vector<Vertex> meshVertices = BuildFaces(brush.planes, vertices);
+        geometry.vertices = BuildFaces(brush.planes, vertices, materials);
 
-        if (meshVertices.empty()) {
+        if (geometry.vertices.empty()) {
             LOG_WARNING("Brush generated no faces");
-            return Mesh();
+            return geometry;
         }
 
         // Step 3: Create indices (simple sequential since we're using triangle lists)
-        std::vector<unsigned int> indices;
-        for (unsigned int i = 0; i < meshVertices.size(); i++) {
-            indices.push_back(i);
+        geometry.indices.resize(geometry.vertices.size());
+        for (unsigned int i = 0; i < geometry.indices.size(); i++) {
+            geometry.indices[i] = i;
         }
 
-        LOG_INFO("Generated mesh with " + std::to_string(meshVertices.size()) + " vertices and " + 
-                 std::to_string(indices.size() / 3) + " triangles");
+        LOG_CAT_DEBUG(Map, "Generated mesh with {} vertices and {} triangles",
+                      geometry.vertices.size(), geometry.indices.size() / 3);
+
+        glm::vec3 bmin(FLT_MAX), bmax(-FLT_MAX);
+        for (const auto& vertex : geometry.vertices) {
+            bmin = glm::min(bmin, vertex.position);
+            bmax = glm::max(bmax, vertex.position);
+        }
+        geometry.bounds = AABB(bmin, bmax);
 
-        return Mesh(meshVertices, indices);
+        if (buildCollision) {
+            geometry.collision = Mesh::BuildCollision(geometry.vertices, geometry.indices);
+        }
+        return geometry;
     }
 
-    std::vector<Mesh> BrushConverter::ConvertBrushesToMeshes(const std::vector<Brush>& brushes) {
+    std::vector<Mesh> BrushConverter::ConvertBrushesToMeshes(const std::vector<Brush>& brushes,
+                                                             const MaterialPacker* materials) {
         std::vector<Mesh> meshes;
         meshes.reserve(brushes.size());
 
         for (const auto& brush : brushes) {
-            Mesh mesh = ConvertBrushToMesh(brush);
+            Mesh mesh = ConvertBrushToMesh(brush, materials);
             if (!mesh.vertices.empty()) {
                 meshes.push_back(std::move(mesh));
             }
@@ -56,6 +81,18 @@ namespace VibeReaper {
         return meshes;
     }
 
+    std::vector<BrushGeometry> BrushConverter::ConvertBrushes(const std::vector<Brush>& brushes, JobSystem& jobs,
+                                                              const MaterialPacker* materials, bool buildCollision) {
+        // Each brush only reads its own planes and writes its own slot
+        std::vector<BrushGeometry> results(brushes.size());
+        jobs.ParallelFor(brushes.size(), BRUSH_GRAIN, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                results[i] = ConvertBrush(brushes[i], materials, buildCollision);
+            }
+        });
+        return results;
+    }
+
     std::vector<glm::vec3> BrushConverter::CalculateVertices(const std::vector<Plane>& planes) {
         std::vector<glm::vec3> vertices;
         int n = static_cast<int>(planes.size());
@@ -123,12 +160,13 @@ namespace VibeReaper {
         return true;
     }
 
-    std::vector<Vertex> BrushConverter::BuildFaces(const std::vector<Plane>& planes, const std::vector<glm::vec3>& vertices) {
+    std::vector<Vertex> BrushConverter::BuildFaces(const std::vector<Plane>& planes, const std::vector<glm::vec3>& vertices,
+                                                   const MaterialPacker* materials) {
         std::vector<Vertex> allVertices;
 
         // Build a face for each plane
         for (const auto& plane : planes) {
-            std::vector<Vertex> faceVertices = BuildFace(plane, vertices);
+            std::vector<Vertex> faceVertices = BuildFace(plane, vertices, materials);
             
             if (faceVertices.size() >= 3) {
                 // Triangulate the face (fan triangulation from first vertex)
@@ -143,7 +181,8 @@ namespace VibeReaper {
         return allVertices;
     }
 
-    std::vector<Vertex> BrushConverter::BuildFace(const Plane& plane, const std::vector<glm::vec3>& vertices) {
+    std::vector<Vertex> BrushConverter::BuildFace(const Plane& plane, const std::vector<glm::vec3>& vertices,
+                                                  const MaterialPacker* materials) {
         // Find all vertices that lie on this plane
         std::vector<glm::vec3> faceVertices;
 
@@ -167,10 +206,24 @@ namespace VibeReaper {
             Vertex v;
             v.position = pos;
             v.normal = plane.normal;
-            v.texCoord = CalculateUV(pos, plane);
+            glm::vec3 uvLayer = CalculateUV(pos, plane, materials);
+            v.texCoord = glm::vec2(uvLayer.x, uvLayer.y);
+            v.texLayer = uvLayer.z;
             result.push_back(v);
         }
 
+        // Shift the face's UVs by whole tiles towards the origin. Textures repeat, so
+        // this changes nothing on screen, but keeps UVs small enough for half floats
+        // (packed vertices) and float precision far from the map origin.
+        glm::vec2 minUV = result[0].texCoord;
+        for (const auto& v : result) {
+            minUV = glm::min(minUV, v.texCoord);
+        }
+        glm::vec2 tileOffset = glm::floor(minUV);
+        for (auto& v : result) {
+            v.texCoord -= tileOffset;
+        }
+
         return result;
     }
 
@@ -201,27 +254,30 @@ namespace VibeReaper {
         });
     }
 
-    glm::vec2 BrushConverter::CalculateUV(const glm::vec3& vertex, const Plane& plane) {
+    glm::vec3 BrushConverter::CalculateUV(const glm::vec3& vertex, const Plane& plane, const MaterialPacker* materials) {
         // Planar projection for texture mapping
-        // Vertices and normals are in Quake Z-up coordinate system
+        // Vertices and normals are in engine Y-up space (World::LoadMap converts planes
+        // before conversion). The axes below are the Quake texture axes rotated into
+        // engine space, so UVs match what TrenchBroom shows for the Z-up source map:
+        //   Quake X -> Engine X, Quake Y -> Engine -Z, Quake Z -> Engine Y
 
         // Determine texture axes based on dominant normal direction
         glm::vec3 uAxis, vAxis;
         glm::vec3 absNormal = glm::abs(plane.normal);
 
         // Choose axes based on which component of normal is largest
-        if (absNormal.z > absNormal.x && absNormal.z > absNormal.y) {
-            // Floor/ceiling (Z-dominant) - map X to U, Y to V
+        if (absNormal.y > absNormal.x && absNormal.y > absNormal.z) {
+            // Floor/ceiling (Quake Z-dominant) - map X to U, Quake -Y to V
             uAxis = glm::vec3(1, 0, 0);
-            vAxis = glm::vec3(0, -1, 0);  // Negate Y for correct orientation
-        } else if (absNormal.y > absNormal.x) {
-            // North/South wall (Y-dominant) - map X to U, Z to V
+            vAxis = glm::vec3(0, 0, 1);   // Quake (0, -1, 0)
+        } else if (absNormal.z > absNormal.x) {
+            // North/South wall (Quake Y-dominant) - map X to U, Quake -Z to V
             uAxis = glm::vec3(1, 0, 0);
-            vAxis = glm::vec3(0, 0, -1);  // Negate Z for correct orientation
+            vAxis = glm::vec3(0, -1, 0);  // Quake (0, 0, -1)
         } else {
-            // East/West wall (X-dominant) - map Y to U, Z to V
-            uAxis = glm::vec3(0, 1, 0);
-            vAxis = glm::vec3(0, 0, -1);  // Negate Z for correct orientation
+            // East/West wall (Quake X-dominant) - map Quake Y to U, Quake -Z to V
+            uAxis = glm::vec3(0, 0, -1);  // Quake (0, 1, 0)
+            vAxis = glm::vec3(0, -1, 0);  // Quake (0, 0, -1)
         }
 
         // Project vertex onto texture axes and apply scale
@@ -247,7 +303,10 @@ namespace VibeReaper {
             v = vRotated;
         }
 
-        return glm::vec2(u, v);
+        // Per-face material layer, so a whole brush (or level) can share one texture array
+        float layer = materials ? static_cast<float>(materials->GetLayer(plane.texture)) : 0.0f;
+
+        return glm::vec3(u, v, layer);
     }
 
     std::vector<unsigned int> BrushConverter::TriangulateFace(unsigned int startIndex, unsigned int vertexCount) {
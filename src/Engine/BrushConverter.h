@@ -2,32 +2,60 @@
 
 #include "MapLoader.h"
 #include "Mesh.h"
+#include "MaterialPacker.h"
 #include <vector>
 
 namespace VibeReaper {
 
+    class JobSystem;
+
+    // CPU-side result of converting one brush; no GL objects, so it can be built on any thread
+    struct BrushGeometry {
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+        AABB bounds;
+        CollisionMesh collision;    // Only when requested
+    };
+
     // Converts CSG brushes to triangle meshes
     class BrushConverter {
     public:
         // Convert a single brush to a mesh
-        static Mesh ConvertBrushToMesh(const Brush& brush);
+        // With a material packer, each face's texture layer is written into its vertices
+        static Mesh ConvertBrushToMesh(const Brush& brush, const MaterialPacker* materials = nullptr);
+
+        // Convert a single brush to plain vertex/index arrays (thread-safe)
+        static BrushGeometry ConvertBrush(const Brush& brush, const MaterialPacker* materials = nullptr,
+                                          bool buildCollision = false);
 
         // Convert multiple brushes to meshes
-        static std::vector<Mesh> ConvertBrushesToMeshes(const std::vector<Brush>& brushes);
+        static std::vector<Mesh> ConvertBrushesToMeshes(const std::vector<Brush>& brushes,
+                                                        const MaterialPacker* materials = nullptr);
+
+        // Convert all brushes in parallel; result[i] belongs to brushes[i] (empty when
+        // the brush produced no faces). The packer is only read, so it must not change meanwhile.
+        static std::vector<BrushGeometry> ConvertBrushes(const std::vector<Brush>& brushes, JobSystem& jobs,
+                                                         const MaterialPacker* materials = nullptr,
+                                                         bool buildCollision = false);
+
+        // Brush geometry queries (also used by visibility precomputation)
+        static std::vector<glm::vec3> CalculateVertices(const std::vector<Plane>& planes);
+        static bool IsPointInsideBrush(const glm::vec3& point, const std::vector<Plane>& planes, float epsilon = 0.01f);
 
     private:
         // Vertex calculation
-        static std::vector<glm::vec3> CalculateVertices(const std::vector<Plane>& planes);
         static glm::vec3 IntersectThreePlanes(const Plane& p1, const Plane& p2, const Plane& p3);
-        static bool IsPointInsideBrush(const glm::vec3& point, const std::vector<Plane>& planes, float epsilon = 0.01f);
 
         // Face building
-        static std::vector<Vertex> BuildFaces(const std::vector<Plane>& planes, const std::vector<glm::vec3>& vertices);
-        static std::vector<Vertex> BuildFace(const Plane& plane, const std::vector<glm::vec3>& vertices);
+        static std::vector<Vertex> BuildFaces(const std::vector<Plane>& planes, const std::vector<glm::vec3>& vertices,
+                                              const MaterialPacker* materials);
+        static std::vector<Vertex> BuildFace(const Plane& plane, const std::vector<glm::vec3>& vertices,
+                                             const MaterialPacker* materials);
 
         // Geometry helpers
         static void SortWindingOrder(std::vector<glm::vec3>& faceVertices, const glm::vec3& normal);
-        static glm::vec2 CalculateUV(const glm::vec3& vertex, const Plane& plane);
+        // Returns (u, v, texture array layer)
+        static glm::vec3 CalculateUV(const glm::vec3& vertex, const Plane& plane, const MaterialPacker* materials);
         static std::vector<unsigned int> TriangulateFace(unsigned int startIndex, unsigned int vertexCount);
     };
 
@@ -67,23 +67,18 @@ namespace VibeReaper {
             float rayDistance = desiredDistance;
 
             // Check collision with world geometry
-            // Cast a ray from player toward camera, check each mesh AABB
+            // Cast a ray from player toward camera, check each collider AABB along it
 
             float minDistance = rayDistance;
             const float cameraRadius = 0.5_u; // Small radius to avoid clipping (0.5m)
 
-            const auto& geometry = world->GetLevelGeometry();
-            for (const auto& renderObj : geometry) {
-                // Calculate AABB from mesh vertices
-                if (renderObj.mesh.vertices.empty()) continue;
-
-                glm::vec3 bmin(FLT_MAX), bmax(-FLT_MAX);
-                for (const auto& vertex : renderObj.mesh.vertices) {
-                    bmin = glm::min(bmin, vertex.position);
-                    bmax = glm::max(bmax, vertex.position);
-                }
-
-                AABB meshAABB{bmin, bmax};
+            // Only colliders whose bounds overlap the ray's come back from the grid;
+            // doors are tested where they currently are
+            const Broadphase& colliders = world->GetColliders();
+            colliderHits.clear();
+            colliders.Query(AABB(glm::min(target, idealPosition), glm::max(target, idealPosition)), colliderHits);
+            for (uint32_t proxy : colliderHits) {
+                const AABB& meshAABB = colliders.GetBounds(proxy);
 
                 // Skip if AABB center is behind the player (not between player and camera)
                 glm::vec3 aabbCenter = (meshAABB.min + meshAABB.max) * 0.5f;
@@ -97,12 +92,8 @@ namespace VibeReaper {
                 // Offset start point slightly towards camera to avoid immediate collision with floor/player
                 glm::vec3 rayStart = target + direction * 0.1f;
 
-                // Transform ray to Quake space (Z-up) for collision detection
-                // Engine (Y-up) -> Quake (Z-up): (x, y, z) -> (x, -z, y)
-                glm::vec3 rayStartQuake(rayStart.x, -rayStart.z, rayStart.y);
-                glm::vec3 directionQuake(direction.x, -direction.z, direction.y);
-                
-                CollisionResult hitResult = Collision::RaycastAABB(rayStartQuake, directionQuake, meshAABB, desiredDistance);
+                // Level geometry is already in engine space, so the ray needs no conversion
+                CollisionResult hitResult = Collision::RaycastAABB(rayStart, direction, meshAABB, desiredDistance);
                 if (hitResult.hit) {
                     float hitDistance = hitResult.penetration; // penetration stores the ray distance (t value)
                     if (hitDistance > 0.0f && hitDistance < minDistance) {
@@ -2,6 +2,8 @@
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <cstdint>
+#include <vector>
 
 namespace VibeReaper {
 
@@ -35,6 +37,8 @@ namespace VibeReaper {
         float GetYaw() const { return yaw; }
         float GetPitch() const { return pitch; }
         float GetDistance() const { return distFromTarget; }
+        float GetNearPlane() const { return nearPlane; }
+        float GetFarPlane() const { return farPlane; }
 
     private:
         // Camera parameters
@@ -48,6 +52,7 @@ namespace VibeReaper {
         float distFromTarget; // Distance from target
         float desiredDistance; // Desired distance (before wall collision)
         float currentDistance; // Current distance (after wall collision)
+        std::vector<uint32_t> colliderHits; // Collider proxies near the collision ray (reused)
 
         // Projection parameters
         float fov;
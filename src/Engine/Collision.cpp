@@ -2,9 +2,37 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <map>
+#include <tuple>
 
 namespace VibeReaper {
 
+    CollisionMesh CollisionMesh::Build(const std::vector<glm::vec3>& positions, const std::vector<unsigned int>& indices) {
+        CollisionMesh mesh;
+        if (positions.empty()) return mesh;
+
+        // Exact-match weld (brush faces share bit-identical corners from CalculateVertices)
+        std::map<std::tuple<float, float, float>, unsigned int> welded;
+        std::vector<unsigned int> remap(positions.size());
+        mesh.bounds = AABB(positions[0], positions[0]);
+        for (size_t i = 0; i < positions.size(); i++) {
+            const glm::vec3& p = positions[i];
+            auto inserted = welded.emplace(std::make_tuple(p.x, p.y, p.z), static_cast<unsigned int>(mesh.positions.size()));
+            if (inserted.second) {
+                mesh.positions.push_back(p);
+                mesh.bounds.Expand(p);
+            }
+            remap[i] = inserted.first->second;
+        }
+
+        mesh.indices.reserve(indices.size());
+        for (unsigned int index : indices) {
+            mesh.indices.push_back(remap[index]);
+        }
+        mesh.positions.shrink_to_fit();
+        return mesh;
+    }
+
     bool Collision::TestAABB(const AABB& a, const AABB& b) {
         return a.Intersects(b);
     }
@@ -46,6 +46,15 @@ namespace VibeReaper {
             max = glm::max(max, point);
         }
 
+        /**
+         * @brief Check if a point lies inside (or on) the AABB
+         */
+        bool Contains(const glm::vec3& point) const {
+            return point.x >= min.x && point.x <= max.x &&
+                   point.y >= min.y && point.y <= max.y &&
+                   point.z >= min.z && point.z <= max.z;
+        }
+
         /**
          * @brief Create AABB from center and half-extents
          */
@@ -54,6 +63,29 @@ namespace VibeReaper {
         }
     };
 
+    /**
+     * @brief Compact triangle soup for collision queries
+     *
+     * Positions only, with duplicates welded (brush faces each carry their own
+     * render vertices, collision doesn't need them), so it stays resident after
+     * a render mesh frees its CPU copy.
+     */
+    struct CollisionMesh {
+        std::vector<glm::vec3> positions;
+        std::vector<unsigned int> indices;  // Triangle list into positions
+        AABB bounds;
+
+        bool IsEmpty() const { return indices.empty(); }
+        size_t GetMemoryUsage() const {
+            return positions.capacity() * sizeof(glm::vec3) + indices.capacity() * sizeof(unsigned int);
+        }
+
+        /**
+         * @brief Build from an indexed triangle list, welding identical positions
+         */
+        static CollisionMesh Build(const std::vector<glm::vec3>& positions, const std::vector<unsigned int>& indices);
+    };
+
     /**
      * @brief Collision resolution result
      */
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace VibeReaper {
+
+    /**
+     * @brief Conversion between Quake MAP space and engine space
+     *
+     * Quake/TrenchBroom maps are Z-up, the engine is Y-up:
+     * - Quake (x, y, z) -> Engine (x, z, -y)
+     * - Engine (x, y, z) -> Quake (x, -z, y)
+     *
+     * This is a pure rotation (-90° about X), so it preserves lengths, dot products
+     * and winding. Plane distances are therefore unchanged by the conversion; only
+     * points and directions need to be rotated.
+     *
+     * World::LoadMap applies this once at load time, so everything downstream
+     * (rendering, collision, entity queries) works in engine space directly.
+     */
+    namespace CoordinateSpace {
+
+        /**
+         * @brief Convert a point or direction from Quake (Z-up) to engine (Y-up) space
+         */
+        inline glm::vec3 QuakeToEngine(const glm::vec3& v) {
+            return glm::vec3(v.x, v.z, -v.y);
+        }
+
+        /**
+         * @brief Convert a point or direction from engine (Y-up) to Quake (Z-up) space
+         */
+        inline glm::vec3 EngineToQuake(const glm::vec3& v) {
+            return glm::vec3(v.x, -v.z, v.y);
+        }
+
+    } // namespace CoordinateSpace
+
+} // namespace VibeReaper
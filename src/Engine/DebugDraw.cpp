@@ -0,0 +1,123 @@
+#include "DebugDraw.h"
+#include "../Utils/Logger.h"
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <chrono>
+
+namespace VibeReaper {
+
+    DebugDraw::DebugDraw()
+        : vao(0), viewProjectionLocation(-1), maxVertices(0), initialized(false) {
+    }
+
+    bool DebugDraw::Initialize(size_t maxVerticesPerFrame) {
+        if (initialized) return true;
+
+        if (!shader.LoadFromFiles("assets/shaders/debug_line.vert", "assets/shaders/debug_line.frag")) {
+            LOG_ERROR("DebugDraw: failed to load debug line shaders");
+            return false;
+        }
+        viewProjectionLocation = glGetUniformLocation(shader.GetProgramID(), "uViewProjection");
+
+        // Segments are a multiple of the vertex size, so every write offset is a
+        // whole vertex index and the VAO never needs re-pointing
+        maxVertices = maxVerticesPerFrame;
+        if (!stream.Create(maxVertices * sizeof(DebugVertex), sizeof(DebugVertex))) {
+            LOG_ERROR("DebugDraw: failed to create stream buffer");
+            return false;
+        }
+
+        glGenVertexArrays(1, &vao);
+        glBindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, stream.GetBuffer());
+
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(DebugVertex), (void*)offsetof(DebugVertex, position));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(DebugVertex), (void*)offsetof(DebugVertex, color));
+
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        initialized = true;
+        return true;
+    }
+
+    bool DebugDraw::ReloadShader(const std::string& path) {
+        if (!initialized || !shader.UsesFile(path)) return false;
+        if (!shader.Reload()) return false;
+        viewProjectionLocation = glGetUniformLocation(shader.GetProgramID(), "uViewProjection");
+        return true;
+    }
+
+    uint32_t DebugDraw::PackColor(const glm::vec3& color) {
+        auto channel = [](float value) -> uint32_t {
+            return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+        };
+        // Little-endian: R is the first byte in memory
+        return channel(color.x) | (channel(color.y) << 8) | (channel(color.z) << 16) | (255u << 24);
+    }
+
+    void DebugDraw::Line(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color) {
+        uint32_t packed = PackColor(color);
+        vertices.push_back({ from, packed });
+        vertices.push_back({ to, packed });
+    }
+
+    void DebugDraw::Box(const AABB& box, const glm::vec3& color) {
+        uint32_t packed = PackColor(color);
+        const glm::vec3& a = box.min;
+        const glm::vec3& b = box.max;
+        const glm::vec3 corners[8] = {
+            { a.x, a.y, a.z }, { b.x, a.y, a.z }, { b.x, a.y, b.z }, { a.x, a.y, b.z },
+            { a.x, b.y, a.z }, { b.x, b.y, a.z }, { b.x, b.y, b.z }, { a.x, b.y, b.z }
+        };
+        // Bottom ring, top ring, verticals
+        const int edges[12][2] = {
+            { 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 0 },
+            { 4, 5 }, { 5, 6 }, { 6, 7 }, { 7, 4 },
+            { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }
+        };
+        for (const auto& edge : edges) {
+            vertices.push_back({ corners[edge[0]], packed });
+            vertices.push_back({ corners[edge[1]], packed });
+        }
+    }
+
+    void DebugDraw::Cross(const glm::vec3& center, float size, const glm::vec3& color) {
+        float half = size * 0.5f;
+        Line(center - glm::vec3(half, 0, 0), center + glm::vec3(half, 0, 0), color);
+        Line(center - glm::vec3(0, half, 0), center + glm::vec3(0, half, 0), color);
+        Line(center - glm::vec3(0, 0, half), center + glm::vec3(0, 0, half), color);
+    }
+
+    void DebugDraw::Flush(const glm::mat4& viewProjection) {
+        stats = DebugDrawStats();
+        if (!initialized || vertices.empty()) {
+            vertices.clear();
+            return;
+        }
+
+        // Whole lines only; anything beyond the frame budget is dropped
+        size_t count = std::min(vertices.size(), maxVertices) & ~static_cast<size_t>(1);
+        stats.dropped = vertices.size() - count;
+
+        auto uploadStart = std::chrono::steady_clock::now();
+        stream.BeginFrame();
+        size_t offset = stream.Write(vertices.data(), count * sizeof(DebugVertex));
+        stats.uploadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - uploadStart).count();
+
+        if (offset != StreamBuffer::NO_SPACE) {
+            shader.Use();
+            glUniformMatrix4fv(viewProjectionLocation, 1, GL_FALSE, glm::value_ptr(viewProjection));
+            glBindVertexArray(vao);
+            glDrawArrays(GL_LINES, static_cast<GLint>(offset / sizeof(DebugVertex)), static_cast<GLsizei>(count));
+            glBindVertexArray(0);
+            stats.vertices = count;
+        }
+        stream.EndFrame();
+
+        vertices.clear();
+    }
+
+} // namespace VibeReaper
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Shader.h"
+#include "StreamBuffer.h"
+#include "Collision.h"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+
+namespace VibeReaper {
+
+    // Streamed line vertex: world-space position + RGBA8 color (16 bytes)
+    struct DebugVertex {
+        glm::vec3 position;
+        uint32_t color;
+    };
+
+    struct DebugDrawStats {
+        size_t vertices = 0;        // Drawn last frame
+        size_t dropped = 0;         // Over the per-frame budget last frame
+        double uploadMs = 0.0;
+    };
+
+    /**
+     * @brief Immediate-mode debug lines, streamed through a StreamBuffer
+     *
+     * Line()/Box()/Cross() only append to a CPU list and may be called any time
+     * during the frame; Flush() uploads the list in one write and draws it with
+     * a single GL_LINES call, then clears it for the next frame.
+     */
+    class DebugDraw {
+    public:
+        DebugDraw();
+
+        // Loads debug_line shaders and allocates the ring (maxVertices per frame)
+        bool Initialize(size_t maxVerticesPerFrame = 512 * 1024);
+        bool IsInitialized() const { return initialized; }
+
+        // Relink the line shader if path is one of its sources (hot reload)
+        bool ReloadShader(const std::string& path);
+
+        void Line(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color);
+        void Box(const AABB& box, const glm::vec3& color);
+        void Cross(const glm::vec3& center, float size, const glm::vec3& color);
+
+        // Draw everything added this frame (depth tested) and clear the list.
+        // Changes GL program/VAO state behind RenderQueue's back.
+        void Flush(const glm::mat4& viewProjection);
+        void Clear() { vertices.clear(); }
+
+        const std::vector<DebugVertex>& GetVertices() const { return vertices; }
+        const DebugDrawStats& GetStats() const { return stats; }
+        const StreamBufferStats& GetStreamStats() const { return stream.GetStats(); }
+
+        // RGB in [0, 1] to RGBA8 (alpha 255), byte order matching GL_UNSIGNED_BYTE x4
+        static uint32_t PackColor(const glm::vec3& color);
+
+    private:
+        Shader shader;
+        StreamBuffer stream;
+        GLuint vao;
+        GLint viewProjectionLocation;
+        size_t maxVertices;
+        bool initialized;
+        std::vector<DebugVertex> vertices;
+        DebugDrawStats stats;
+    };
+
+} // namespace VibeReaper
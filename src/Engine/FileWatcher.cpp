@@ -0,0 +1,184 @@
+#include "FileWatcher.h"
+#include "../Utils/Logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace VibeReaper {
+
+    namespace {
+        const double DEFAULT_POLL_INTERVAL = 0.5;   // Seconds between rescans when polling
+
+        void AddChanged(std::vector<std::string>& changed, size_t first, const std::string& path) {
+            if (std::find(changed.begin() + first, changed.end(), path) == changed.end()) {
+                changed.push_back(path);
+            }
+        }
+    }
+
+    FileWatcher::FileWatcher(bool useNative)
+        : lastScan(std::chrono::steady_clock::now()), pollInterval(DEFAULT_POLL_INTERVAL), inotifyFd(-1) {
+#ifdef __linux__
+        if (useNative) {
+            inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (inotifyFd < 0) {
+                LOG_WARNING("inotify unavailable ({}), polling for asset changes", std::strerror(errno));
+            }
+        }
+#else
+        (void)useNative;
+#endif
+    }
+
+    FileWatcher::~FileWatcher() {
+#ifdef __linux__
+        if (inotifyFd >= 0) {
+            close(inotifyFd);
+        }
+#endif
+    }
+
+    bool FileWatcher::WatchDirectory(const std::string& directory) {
+        std::string root = directory;
+        while (root.size() > 1 && (root.back() == '/' || root.back() == '\\')) {
+            root.pop_back();
+        }
+
+        std::error_code error;
+        if (!std::filesystem::is_directory(root, error)) {
+            LOG_WARNING("Cannot watch " + root + ": not a directory");
+            return false;
+        }
+
+        directories.push_back(root);
+        if (inotifyFd >= 0) {
+            AddWatches(root);
+        } else {
+            // Baseline, so files that already exist are not reported on the first Poll()
+            Scan(root, nullptr, nullptr);
+        }
+        return true;
+    }
+
+    void FileWatcher::Poll(std::vector<std::string>& changed) {
+        if (inotifyFd >= 0) {
+            ReadEvents(changed);
+            return;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (std::chrono::duration<double>(now - lastScan).count() < pollInterval) return;
+        lastScan = now;
+
+        // Rebuilt from scratch so deleted files drop out
+        std::map<std::string, FileState> previous;
+        previous.swap(files);
+        size_t first = changed.size();
+        std::vector<std::string> found;
+        for (const std::string& directory : directories) {
+            Scan(directory, &previous, &found);
+        }
+        for (const std::string& path : found) {
+            AddChanged(changed, first, path);
+        }
+    }
+
+    void FileWatcher::Scan(const std::string& directory, const std::map<std::string, FileState>* previous,
+                           std::vector<std::string>* changed) {
+        // Error codes throughout: files may vanish or be half-written mid-scan
+        std::error_code error;
+        std::filesystem::recursive_directory_iterator it(directory, error);
+        for (; !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+            if (!it->is_regular_file(error)) continue;
+
+            FileState state;
+            state.time = it->last_write_time(error);
+            if (error) continue;
+            state.size = it->file_size(error);
+            if (error) continue;
+
+            // New or changed files wait for the next rescan; unchanged by then, they are reported
+            std::string path = it->path().generic_string();
+            if (changed) {
+                auto seen = previous->find(path);
+                if (seen == previous->end() || seen->second.time != state.time || seen->second.size != state.size) {
+                    state.pending = true;
+                } else if (seen->second.pending) {
+                    changed->push_back(path);
+                }
+            }
+            files[path] = state;
+        }
+    }
+
+    void FileWatcher::AddWatches(const std::string& directory) {
+#ifdef __linux__
+        // Close-after-write and renames cover both direct and temp-file saves;
+        // IN_CREATE only matters for new subdirectories
+        int watch = inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (watch < 0) {
+            LOG_WARNING("Cannot watch {}: {}", directory, std::strerror(errno));
+            return;
+        }
+        watches[watch] = directory;
+
+        std::error_code error;
+        std::filesystem::directory_iterator it(directory, error);
+        for (; !error && it != std::filesystem::directory_iterator(); it.increment(error)) {
+            if (it->is_directory(error) && !it->is_symlink(error)) {
+                AddWatches(directory + "/" + it->path().filename().generic_string());
+            }
+        }
+#else
+        (void)directory;
+#endif
+    }
+
+    void FileWatcher::ReadEvents(std::vector<std::string>& changed) {
+#ifdef __linux__
+        size_t first = changed.size();
+        alignas(inotify_event) char buffer[4096];
+        for (;;) {
+            // Non-blocking: EAGAIN once the queue is drained
+            ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+            if (length <= 0) break;
+
+            for (char* cursor = buffer; cursor < buffer + length;) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(cursor);
+                cursor += sizeof(inotify_event) + event->len;
+
+                if (event->mask & IN_Q_OVERFLOW) {
+                    LOG_WARNING("inotify queue overflowed, some asset changes were missed");
+                    continue;
+                }
+                if (event->mask & IN_IGNORED) {
+                    // Directory deleted or unmounted
+                    watches.erase(event->wd);
+                    continue;
+                }
+
+                auto watch = watches.find(event->wd);
+                if (watch == watches.end() || event->len == 0) continue;
+
+                std::string path = watch->second + "/" + event->name;
+                if (event->mask & IN_ISDIR) {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                        AddWatches(path);
+                    }
+                } else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                    AddChanged(changed, first, path);
+                }
+            }
+        }
+#else
+        (void)changed;
+#endif
+    }
+
+} // namespace VibeReaper
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace VibeReaper {
+
+    /**
+     * @brief Reports files written under watched directories (asset hot reload)
+     *
+     * On Linux, inotify reports close-after-write and renames into a watched
+     * directory (editors that save through a temporary file), so Poll() is one
+     * non-blocking read. Elsewhere, or if inotify is unavailable, Poll() rescans
+     * modification times and sizes at most once per poll interval. A changed file
+     * is only reported once a later rescan finds the same time and size, so a file
+     * still being written is not read half-saved.
+     *
+     * Subdirectories are watched as well. Paths are reported as the watched
+     * directory joined with the file's relative path using '/', the same form
+     * the engine builds asset paths in, each at most once per Poll().
+     */
+    class FileWatcher {
+    public:
+        // useNative false forces the polling fallback
+        explicit FileWatcher(bool useNative = true);
+        ~FileWatcher();
+
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+        // Watch a directory and everything below it; false if it does not exist
+        bool WatchDirectory(const std::string& directory);
+
+        // Append files created or rewritten since the last call (never blocks)
+        void Poll(std::vector<std::string>& changed);
+
+        // Rescan period of the polling fallback
+        void SetPollInterval(double seconds) { pollInterval = seconds; }
+
+        // inotify is in use (otherwise modification times are polled)
+        bool IsNative() const { return inotifyFd >= 0; }
+
+    private:
+        struct FileState {
+            std::filesystem::file_time_type time;
+            uintmax_t size = 0;
+            bool pending = false;       // Changed, waiting for one unchanged rescan
+        };
+
+        // Polling: every watched directory's files as last seen
+        std::vector<std::string> directories;
+        std::map<std::string, FileState> files;
+        std::chrono::steady_clock::time_point lastScan;
+        double pollInterval;
+
+        // inotify descriptor (-1 when polling) and watch descriptor -> directory
+        int inotifyFd;
+        std::map<int, std::string> watches;
+
+        void Scan(const std::string& directory, const std::map<std::string, FileState>* previous,
+                  std::vector<std::string>* changed);
+        void AddWatches(const std::string& directory);
+        void ReadEvents(std::vector<std::string>& changed);
+    };
+
+} // namespace VibeReaper
@@ -0,0 +1,170 @@
+#include "Frustum.h"
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define VIBEREAPER_CULL_SSE 1
+#include <xmmintrin.h>
+#endif
+
+namespace VibeReaper {
+
+    // ========================================================================
+    // Frustum
+    // ========================================================================
+
+    Frustum::Frustum() {
+        for (auto& plane : planes) {
+            plane = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f); // Accepts everything until extracted
+        }
+    }
+
+    void Frustum::Extract(const glm::mat4& m) {
+        // glm is column-major: row i is (m[0][i], m[1][i], m[2][i], m[3][i])
+        glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+        glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+        glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+        glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+        // OpenGL clip space: -w <= x, y, z <= w
+        planes[PLANE_LEFT] = row3 + row0;
+        planes[PLANE_RIGHT] = row3 - row0;
+        planes[PLANE_BOTTOM] = row3 + row1;
+        planes[PLANE_TOP] = row3 - row1;
+        planes[PLANE_NEAR] = row3 + row2;
+        planes[PLANE_FAR] = row3 - row2;
+
+        for (auto& plane : planes) {
+            float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+            if (length > 0.0f) {
+                plane /= length;
+            }
+        }
+    }
+
+    Frustum Frustum::FromMatrices(const glm::mat4& view, const glm::mat4& projection) {
+        Frustum frustum;
+        frustum.Extract(projection * view);
+        return frustum;
+    }
+
+    bool Frustum::IsBoxVisible(const AABB& box) const {
+        glm::vec3 center = box.GetCenter();
+        glm::vec3 extents = box.GetSize() * 0.5f;
+
+        for (const auto& plane : planes) {
+            // Signed distance of the center vs. projected radius of the box onto the normal
+            float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+            float radius = std::abs(plane.x) * extents.x + std::abs(plane.y) * extents.y + std::abs(plane.z) * extents.z;
+            if (distance < -radius) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // ========================================================================
+    // CullingBounds
+    // ========================================================================
+
+    void CullingBounds::Clear() {
+        centerX.clear(); centerY.clear(); centerZ.clear();
+        extentX.clear(); extentY.clear(); extentZ.clear();
+        count = 0;
+    }
+
+    void CullingBounds::Reserve(size_t reserveCount) {
+        size_t padded = (reserveCount + 3) & ~static_cast<size_t>(3);
+        centerX.reserve(padded); centerY.reserve(padded); centerZ.reserve(padded);
+        extentX.reserve(padded); extentY.reserve(padded); extentZ.reserve(padded);
+    }
+
+    uint32_t CullingBounds::Add(const AABB& box) {
+        uint32_t index = static_cast<uint32_t>(count++);
+
+        // Keep arrays padded to a multiple of 4 (padding boxes are never reported)
+        size_t padded = (count + 3) & ~static_cast<size_t>(3);
+        if (centerX.size() < padded) {
+            centerX.resize(padded, 0.0f); centerY.resize(padded, 0.0f); centerZ.resize(padded, 0.0f);
+            extentX.resize(padded, 0.0f); extentY.resize(padded, 0.0f); extentZ.resize(padded, 0.0f);
+        }
+
+        glm::vec3 center = box.GetCenter();
+        glm::vec3 extents = box.GetSize() * 0.5f;
+        centerX[index] = center.x; centerY[index] = center.y; centerZ[index] = center.z;
+        extentX[index] = extents.x; extentY[index] = extents.y; extentZ[index] = extents.z;
+        return index;
+    }
+
+    void CullingBounds::Cull(const Frustum& frustum, std::vector<uint32_t>& visible) const {
+#ifdef VIBEREAPER_CULL_SSE
+        visible.clear();
+
+        // Broadcast plane terms once; |n| is needed for the box radius
+        __m128 planeX[Frustum::PLANE_COUNT], planeY[Frustum::PLANE_COUNT], planeZ[Frustum::PLANE_COUNT];
+        __m128 planeW[Frustum::PLANE_COUNT];
+        __m128 absX[Frustum::PLANE_COUNT], absY[Frustum::PLANE_COUNT], absZ[Frustum::PLANE_COUNT];
+        for (int p = 0; p < Frustum::PLANE_COUNT; p++) {
+            const glm::vec4& plane = frustum.GetPlane(p);
+            planeX[p] = _mm_set1_ps(plane.x);
+            planeY[p] = _mm_set1_ps(plane.y);
+            planeZ[p] = _mm_set1_ps(plane.z);
+            planeW[p] = _mm_set1_ps(plane.w);
+            absX[p] = _mm_set1_ps(std::abs(plane.x));
+            absY[p] = _mm_set1_ps(std::abs(plane.y));
+            absZ[p] = _mm_set1_ps(std::abs(plane.z));
+        }
+
+        for (size_t base = 0; base < count; base += 4) {
+            __m128 cx = _mm_loadu_ps(&centerX[base]);
+            __m128 cy = _mm_loadu_ps(&centerY[base]);
+            __m128 cz = _mm_loadu_ps(&centerZ[base]);
+            __m128 ex = _mm_loadu_ps(&extentX[base]);
+            __m128 ey = _mm_loadu_ps(&extentY[base]);
+            __m128 ez = _mm_loadu_ps(&extentZ[base]);
+
+            __m128 outside = _mm_setzero_ps();
+            for (int p = 0; p < Frustum::PLANE_COUNT; p++) {
+                __m128 distance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(planeX[p], cx), _mm_mul_ps(planeY[p], cy)),
+                    _mm_add_ps(_mm_mul_ps(planeZ[p], cz), planeW[p]));
+                __m128 radius = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(absX[p], ex), _mm_mul_ps(absY[p], ey)),
+                    _mm_mul_ps(absZ[p], ez));
+
+                // distance < -radius  <=>  distance + radius < 0
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+            }
+
+            int outsideMask = _mm_movemask_ps(outside);
+            for (int lane = 0; lane < 4; lane++) {
+                size_t index = base + lane;
+                if (index < count && !(outsideMask & (1 << lane))) {
+                    visible.push_back(static_cast<uint32_t>(index));
+                }
+            }
+        }
+#else
+        CullScalar(frustum, visible);
+#endif
+    }
+
+    void CullingBounds::CullScalar(const Frustum& frustum, std::vector<uint32_t>& visible) const {
+        visible.clear();
+
+        for (size_t i = 0; i < count; i++) {
+            bool inside = true;
+            for (int p = 0; p < Frustum::PLANE_COUNT && inside; p++) {
+                const glm::vec4& plane = frustum.GetPlane(p);
+                // Same operation order as the SSE path so both give identical results
+                float distance = (plane.x * centerX[i] + plane.y * centerY[i]) + (plane.z * centerZ[i] + plane.w);
+                float radius = (std::abs(plane.x) * extentX[i] + std::abs(plane.y) * extentY[i]) +
+                               std::abs(plane.z) * extentZ[i];
+                inside = distance + radius >= 0.0f;
+            }
+            if (inside) {
+                visible.push_back(static_cast<uint32_t>(i));
+            }
+        }
+    }
+
+} // namespace VibeReaper
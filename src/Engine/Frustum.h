@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Collision.h"
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+
+namespace VibeReaper {
+
+    /**
+     * @brief View frustum as six inward-facing planes
+     *
+     * Planes are extracted from a combined projection * view matrix
+     * (Gribb/Hartmann), stored as (normal.xyz, distance) with unit normals,
+     * so a point p is inside a plane when dot(normal, p) + distance >= 0.
+     */
+    class Frustum {
+    public:
+        enum PlaneIndex { PLANE_LEFT = 0, PLANE_RIGHT, PLANE_BOTTOM, PLANE_TOP, PLANE_NEAR, PLANE_FAR, PLANE_COUNT };
+
+        Frustum();
+
+        // Extract planes from projection * view
+        void Extract(const glm::mat4& viewProjection);
+        static Frustum FromMatrices(const glm::mat4& view, const glm::mat4& projection);
+
+        // Conservative AABB test (may accept boxes near frustum corners)
+        bool IsBoxVisible(const AABB& box) const;
+
+        const glm::vec4& GetPlane(int index) const { return planes[index]; }
+
+    private:
+        glm::vec4 planes[PLANE_COUNT];
+    };
+
+    // Per-frame culling counters
+    struct CullingStats {
+        int tested = 0;
+        int visible = 0;
+        int culled = 0;         // Frustum + PVS + occlusion
+        int pvsCulled = 0;      // Inside the frustum but not in the camera leaf's PVS
+        int occlusionCulled = 0;    // Passed frustum/PVS but in a cluster hidden by occlusion queries
+        double cullMs = 0.0;
+    };
+
+    /**
+     * @brief Bounding boxes in structure-of-arrays layout for batch frustum tests
+     *
+     * Boxes are stored as center/half-extent arrays padded to a multiple of 4,
+     * so Cull() can test four boxes per plane with SSE (scalar fallback on other
+     * targets). Indices returned by Cull() are the order boxes were added in.
+     */
+    class CullingBounds {
+    public:
+        void Clear();
+        void Reserve(size_t count);
+
+        // Append a box; returns its index
+        uint32_t Add(const AABB& box);
+
+        // Write indices of boxes intersecting the frustum into visible (cleared first)
+        void Cull(const Frustum& frustum, std::vector<uint32_t>& visible) const;
+
+        // Reference implementation (one box at a time), used to validate Cull()
+        void CullScalar(const Frustum& frustum, std::vector<uint32_t>& visible) const;
+
+        size_t GetCount() const { return count; }
+
+    private:
+        std::vector<float> centerX, centerY, centerZ;
+        std::vector<float> extentX, extentY, extentZ;
+        size_t count = 0;
+    };
+
+} // namespace VibeReaper
@@ -1,31 +1,36 @@
 #include "Input.h"
 #include "../Utils/Logger.h"
-#include <cstring>
 #include <algorithm>
+#include <cmath>
 
 namespace VibeReaper {
 
     Input::Input()
-        : currentKeyState(nullptr),
-          previousKeyState(nullptr),
-          keyStateLength(0),
+        : frame(1),
           mouseDelta(0.0f, 0.0f),
-          currentMouseState(0),
-          previousMouseState(0),
           mouseCaptured(false),
           invertHorizontal(true),   // Invert horizontal by default (standard for most games)
           invertVertical(false),    // Don't invert vertical by default (non-inverted is more common for TPS)
-          gamepad(nullptr) {
-
-        // Initialize keyboard state
-        currentKeyState = SDL_GetKeyboardState(&keyStateLength);
-        previousKeyState = new Uint8[keyStateLength];
-        std::memset(previousKeyState, 0, keyStateLength);
+          gamepad(nullptr),
+          gamepadConnected(false),
+          eventRead(0),
+          eventWrite(0),
+          droppedEvents(0),
+          frameEventStart(0),
+          frameHasInput(false),
+          frameFirstInput(0) {
+
+        // Press frames start at 0, so nothing reads as just pressed in frame 1
+        keyDown.fill(0);
+        keyPressFrame.fill(0);
+        mouseDown.fill(0);
+        mousePressFrame.fill(0);
+        ClearGamepadState();
 
         // Try to open first gamepad
         for (int i = 0; i < SDL_NumJoysticks(); ++i) {
             if (SDL_IsGameController(i)) {
-                OpenGamepad(i);
+                OpenGamepad(i, SDL_GetPerformanceCounter());
                 break;
             }
         }
@@ -34,75 +39,226 @@ namespace VibeReaper {
     }
 
     Input::~Input() {
-        delete[] previousKeyState;
-        CloseGamepad();
+        if (gamepad) {
+            SDL_GameControllerClose(gamepad);
+        }
     }
 
     void Input::ProcessEvent(const SDL_Event& event) {
+        ProcessEvent(event, SDL_GetPerformanceCounter());
+    }
+
+    void Input::ProcessEvent(const SDL_Event& event, Uint64 timestamp) {
+        InputEvent record;
+        record.timestamp = timestamp;
+
         switch (event.type) {
-            case SDL_CONTROLLERDEVICEADDED:
-                if (!gamepad) {
-                    OpenGamepad(event.cdevice.which);
-                }
+            case SDL_KEYDOWN:
+            case SDL_KEYUP:
+                record.type = event.type == SDL_KEYDOWN ? InputEventType::KeyDown : InputEventType::KeyUp;
+                record.repeat = event.key.repeat ? 1 : 0;
+                record.code = static_cast<uint16_t>(event.key.keysym.scancode);
                 break;
 
+            case SDL_MOUSEBUTTONDOWN:
+            case SDL_MOUSEBUTTONUP:
+                record.type = event.type == SDL_MOUSEBUTTONDOWN ? InputEventType::MouseButtonDown : InputEventType::MouseButtonUp;
+                record.code = event.button.button;
+                break;
+
+            case SDL_MOUSEMOTION:
+                // Relative motion only matters while the camera owns the mouse
+                if (!mouseCaptured) return;
+                record.type = InputEventType::MouseMotion;
+                record.x = static_cast<int16_t>(std::clamp(event.motion.xrel, -32768, 32767));
+                record.y = static_cast<int16_t>(std::clamp(event.motion.yrel, -32768, 32767));
+                break;
+
+            case SDL_CONTROLLERDEVICEADDED:
+                if (gamepad) return;
+                OpenGamepad(event.cdevice.which, timestamp);
+                return;
+
             case SDL_CONTROLLERDEVICEREMOVED:
                 if (gamepad && event.cdevice.which == SDL_JoystickInstanceID(
                     SDL_GameControllerGetJoystick(gamepad))) {
-                    CloseGamepad();
+                    CloseGamepad(timestamp);
                 }
-                break;
+                return;
 
+            // SDL only sends button/axis events for opened controllers
             case SDL_CONTROLLERBUTTONDOWN:
-                if (gamepad) {
-                    currentButtonState[static_cast<SDL_GameControllerButton>(event.cbutton.button)] = true;
+            case SDL_CONTROLLERBUTTONUP:
+                record.type = event.type == SDL_CONTROLLERBUTTONDOWN ? InputEventType::GamepadButtonDown : InputEventType::GamepadButtonUp;
+                record.code = event.cbutton.button;
+                break;
+
+            case SDL_CONTROLLERAXISMOTION:
+                record.type = InputEventType::GamepadAxis;
+                record.code = event.caxis.axis;
+                record.x = event.caxis.value;
+                break;
+
+            default:
+                return;
+        }
+
+        InjectEvent(record);
+    }
+
+    void Input::InjectEvent(const InputEvent& event) {
+        switch (event.type) {
+            case InputEventType::KeyDown:
+            case InputEventType::KeyUp: {
+                if (event.code >= SDL_NUM_SCANCODES) return;
+                bool down = event.type == InputEventType::KeyDown;
+                if (down && !event.repeat) {
+                    keyPressFrame[event.code] = frame;
+                }
+                keyDown[event.code] = down ? 1 : 0;
+                break;
+            }
+
+            case InputEventType::MouseButtonDown:
+            case InputEventType::MouseButtonUp: {
+                if (event.code >= MOUSE_BUTTON_COUNT) return;
+                bool down = event.type == InputEventType::MouseButtonDown;
+                if (down && !event.repeat) {
+                    mousePressFrame[event.code] = frame;
                 }
+                mouseDown[event.code] = down ? 1 : 0;
                 break;
+            }
 
-            case SDL_CONTROLLERBUTTONUP:
-                if (gamepad) {
-                    currentButtonState[static_cast<SDL_GameControllerButton>(event.cbutton.button)] = false;
+            case InputEventType::MouseMotion:
+                mouseDelta += glm::vec2(static_cast<float>(event.x), static_cast<float>(event.y));
+                break;
+
+            case InputEventType::GamepadButtonDown:
+            case InputEventType::GamepadButtonUp: {
+                if (event.code >= SDL_CONTROLLER_BUTTON_MAX) return;
+                bool down = event.type == InputEventType::GamepadButtonDown;
+                if (down && !event.repeat) {
+                    buttonPressFrame[event.code] = frame;
                 }
+                buttonDown[event.code] = down ? 1 : 0;
                 break;
+            }
 
-            default:
+            case InputEventType::GamepadAxis:
+                if (event.code >= SDL_CONTROLLER_AXIS_MAX) return;
+                axisValue[event.code] = event.x;
                 break;
+
+            case InputEventType::GamepadConnected:
+            case InputEventType::GamepadDisconnected:
+                ClearGamepadState();
+                gamepadConnected = event.type == InputEventType::GamepadConnected;
+                break;
+        }
+
+        PushEvent(event);
+
+        if (event.type != InputEventType::GamepadConnected &&
+            event.type != InputEventType::GamepadDisconnected &&
+            (!frameHasInput || event.timestamp < frameFirstInput)) {
+            frameHasInput = true;
+            frameFirstInput = event.timestamp;
+        }
+    }
+
+    void Input::GetFrameEvents(std::vector<InputEvent>& out) const {
+        uint64_t first = std::max(frameEventStart, eventWrite > EVENT_CAPACITY ? eventWrite - EVENT_CAPACITY : 0);
+        for (uint64_t i = first; i < eventWrite; ++i) {
+            out.push_back(events[i & (EVENT_CAPACITY - 1)]);
+        }
+    }
+
+    void Input::GetStateEvents(std::vector<InputEvent>& out, Uint64 timestamp) const {
+        InputEvent event;
+        event.timestamp = timestamp;
+
+        if (gamepadConnected) {
+            event.type = InputEventType::GamepadConnected;
+            out.push_back(event);
+            event.type = InputEventType::GamepadAxis;
+            for (int axis = 0; axis < SDL_CONTROLLER_AXIS_MAX; ++axis) {
+                event.code = static_cast<uint16_t>(axis);
+                event.x = axisValue[axis];
+                out.push_back(event);
+            }
+            // Held, not freshly pressed
+            event.x = 0;
+            event.repeat = 1;
+            event.type = InputEventType::GamepadButtonDown;
+            for (int button = 0; button < SDL_CONTROLLER_BUTTON_MAX; ++button) {
+                event.code = static_cast<uint16_t>(button);
+                if (buttonDown[button]) out.push_back(event);
+            }
+        }
+
+        event.repeat = 1;
+        event.type = InputEventType::KeyDown;
+        for (int key = 0; key < SDL_NUM_SCANCODES; ++key) {
+            event.code = static_cast<uint16_t>(key);
+            if (keyDown[key]) out.push_back(event);
+        }
+
+        event.type = InputEventType::MouseButtonDown;
+        for (int button = 0; button < MOUSE_BUTTON_COUNT; ++button) {
+            event.code = static_cast<uint16_t>(button);
+            if (mouseDown[button]) out.push_back(event);
         }
     }
 
     void Input::Prepare() {
-        // Update keyboard state - MUST be done before SDL_PollEvent
-        // SDL_PollEvent updates the internal array returned by SDL_GetKeyboardState
-        // so we must copy it to previous BEFORE processing events
-        std::memcpy(previousKeyState, currentKeyState, keyStateLength);
-    }
-
-    void Input::Update() {
-        // Keyboard state is already prepared in Prepare()
-        // Just ensure current pointer is valid (it points to internal SDL memory)
-        currentKeyState = SDL_GetKeyboardState(nullptr);
-
-        // Update mouse state
-        previousMouseState = currentMouseState;
-        int mouseX, mouseY;
-        if (mouseCaptured) {
-            currentMouseState = SDL_GetRelativeMouseState(&mouseX, &mouseY);
-            mouseDelta = glm::vec2(static_cast<float>(mouseX), static_cast<float>(mouseY));
-        } else {
-            currentMouseState = SDL_GetMouseState(&mouseX, &mouseY);
-            mouseDelta = glm::vec2(0.0f, 0.0f);
+        // Key state carries over; only per-frame values reset. Press frames make
+        // a press+release between two Prepare() calls still read as just pressed.
+        frame++;
+        frameEventStart = eventWrite;
+        mouseDelta = glm::vec2(0.0f, 0.0f);
+    }
+
+    void Input::PushEvent(const InputEvent& event) {
+        // Full: overwrite the oldest unconsumed event
+        if (eventWrite - eventRead == EVENT_CAPACITY) {
+            eventRead++;
+            droppedEvents++;
         }
+        events[eventWrite & (EVENT_CAPACITY - 1)] = event;
+        eventWrite++;
+    }
+
+    bool Input::PollEvent(InputEvent& event, Uint64 until) {
+        if (eventRead == eventWrite) return false;
+
+        const InputEvent& next = events[eventRead & (EVENT_CAPACITY - 1)];
+        if (next.timestamp > until) return false;
+
+        event = next;
+        eventRead++;
+        return true;
+    }
+
+    void Input::MarkPresented(Uint64 presentTime) {
+        if (!frameHasInput) return;
+        frameHasInput = false;
+
+        Uint64 ticks = presentTime > frameFirstInput ? presentTime - frameFirstInput : 0;
+        double ms = static_cast<double>(ticks) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
 
-        // Update gamepad button state
-        previousButtonState = currentButtonState;
+        latencyStats.frames++;
+        latencyStats.averageMs += (ms - latencyStats.averageMs) / static_cast<double>(latencyStats.frames);
+        latencyStats.maxMs = std::max(latencyStats.maxMs, ms);
+        latencyStats.lastMs = ms;
     }
 
     bool Input::IsKeyPressed(SDL_Scancode key) const {
-        return currentKeyState[key] != 0;
+        return keyDown[key] != 0;
     }
 
     bool Input::IsKeyJustPressed(SDL_Scancode key) const {
-        return currentKeyState[key] != 0 && previousKeyState[key] == 0;
+        return keyPressFrame[key] == frame;
     }
 
     glm::vec2 Input::GetMouseDelta() const {
@@ -110,43 +266,34 @@ namespace VibeReaper {
     }
 
     bool Input::IsMouseButtonPressed(int button) const {
-        return (currentMouseState & SDL_BUTTON(button)) != 0;
+        if (button < 0 || button >= MOUSE_BUTTON_COUNT) return false;
+        return mouseDown[button] != 0;
     }
 
     bool Input::IsMouseButtonJustPressed(int button) const {
-        return (currentMouseState & SDL_BUTTON(button)) != 0 &&
-               (previousMouseState & SDL_BUTTON(button)) == 0;
+        if (button < 0 || button >= MOUSE_BUTTON_COUNT) return false;
+        return mousePressFrame[button] == frame;
     }
 
     bool Input::IsGamepadConnected() const {
-        return gamepad != nullptr;
+        return gamepadConnected;
     }
 
     float Input::GetAxis(SDL_GameControllerAxis axis) const {
-        if (!gamepad) return 0.0f;
+        if (axis < 0 || axis >= SDL_CONTROLLER_AXIS_MAX) return 0.0f;
 
-        Sint16 value = SDL_GameControllerGetAxis(gamepad, axis);
-        float normalized = value / 32767.0f;
+        float normalized = std::max(axisValue[axis] / 32767.0f, -1.0f);
         return ApplyDeadzone(normalized);
     }
 
     bool Input::IsButtonPressed(SDL_GameControllerButton button) const {
-        if (!gamepad) return false;
-
-        auto it = currentButtonState.find(button);
-        return it != currentButtonState.end() && it->second;
+        if (button < 0 || button >= SDL_CONTROLLER_BUTTON_MAX) return false;
+        return buttonDown[button] != 0;
     }
 
     bool Input::IsButtonJustPressed(SDL_GameControllerButton button) const {
-        if (!gamepad) return false;
-
-        auto currentIt = currentButtonState.find(button);
-        auto previousIt = previousButtonState.find(button);
-
-        bool currentPressed = currentIt != currentButtonState.end() && currentIt->second;
-        bool previousPressed = previousIt != previousButtonState.end() && previousIt->second;
-
-        return currentPressed && !previousPressed;
+        if (button < 0 || button >= SDL_CONTROLLER_BUTTON_MAX) return false;
+        return buttonPressFrame[button] == frame;
     }
 
     void Input::SetMouseCaptured(bool captured) {
@@ -159,26 +306,48 @@ namespace VibeReaper {
         }
     }
 
-    void Input::OpenGamepad(int deviceIndex) {
+    void Input::OpenGamepad(int deviceIndex, Uint64 timestamp) {
         gamepad = SDL_GameControllerOpen(deviceIndex);
         if (gamepad) {
             const char* name = SDL_GameControllerName(gamepad);
             LOG_INFO("Gamepad connected: " + std::string(name ? name : "Unknown"));
+
+            InputEvent event;
+            event.timestamp = timestamp;
+            event.type = InputEventType::GamepadConnected;
+            InjectEvent(event);
+
+            // Sticks resting off-center send no motion event until they move
+            event.type = InputEventType::GamepadAxis;
+            for (int axis = 0; axis < SDL_CONTROLLER_AXIS_MAX; ++axis) {
+                event.code = static_cast<uint16_t>(axis);
+                event.x = SDL_GameControllerGetAxis(gamepad, static_cast<SDL_GameControllerAxis>(axis));
+                if (event.x != 0) InjectEvent(event);
+            }
         } else {
             LOG_ERROR("Failed to open gamepad: " + std::string(SDL_GetError()));
         }
     }
 
-    void Input::CloseGamepad() {
+    void Input::CloseGamepad(Uint64 timestamp) {
         if (gamepad) {
             SDL_GameControllerClose(gamepad);
             gamepad = nullptr;
-            currentButtonState.clear();
-            previousButtonState.clear();
             LOG_INFO("Gamepad disconnected");
+
+            InputEvent event;
+            event.timestamp = timestamp;
+            event.type = InputEventType::GamepadDisconnected;
+            InjectEvent(event);
         }
     }
 
+    void Input::ClearGamepadState() {
+        buttonDown.fill(0);
+        buttonPressFrame.fill(0);
+        axisValue.fill(0);
+    }
+
     float Input::ApplyDeadzone(float value) const {
         if (std::abs(value) < DEADZONE) {
             return 0.0f;
@@ -2,19 +2,62 @@
 
 #include <SDL2/SDL.h>
 #include <glm/glm.hpp>
-#include <unordered_map>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 namespace VibeReaper {
 
+    enum class InputEventType : uint8_t {
+        KeyDown,
+        KeyUp,
+        MouseButtonDown,
+        MouseButtonUp,
+        MouseMotion,
+        GamepadButtonDown,
+        GamepadButtonUp,
+        GamepadAxis,
+        GamepadConnected,
+        GamepadDisconnected
+    };
+
+    /**
+     * @brief One input event as recorded by Input (16 bytes)
+     */
+    struct InputEvent {
+        Uint64 timestamp = 0;       // SDL_GetPerformanceCounter() when it was processed
+        InputEventType type = InputEventType::KeyDown;
+        uint8_t repeat = 0;         // Key auto-repeat or restored held state: not a new press
+        uint16_t code = 0;          // Scancode, mouse button, gamepad button or axis
+        int16_t x = 0;              // Mouse motion xrel, axis value
+        int16_t y = 0;              // Mouse motion yrel
+    };
+
+    // Input-to-present latency: from the oldest input event applied in a frame
+    // to MarkPresented() for that frame
+    struct InputLatencyStats {
+        size_t frames = 0;          // Presented frames that had input
+        double averageMs = 0.0;
+        double maxMs = 0.0;
+        double lastMs = 0.0;
+    };
+
     /**
      * @brief Unified input system supporting keyboard, mouse, and gamepad
      *
      * Provides abstraction for all input types with support for:
      * - Continuous hold detection (IsKeyPressed)
-     * - Single-frame press detection (IsKeyJustPressed)
+     * - Single-frame press detection (IsKeyJustPressed), including presses
+     *   released again within the same frame
      * - Mouse delta tracking
      * - Gamepad analog stick input with deadzone
      * - Hot-plugging gamepad support
+     * - A timestamped event ring for consuming input in order (PollEvent)
+     *   and measuring input-to-present latency
+     *
+     * All state is built from events; nothing is polled from SDL per frame, so
+     * feeding recorded events back through InjectEvent() reproduces it exactly.
      */
     class Input {
     public:
@@ -32,15 +75,47 @@ namespace VibeReaper {
         void ProcessEvent(const SDL_Event& event);
 
         /**
-         * @brief Prepare input state - call once BEFORE event loop
-         * Captures current state to previous state before SDL updates it
+         * @brief Process an SDL event with an explicit timestamp
+         * @param timestamp Performance counter value to record the event with
+         */
+        void ProcessEvent(const SDL_Event& event, Uint64 timestamp);
+
+        /**
+         * @brief Start a new input frame - call once BEFORE event loop
+         * Clears per-frame state (mouse delta, just-pressed)
          */
         void Prepare();
 
         /**
-         * @brief Update input state - call once AFTER event loop
+         * @brief Apply an already translated event (input replay)
+         * Updates state and records it in the ring exactly like ProcessEvent
+         */
+        void InjectEvent(const InputEvent& event);
+
+        // Events recorded since the last Prepare(), oldest first (input recording)
+        void GetFrameEvents(std::vector<InputEvent>& out) const;
+        // Events that rebuild the current held state from a fresh Input
+        void GetStateEvents(std::vector<InputEvent>& out, Uint64 timestamp) const;
+
+        /**
+         * @brief Pop the oldest unconsumed event recorded at or before `until`
+         * @return false when no such event is left; later events stay queued
+         *
+         * Lets a simulation tick consume exactly the input that happened
+         * before its end time, in order.
          */
-        void Update();
+        bool PollEvent(InputEvent& event, Uint64 until = UINT64_MAX);
+        size_t GetPendingEventCount() const { return static_cast<size_t>(eventWrite - eventRead); }
+        // Unconsumed events overwritten because the ring was full
+        size_t GetDroppedEventCount() const { return droppedEvents; }
+
+        /**
+         * @brief Record that the frame built from this frame's input was presented
+         * @param presentTime Performance counter value right after the swap
+         */
+        void MarkPresented(Uint64 presentTime);
+        const InputLatencyStats& GetLatencyStats() const { return latencyStats; }
+        void ResetLatencyStats() { latencyStats = InputLatencyStats(); }
 
         // Keyboard
         bool IsKeyPressed(SDL_Scancode key) const;
@@ -67,33 +142,54 @@ namespace VibeReaper {
         bool GetInvertHorizontal() const { return invertHorizontal; }
         bool GetInvertVertical() const { return invertVertical; }
 
+        static constexpr size_t EVENT_CAPACITY = 1024;    // Power of two
+        static constexpr int MOUSE_BUTTON_COUNT = 8;
+
     private:
+        // Frame counter; a key is "just pressed" when its press frame is this one
+        uint32_t frame;
+
         // Keyboard state
-        const Uint8* currentKeyState;
-        Uint8* previousKeyState;
-        int keyStateLength;
+        std::array<uint8_t, SDL_NUM_SCANCODES> keyDown;
+        std::array<uint32_t, SDL_NUM_SCANCODES> keyPressFrame;
 
         // Mouse state
         glm::vec2 mouseDelta;
-        Uint32 currentMouseState;
-        Uint32 previousMouseState;
+        std::array<uint8_t, MOUSE_BUTTON_COUNT> mouseDown;
+        std::array<uint32_t, MOUSE_BUTTON_COUNT> mousePressFrame;
         bool mouseCaptured;
 
         // Camera settings
         bool invertHorizontal;
         bool invertVertical;
 
-        // Gamepad state
+        // Gamepad state; a replayed pad is connected without an SDL handle
         SDL_GameController* gamepad;
-        std::unordered_map<SDL_GameControllerButton, bool> currentButtonState;
-        std::unordered_map<SDL_GameControllerButton, bool> previousButtonState;
+        bool gamepadConnected;
+        std::array<uint8_t, SDL_CONTROLLER_BUTTON_MAX> buttonDown;
+        std::array<uint32_t, SDL_CONTROLLER_BUTTON_MAX> buttonPressFrame;
+        std::array<Sint16, SDL_CONTROLLER_AXIS_MAX> axisValue;
+
+        // Event ring; eventWrite - eventRead events are unconsumed
+        std::array<InputEvent, EVENT_CAPACITY> events;
+        uint64_t eventRead;
+        uint64_t eventWrite;
+        size_t droppedEvents;
+        uint64_t frameEventStart;   // eventWrite at Prepare()
+
+        // Oldest input event applied in the current frame
+        bool frameHasInput;
+        Uint64 frameFirstInput;
+        InputLatencyStats latencyStats;
 
         // Constants
         static constexpr float DEADZONE = 0.15f;
 
         // Helpers
-        void OpenGamepad(int deviceIndex);
-        void CloseGamepad();
+        void PushEvent(const InputEvent& event);
+        void OpenGamepad(int deviceIndex, Uint64 timestamp);
+        void CloseGamepad(Uint64 timestamp);
+        void ClearGamepadState();
         float ApplyDeadzone(float value) const;
     };
 
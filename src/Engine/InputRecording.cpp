@@ -0,0 +1,218 @@
+#include "InputRecording.h"
+#include "../Utils/Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace VibeReaper {
+
+    namespace {
+        const char MAGIC[4] = { 'V', 'R', 'I', 'N' };
+        const size_t EVENT_SIZE = 12;
+
+        template <typename T>
+        void Put(std::vector<uint8_t>& out, T value) {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+            out.insert(out.end(), bytes, bytes + sizeof(T));
+        }
+
+        template <typename T>
+        bool Read(const std::vector<uint8_t>& data, size_t& offset, T& value) {
+            if (data.size() - offset < sizeof(T)) return false;
+            std::memcpy(&value, data.data() + offset, sizeof(T));
+            offset += sizeof(T);
+            return true;
+        }
+
+        // Reads "u16 count + events"; timestamps are rebuilt relative to 0
+        bool ReadEvents(const std::vector<uint8_t>& data, size_t& offset, std::vector<InputEvent>& events) {
+            uint16_t count;
+            if (!Read(data, offset, count) || data.size() - offset < count * EVENT_SIZE) return false;
+
+            events.resize(count);
+            for (InputEvent& event : events) {
+                uint8_t type = 0;
+                uint32_t microseconds = 0;
+                Read(data, offset, type);
+                Read(data, offset, event.repeat);
+                Read(data, offset, event.code);
+                Read(data, offset, event.x);
+                Read(data, offset, event.y);
+                Read(data, offset, microseconds);
+                event.type = static_cast<InputEventType>(type);
+                event.timestamp = microseconds;
+            }
+            return true;
+        }
+
+        double Percentile(const std::vector<double>& sorted, double fraction) {
+            size_t index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+            return sorted[std::min(index, sorted.size() - 1)];
+        }
+    }
+
+    // ========================================================================
+    // InputRecorder
+    // ========================================================================
+
+    InputRecorder::InputRecorder() : frameCount(0) {}
+
+    InputRecorder::~InputRecorder() {
+        Close();
+    }
+
+    bool InputRecorder::Open(const std::string& path, const Input& input) {
+        Close();
+
+        file.open(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            LOG_ERROR("Failed to open input recording: " + path);
+            return false;
+        }
+
+        buffer.assign(MAGIC, MAGIC + 4);
+        Put(buffer, VERSION);
+
+        // Whatever is already held (connected pad, pressed keys) replays first
+        events.clear();
+        input.GetStateEvents(events, 0);
+        WriteEvents(events);
+        file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+
+        frameCount = 0;
+        LOG_INFO("Recording input to " + path);
+        return true;
+    }
+
+    void InputRecorder::Close() {
+        if (!file.is_open()) return;
+        file.close();
+        LOG_INFO("Input recording closed: {} frames", frameCount);
+    }
+
+    void InputRecorder::RecordFrame(const Input& input, double deltaTime) {
+        if (!file.is_open()) return;
+
+        events.clear();
+        input.GetFrameEvents(events);
+
+        buffer.clear();
+        Put(buffer, deltaTime);
+        WriteEvents(events);
+        file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        frameCount++;
+    }
+
+    void InputRecorder::WriteEvents(const std::vector<InputEvent>& frameEvents) {
+        size_t count = std::min<size_t>(frameEvents.size(), 0xFFFF);
+        Put(buffer, static_cast<uint16_t>(count));
+
+        Uint64 first = count > 0 ? frameEvents[0].timestamp : 0;
+        double ticksPerMicrosecond = static_cast<double>(SDL_GetPerformanceFrequency()) / 1e6;
+        for (size_t i = 0; i < count; ++i) {
+            const InputEvent& event = frameEvents[i];
+            Uint64 ticks = event.timestamp > first ? event.timestamp - first : 0;
+            double microseconds = static_cast<double>(ticks) / ticksPerMicrosecond;
+
+            Put(buffer, static_cast<uint8_t>(event.type));
+            Put(buffer, event.repeat);
+            Put(buffer, event.code);
+            Put(buffer, event.x);
+            Put(buffer, event.y);
+            Put(buffer, static_cast<uint32_t>(std::min(microseconds, 4294967295.0)));
+        }
+    }
+
+    // ========================================================================
+    // InputReplay
+    // ========================================================================
+
+    InputReplay::InputReplay() : nextFrame(0) {}
+
+    bool InputReplay::Load(const std::string& path) {
+        initialEvents.clear();
+        frames.clear();
+        frameTimes.clear();
+        nextFrame = 0;
+        error.clear();
+
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            error = "cannot open " + path;
+            return false;
+        }
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        size_t offset = 0;
+        uint32_t version = 0;
+        if (data.size() < 4 || std::memcmp(data.data(), MAGIC, 4) != 0) {
+            error = "not an input recording";
+            return false;
+        }
+        offset = 4;
+        if (!Read(data, offset, version) || version != InputRecorder::VERSION) {
+            error = "unsupported version " + std::to_string(version);
+            return false;
+        }
+        if (!ReadEvents(data, offset, initialEvents)) {
+            error = "truncated header";
+            return false;
+        }
+
+        while (offset < data.size()) {
+            InputRecordingFrame frame;
+            if (!Read(data, offset, frame.deltaTime) || !ReadEvents(data, offset, frame.events)) {
+                error = "truncated after frame " + std::to_string(frames.size());
+                break;
+            }
+            frames.push_back(std::move(frame));
+        }
+        return true;
+    }
+
+    bool InputReplay::NextFrame(Input& input, double& deltaTime) {
+        if (IsFinished()) return false;
+
+        // Recorded offsets are relative to the frame's first event; replayed
+        // events happen "now" so latency stats stay meaningful
+        Uint64 now = SDL_GetPerformanceCounter();
+        double ticksPerMicrosecond = static_cast<double>(SDL_GetPerformanceFrequency()) / 1e6;
+
+        if (nextFrame == 0) {
+            for (InputEvent event : initialEvents) {
+                event.timestamp = now;
+                input.InjectEvent(event);
+            }
+        }
+
+        const InputRecordingFrame& frame = frames[nextFrame++];
+        for (InputEvent event : frame.events) {
+            event.timestamp = now + static_cast<Uint64>(static_cast<double>(event.timestamp) * ticksPerMicrosecond);
+            input.InjectEvent(event);
+        }
+
+        deltaTime = frame.deltaTime;
+        return true;
+    }
+
+    FrameTimeSummary InputReplay::GetFrameTimeSummary() const {
+        FrameTimeSummary summary;
+        if (frameTimes.empty()) return summary;
+
+        std::vector<double> sorted = frameTimes;
+        std::sort(sorted.begin(), sorted.end());
+
+        double total = 0.0;
+        for (double ms : sorted) {
+            total += ms;
+        }
+        summary.frames = sorted.size();
+        summary.averageMs = total / static_cast<double>(sorted.size());
+        summary.p50Ms = Percentile(sorted, 0.50);
+        summary.p95Ms = Percentile(sorted, 0.95);
+        summary.p99Ms = Percentile(sorted, 0.99);
+        summary.maxMs = sorted.back();
+        return summary;
+    }
+
+} // namespace VibeReaper
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Input.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace VibeReaper {
+
+    // One simulation frame of a recording
+    struct InputRecordingFrame {
+        double deltaTime = 0.0;
+        std::vector<InputEvent> events;
+    };
+
+    // Wall-clock frame times of a replay run
+    struct FrameTimeSummary {
+        size_t frames = 0;
+        double averageMs = 0.0;
+        double p50Ms = 0.0;
+        double p95Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+    };
+
+    /**
+     * @brief Writes the per-frame input events and delta times of a session
+     *
+     * File layout (little-endian):
+     *   header  "VRIN", u32 version, u16 count + events (held state at Open())
+     *   frames  f64 deltaTime, u16 count + events
+     *   event   u8 type, u8 repeat, u16 code, i16 x, i16 y, u32 microseconds after the frame's first event
+     *
+     * A frame with no input costs 10 bytes. Frames are appended as they are
+     * recorded, so a session cut short by a crash still replays up to there.
+     */
+    class InputRecorder {
+    public:
+        InputRecorder();
+        ~InputRecorder();
+
+        InputRecorder(const InputRecorder&) = delete;
+        InputRecorder& operator=(const InputRecorder&) = delete;
+
+        bool Open(const std::string& path, const Input& input);
+        void Close();
+        bool IsOpen() const { return file.is_open(); }
+
+        /**
+         * @brief Append one frame - call after the frame's events were processed
+         * @param deltaTime Delta time the simulation uses for this frame
+         */
+        void RecordFrame(const Input& input, double deltaTime);
+
+        size_t GetFrameCount() const { return frameCount; }
+
+        static constexpr uint32_t VERSION = 1;
+
+    private:
+        void WriteEvents(const std::vector<InputEvent>& frameEvents);
+
+        std::ofstream file;
+        std::vector<uint8_t> buffer;
+        std::vector<InputEvent> events;
+        size_t frameCount;
+    };
+
+    /**
+     * @brief Plays an InputRecorder file back through Input instead of SDL
+     *
+     * The whole file is read up front so a benchmark run does no file I/O.
+     * Each NextFrame() injects one recorded frame's events and returns its
+     * delta time, so the player and camera take the same path every run.
+     */
+    class InputReplay {
+    public:
+        InputReplay();
+
+        // Reads the whole file; a truncated last frame is dropped with a note in GetError()
+        bool Load(const std::string& path);
+
+        /**
+         * @brief Feed the next recorded frame into input - call after Input::Prepare()
+         * @param deltaTime Receives the recorded delta time
+         * @return false once every frame has been replayed
+         */
+        bool NextFrame(Input& input, double& deltaTime);
+
+        bool IsFinished() const { return nextFrame >= frames.size(); }
+        size_t GetFrameCount() const { return frames.size(); }
+        size_t GetCurrentFrame() const { return nextFrame; }
+        const std::string& GetError() const { return error; }
+
+        // Wall-clock frame times measured during the replay, for comparing builds
+        void AddFrameTime(double ms) { frameTimes.push_back(ms); }
+        FrameTimeSummary GetFrameTimeSummary() const;
+
+    private:
+        std::vector<InputEvent> initialEvents;
+        std::vector<InputRecordingFrame> frames;
+        size_t nextFrame;
+        std::vector<double> frameTimes;
+        std::string error;
+    };
+
+} // namespace VibeReaper
@@ -0,0 +1,67 @@
+#include "InstanceBuffer.h"
+#include <algorithm>
+
+namespace VibeReaper {
+
+    InstanceBuffer::InstanceBuffer()
+        : buffer(0), count(0), capacity(0) {
+    }
+
+    InstanceBuffer::~InstanceBuffer() {
+        Cleanup();
+    }
+
+    InstanceBuffer::InstanceBuffer(InstanceBuffer&& other) noexcept
+        : buffer(other.buffer), count(other.count), capacity(other.capacity) {
+        other.buffer = 0;
+        other.count = 0;
+        other.capacity = 0;
+    }
+
+    InstanceBuffer& InstanceBuffer::operator=(InstanceBuffer&& other) noexcept {
+        if (this != &other) {
+            Cleanup();
+            buffer = other.buffer;
+            count = other.count;
+            capacity = other.capacity;
+            other.buffer = 0;
+            other.count = 0;
+            other.capacity = 0;
+        }
+        return *this;
+    }
+
+    void InstanceBuffer::Create() {
+        if (buffer == 0) {
+            glGenBuffers(1, &buffer);
+        }
+    }
+
+    void InstanceBuffer::Update(const InstanceData* instances, size_t instanceCount) {
+        Create();
+        count = instanceCount;
+        if (count == 0) return;
+
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+        // Grow geometrically so per-frame count changes rarely reallocate; same-size
+        // glBufferData(nullptr) orphans the old storage either way
+        if (count > capacity) {
+            capacity = std::max(count, capacity * 2);
+        }
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(InstanceData), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(InstanceData), instances);
+
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void InstanceBuffer::Cleanup() {
+        if (buffer != 0) {
+            glDeleteBuffers(1, &buffer);
+            buffer = 0;
+        }
+        count = 0;
+        capacity = 0;
+    }
+
+} // namespace VibeReaper
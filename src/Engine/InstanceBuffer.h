@@ -0,0 +1,60 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstddef>
+
+namespace VibeReaper {
+
+    // Per-instance vertex data (attribute locations 4-7: model columns, 8: color)
+    struct InstanceData {
+        glm::mat4 model;
+        glm::vec4 color;
+
+        InstanceData() : model(1.0f), color(1.0f) {}
+        InstanceData(const glm::mat4& model, const glm::vec4& color) : model(model), color(color) {}
+    };
+
+    /**
+     * @brief Per-instance attribute buffer, re-streamed every frame
+     *
+     * Update() orphans the previous storage (glBufferData with nullptr) before
+     * writing, so the driver hands out fresh memory instead of stalling on
+     * draws that still read last frame's instances. The buffer name never
+     * changes, so a VAO set up with Mesh::AttachInstanceBuffer() stays valid.
+     */
+    class InstanceBuffer {
+    public:
+        static const GLuint MODEL_LOCATION = 4;    // mat4 takes locations 4..7
+        static const GLuint COLOR_LOCATION = 8;
+
+        InstanceBuffer();
+        ~InstanceBuffer();
+
+        InstanceBuffer(InstanceBuffer&& other) noexcept;
+        InstanceBuffer& operator=(InstanceBuffer&& other) noexcept;
+        InstanceBuffer(const InstanceBuffer&) = delete;
+        InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+
+        // Create the GL buffer (needed before a mesh can attach to it)
+        void Create();
+
+        // Replace the instance data for this frame
+        void Update(const InstanceData* instances, size_t count);
+        void Update(const std::vector<InstanceData>& instances) { Update(instances.data(), instances.size()); }
+
+        GLuint GetBuffer() const { return buffer; }
+        size_t GetCount() const { return count; }
+        size_t GetCapacity() const { return capacity; }
+        size_t GetBytesUploaded() const { return count * sizeof(InstanceData); }
+
+    private:
+        GLuint buffer;
+        size_t count;
+        size_t capacity;
+
+        void Cleanup();
+    };
+
+} // namespace VibeReaper
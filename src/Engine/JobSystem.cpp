@@ -0,0 +1,208 @@
+#include "JobSystem.h"
+#include "../Utils/Logger.h"
+#include <algorithm>
+#include <chrono>
+
+namespace VibeReaper {
+
+    namespace {
+        // Which deque the current thread owns (per JobSystem, so several can coexist)
+        thread_local const JobSystem* t_owner = nullptr;
+        thread_local size_t t_queueIndex = 0;
+    }
+
+    JobSystem::JobSystem(unsigned int threadCount)
+        : queuedJobs(0), executed(0), stolen(0), stopping(false) {
+        if (threadCount == 0) {
+            unsigned int hardwareThreads = std::thread::hardware_concurrency();
+            threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        }
+
+        for (unsigned int i = 0; i <= threadCount; i++) {
+            queues.push_back(std::make_unique<WorkQueue>());
+        }
+        for (unsigned int i = 0; i < threadCount; i++) {
+            workers.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+        }
+        LOG_INFO("JobSystem started with " + std::to_string(threadCount) + " worker threads");
+    }
+
+    JobSystem::~JobSystem() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wakeCondition.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    size_t JobSystem::CurrentQueueIndex() const {
+        return t_owner == this ? t_queueIndex : 0;
+    }
+
+    void JobSystem::Run(std::function<void()> job, JobCounter* counter) {
+        if (counter) {
+            counter->value.fetch_add(1, std::memory_order_relaxed);
+        }
+        Push(Job{ std::move(job), counter });
+    }
+
+    void JobSystem::RunAfter(JobCounter& dependency, std::function<void()> job, JobCounter* counter) {
+        // The dependent job counts as pending from now on, not from when it is queued
+        if (counter) {
+            counter->value.fetch_add(1, std::memory_order_relaxed);
+        }
+        auto queueJob = [this, counter, function = std::move(job)]() mutable {
+            Push(Job{ std::move(function), counter });
+        };
+
+        {
+            // Execute() brings the counter to zero under this lock, so a continuation
+            // is either taken by it or sees the zero itself, never neither
+            std::lock_guard<std::mutex> lock(dependency.continuationMutex);
+            if (!dependency.IsDone()) {
+                dependency.continuations.push_back(std::move(queueJob));
+                return;
+            }
+        }
+        queueJob();
+    }
+
+    void JobSystem::Push(Job job) {
+        WorkQueue& queue = *queues[CurrentQueueIndex()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.jobs.push_back(std::move(job));
+        }
+        queuedJobs.fetch_add(1, std::memory_order_release);
+
+        // Taking the lock orders this with a worker's check-then-sleep
+        { std::lock_guard<std::mutex> lock(sleepMutex); }
+        wakeCondition.notify_one();
+    }
+
+    bool JobSystem::PopLocal(size_t queueIndex, Job& job) {
+        WorkQueue& queue = *queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) return false;
+
+        job = std::move(queue.jobs.back());
+        queue.jobs.pop_back();
+        return true;
+    }
+
+    bool JobSystem::Steal(size_t thiefIndex, Job& job) {
+        // Start after the thief's own deque so victims are spread across threads
+        size_t count = queues.size();
+        for (size_t i = 1; i < count; i++) {
+            WorkQueue& queue = *queues[(thiefIndex + i) % count];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.jobs.empty()) continue;
+
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            stolen.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    bool JobSystem::TryRunOne() {
+        size_t index = CurrentQueueIndex();
+        Job job;
+        if (PopLocal(index, job) || Steal(index, job)) {
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            Execute(job);
+            return true;
+        }
+        return false;
+    }
+
+    void JobSystem::Execute(Job& job) {
+        job.function();
+        executed.fetch_add(1, std::memory_order_relaxed);
+
+        JobCounter* counter = job.counter;
+        if (!counter) return;
+
+        std::vector<std::function<void()>> ready;
+        int expected = counter->value.load(std::memory_order_relaxed);
+        while (true) {
+            if (expected != 1) {
+                if (counter->value.compare_exchange_weak(expected, expected - 1, std::memory_order_acq_rel)) break;
+                continue;
+            }
+
+            // Probably the last job of the group: reach zero under the continuation
+            // lock. Wait() takes the same lock before returning, so the owner can't
+            // destroy the counter while this thread still touches it.
+            std::lock_guard<std::mutex> lock(counter->continuationMutex);
+            if (counter->value.compare_exchange_strong(expected, 0, std::memory_order_acq_rel)) {
+                ready.swap(counter->continuations);
+                break;
+            }
+        }
+
+        // Release anything queued with RunAfter() (the counter may be gone by now)
+        for (auto& continuation : ready) {
+            continuation();
+        }
+    }
+
+    void JobSystem::Wait(JobCounter& counter) {
+        while (!counter.IsDone()) {
+            if (!TryRunOne()) {
+                // Remaining jobs are running elsewhere
+                std::this_thread::yield();
+            }
+        }
+
+        // The job that reached zero may still hold the lock (see Execute())
+        std::lock_guard<std::mutex> lock(counter.continuationMutex);
+    }
+
+    void JobSystem::ParallelFor(size_t count, size_t grainSize,
+                                const std::function<void(size_t begin, size_t end)>& body) {
+        if (count == 0) return;
+        grainSize = std::max<size_t>(grainSize, 1);
+        if (count <= grainSize) {
+            body(0, count);
+            return;
+        }
+
+        JobCounter counter;
+        for (size_t begin = 0; begin < count; begin += grainSize) {
+            size_t end = std::min(begin + grainSize, count);
+            Run([&body, begin, end]() { body(begin, end); }, &counter);
+        }
+        Wait(counter);
+    }
+
+    void JobSystem::WorkerLoop(unsigned int queueIndex) {
+        t_owner = this;
+        t_queueIndex = queueIndex;
+
+        while (true) {
+            if (TryRunOne()) continue;
+
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            // Timed wait as a safety net; Push() takes the same mutex before notifying
+            wakeCondition.wait_for(lock, std::chrono::milliseconds(10), [this]() {
+                return stopping.load() || queuedJobs.load(std::memory_order_acquire) > 0;
+            });
+            if (stopping && queuedJobs.load() == 0) break;
+        }
+
+        t_owner = nullptr;
+    }
+
+    JobSystemStats JobSystem::GetStats() const {
+        JobSystemStats stats;
+        stats.jobsExecuted = executed.load();
+        stats.jobsStolen = stolen.load();
+        return stats;
+    }
+
+} // namespace VibeReaper
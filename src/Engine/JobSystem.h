@@ -0,0 +1,110 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <cstddef>
+
+namespace VibeReaper {
+
+    class JobSystem;
+
+    /**
+     * @brief Completion counter for a group of jobs
+     *
+     * Every job started with a counter increments it and decrements it when done,
+     * so Wait(counter) returns once the whole group has finished. Jobs queued with
+     * RunAfter(counter, ...) start when it next reaches zero. A counter must outlive
+     * the jobs that reference it: destroy or reuse it only after Wait() returned.
+     */
+    class JobCounter {
+    public:
+        JobCounter() : value(0) {}
+
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        bool IsDone() const { return value.load(std::memory_order_acquire) == 0; }
+        int GetPending() const { return value.load(std::memory_order_acquire); }
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<int> value;
+        std::mutex continuationMutex;
+        std::vector<std::function<void()>> continuations;   // Queued by RunAfter
+    };
+
+    struct JobSystemStats {
+        size_t jobsExecuted = 0;
+        size_t jobsStolen = 0;      // Taken from another thread's deque
+    };
+
+    /**
+     * @brief Work-stealing job scheduler
+     *
+     * One deque per worker plus one shared by non-worker threads (the main thread).
+     * A thread pushes and pops jobs at the back of its own deque (LIFO, cache warm)
+     * and, when that is empty, steals from the front of the others (oldest, usually
+     * the biggest chunks of work). Waiting threads run jobs instead of blocking, so
+     * jobs may spawn and wait on further jobs without deadlocking.
+     */
+    class JobSystem {
+    public:
+        // threadCount 0 = hardware concurrency - 1 (at least 1)
+        explicit JobSystem(unsigned int threadCount = 0);
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        // Queue a job on the calling thread's deque
+        void Run(std::function<void()> job, JobCounter* counter = nullptr);
+
+        // Queue a job once dependency reaches zero (immediately if it already has)
+        void RunAfter(JobCounter& dependency, std::function<void()> job, JobCounter* counter = nullptr);
+
+        // Run queued jobs on this thread until counter is done
+        void Wait(JobCounter& counter);
+
+        // Call body(begin, end) over [0, count) in chunks of about grainSize; returns when all are done
+        void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& body);
+
+        unsigned int GetWorkerCount() const { return static_cast<unsigned int>(workers.size()); }
+        JobSystemStats GetStats() const;
+
+    private:
+        struct Job {
+            std::function<void()> function;
+            JobCounter* counter;
+        };
+
+        struct WorkQueue {
+            std::mutex mutex;
+            std::deque<Job> jobs;
+        };
+
+        std::vector<std::unique_ptr<WorkQueue>> queues;     // [0] = non-worker threads, [i + 1] = worker i
+        std::vector<std::thread> workers;
+        std::atomic<size_t> queuedJobs;
+        std::atomic<size_t> executed;
+        std::atomic<size_t> stolen;
+        std::atomic<bool> stopping;
+        std::mutex sleepMutex;
+        std::condition_variable wakeCondition;
+
+        void WorkerLoop(unsigned int queueIndex);
+        void Push(Job job);
+        bool TryRunOne();
+        bool PopLocal(size_t queueIndex, Job& job);
+        bool Steal(size_t thiefIndex, Job& job);
+        void Execute(Job& job);
+        size_t CurrentQueueIndex() const;
+    };
+
+} // namespace VibeReaper
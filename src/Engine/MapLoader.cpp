@@ -58,6 +58,63 @@ namespace VibeReaper {
         return defaultValue;
     }
 
+    void Entity::SetOrigin(const glm::vec3& origin) {
+        SetVector3("origin", origin);
+    }
+
+    void Entity::SetVector3(const std::string& key, const glm::vec3& value) {
+        // Write back in the same "x y z" format the parser expects
+        std::ostringstream oss;
+        oss.precision(9);
+        oss << value.x << " " << value.y << " " << value.z;
+        properties[key] = oss.str();
+    }
+
+    // ========== Brush Helper Methods ==========
+
+    namespace {
+        const uint64_t FNV_OFFSET = 14695981039346656037ull;
+        const uint64_t FNV_PRIME = 1099511628211ull;
+
+        void HashBytes(uint64_t& hash, const void* data, size_t size) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; i++) {
+                hash ^= bytes[i];
+                hash *= FNV_PRIME;
+            }
+        }
+
+        void HashFloat(uint64_t& hash, float value) {
+            // Adding zero folds -0 into +0
+            value += 0.0f;
+            HashBytes(hash, &value, sizeof(value));
+        }
+
+        void HashVector(uint64_t& hash, const glm::vec3& vector) {
+            HashFloat(hash, vector.x);
+            HashFloat(hash, vector.y);
+            HashFloat(hash, vector.z);
+        }
+    }
+
+    uint64_t Brush::Hash() const {
+        uint64_t hash = FNV_OFFSET;
+        for (const Plane& plane : planes) {
+            HashVector(hash, plane.normal);
+            HashFloat(hash, plane.distance);
+            // Length first, so "ab" + "c" and "a" + "bc" differ
+            uint32_t length = static_cast<uint32_t>(plane.texture.size());
+            HashBytes(hash, &length, sizeof(length));
+            HashBytes(hash, plane.texture.data(), plane.texture.size());
+            HashFloat(hash, plane.offsetX);
+            HashFloat(hash, plane.offsetY);
+            HashFloat(hash, plane.rotation);
+            HashFloat(hash, plane.scaleX);
+            HashFloat(hash, plane.scaleY);
+        }
+        return hash;
+    }
+
     // ========== Map Helper Methods ==========
 
     Entity* Map::FindEntityByClass(const std::string& classname) {
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <cstdint>
 #include <glm/glm.hpp>
 
 namespace VibeReaper {
@@ -24,6 +25,10 @@ namespace VibeReaper {
     // Brush definition (convex solid defined by planes)
     struct Brush {
         std::vector<Plane> planes;
+
+        // FNV-1a over what BrushConverter reads (plane equations and texture mapping);
+        // equal brushes hash equally across parses
+        uint64_t Hash() const;
     };
 
     // Entity definition (game object or worldspawn)
@@ -38,6 +43,10 @@ namespace VibeReaper {
         float GetFloat(const std::string& key, float defaultValue = 0.0f) const;
         std::string GetString(const std::string& key, const std::string& defaultValue = "") const;
         glm::vec3 GetVector3(const std::string& key, const glm::vec3& defaultValue = glm::vec3(0)) const;
+
+        // Helper methods to overwrite typed properties
+        void SetOrigin(const glm::vec3& origin);
+        void SetVector3(const std::string& key, const glm::vec3& value);
     };
 
     // Complete MAP structure
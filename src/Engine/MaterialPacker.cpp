@@ -0,0 +1,344 @@
+#include "MaterialPacker.h"
+#include "../Utils/Logger.h"
+#include <algorithm>
+
+namespace VibeReaper {
+
+    MaterialPacker::MaterialPacker()
+        : decodedBytes(0), decodeTick(0), placeholderID(0), built(false) {
+    }
+
+    MaterialPacker::~MaterialPacker() {
+        Clear();
+        if (placeholderID != 0) {
+            glDeleteTextures(1, &placeholderID);
+            placeholderID = 0;
+        }
+    }
+
+    int MaterialPacker::AddMaterial(const std::string& name) {
+        auto it = layerLookup.find(name);
+        if (it != layerLookup.end()) {
+            return it->second;
+        }
+
+        // GL 3.3 guarantees 256 layers per array, so even a single size class always fits
+        if (static_cast<int>(layers.size()) >= MAX_LAYERS) {
+            LOG_WARNING("Material array full, mapping '" + name + "' to layer 0");
+            return 0;
+        }
+
+        int layer = static_cast<int>(layers.size());
+        Layer entry;
+        entry.name = name;
+        auto cached = decoded.find(name);
+        if (cached != decoded.end()) {
+            entry.rgba.swap(cached->second.rgba);
+            entry.width = cached->second.width;
+            entry.height = cached->second.height;
+            decodedBytes -= entry.rgba.size();
+            decoded.erase(cached);
+        }
+        layers.push_back(std::move(entry));
+        layerLookup[name] = layer;
+        built = false;
+        return layer;
+    }
+
+    int MaterialPacker::GetLayer(const std::string& name) const {
+        auto it = layerLookup.find(name);
+        return it != layerLookup.end() ? it->second : 0;
+    }
+
+    void MaterialPacker::SetLayerPixels(int layer, const unsigned char* pixels, int width, int height, int channels) {
+        if (layer < 0 || layer >= static_cast<int>(layers.size()) || !pixels) return;
+
+        // Expand to RGBA8 so every layer shares one internal format
+        Layer& entry = layers[layer];
+        entry.width = width;
+        entry.height = height;
+        entry.rgba.resize(static_cast<size_t>(width) * height * 4);
+
+        for (int i = 0; i < width * height; i++) {
+            const unsigned char* src = pixels + static_cast<size_t>(i) * channels;
+            unsigned char* dst = &entry.rgba[static_cast<size_t>(i) * 4];
+            if (channels >= 3) {
+                dst[0] = src[0];
+                dst[1] = src[1];
+                dst[2] = src[2];
+                dst[3] = channels == 4 ? src[3] : 255;
+            } else {
+                // Grey (+ alpha)
+                dst[0] = dst[1] = dst[2] = src[0];
+                dst[3] = channels == 2 ? src[1] : 255;
+            }
+        }
+
+        built = false;
+    }
+
+    void MaterialPacker::PlanArrays() {
+        // Distinct class sizes, smallest area first; missing layers stay white in the smallest
+        std::vector<std::pair<int, int>> sizes;
+        for (const auto& layer : layers) {
+            if (layer.rgba.empty()) continue;
+            std::pair<int, int> size(ClassSize(layer.width), ClassSize(layer.height));
+            if (std::find(sizes.begin(), sizes.end(), size) == sizes.end()) {
+                sizes.push_back(size);
+            }
+        }
+        if (sizes.empty()) {
+            sizes.emplace_back(1, 1);
+        }
+
+        auto byArea = [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+            if (a.first * a.second != b.first * b.second) return a.first * a.second < b.first * b.second;
+            return a.first < b.first;
+        };
+        std::sort(sizes.begin(), sizes.end(), byArea);
+
+        // Too many classes: grow the next class to cover the smallest one, which
+        // costs the least memory
+        while (static_cast<int>(sizes.size()) > MAX_ARRAYS) {
+            sizes[1].first = std::max(sizes[0].first, sizes[1].first);
+            sizes[1].second = std::max(sizes[0].second, sizes[1].second);
+            sizes.erase(sizes.begin());
+            std::sort(sizes.begin(), sizes.end(), byArea);
+            sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+        }
+
+        arrays.assign(sizes.size(), MaterialArray());
+        for (size_t i = 0; i < sizes.size(); i++) {
+            arrays[i].width = sizes[i].first;
+            arrays[i].height = sizes[i].second;
+        }
+
+        // Each layer goes to the smallest array that holds its class size
+        layerSlots.assign(layers.size(), 0);
+        for (size_t i = 0; i < layers.size(); i++) {
+            Layer& layer = layers[i];
+            layer.array = 0;
+            if (!layer.rgba.empty()) {
+                int width = ClassSize(layer.width);
+                int height = ClassSize(layer.height);
+                while (arrays[layer.array].width < width || arrays[layer.array].height < height) {
+                    layer.array++;
+                }
+            }
+            layer.slice = arrays[layer.array].layerCount++;
+            layerSlots[i] = (layer.array << SLICE_BITS) | layer.slice;
+        }
+    }
+
+    bool MaterialPacker::Build() {
+        if (layers.empty()) return false;
+
+        DeleteArrays();
+        PlanArrays();
+
+        for (MaterialArray& array : arrays) {
+            glGenTextures(1, &array.id);
+            glBindTexture(GL_TEXTURE_2D_ARRAY, array.id);
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, array.width, array.height, array.layerCount, 0, GL_RGBA,
+                         GL_UNSIGNED_BYTE, nullptr);
+        }
+
+        int resampled = 0;
+        for (Layer& layer : layers) {
+            const MaterialArray& array = arrays[layer.array];
+            std::vector<unsigned char> pixels;
+            const unsigned char* slice = layer.rgba.data();
+
+            if (layer.rgba.empty()) {
+                // Failed/missing texture: white layer, same as the old per-texture fallback
+                pixels.assign(static_cast<size_t>(array.width) * array.height * 4, 255);
+                slice = pixels.data();
+            } else if (layer.width != array.width || layer.height != array.height) {
+                pixels = Resample(layer, array.width, array.height);
+                slice = pixels.data();
+                resampled++;
+            }
+
+            glBindTexture(GL_TEXTURE_2D_ARRAY, array.id);
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer.slice, array.width, array.height, 1,
+                            GL_RGBA, GL_UNSIGNED_BYTE, slice);
+
+            // The level no longer needs the CPU copy; the next one may
+            KeepDecoded(layer);
+        }
+
+        std::string sizes;
+        for (const MaterialArray& array : arrays) {
+            glBindTexture(GL_TEXTURE_2D_ARRAY, array.id);
+            glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+            // Same sampling as Texture (pixel-art look)
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+            sizes += (sizes.empty() ? "" : ", ") + std::to_string(array.layerCount) + "x " +
+                     std::to_string(array.width) + "x" + std::to_string(array.height);
+        }
+
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+        built = true;
+        LOG_INFO("Material arrays built: " + std::to_string(layers.size()) + " layers (" + sizes + ", " +
+                 std::to_string(resampled) + " resampled, " +
+                 std::to_string(GetMemoryBytes() / (1024 * 1024)) + " MB)");
+        return true;
+    }
+
+    void MaterialPacker::UpdateLayer(int layer, const unsigned char* pixels, int width, int height, int channels) {
+        if (!built) {
+            SetLayerPixels(layer, pixels, width, height, channels);
+            return;
+        }
+        if (layer < 0 || layer >= static_cast<int>(layers.size()) || !pixels) return;
+
+        // Expand through the CPU layer, then upload only this slice; the other layers'
+        // CPU copies are gone, so the layer keeps its array and that array's size
+        SetLayerPixels(layer, pixels, width, height, channels);
+        built = true;
+
+        Layer& entry = layers[layer];
+        const MaterialArray& array = arrays[entry.array];
+        std::vector<unsigned char> resampled;
+        const unsigned char* slice = entry.rgba.data();
+        if (entry.width != array.width || entry.height != array.height) {
+            resampled = Resample(entry, array.width, array.height);
+            slice = resampled.data();
+        }
+
+        glBindTexture(GL_TEXTURE_2D_ARRAY, array.id);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, entry.slice, array.width, array.height, 1,
+                        GL_RGBA, GL_UNSIGNED_BYTE, slice);
+        glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        KeepDecoded(entry);
+    }
+
+    void MaterialPacker::ForgetDecoded(const std::string& name) {
+        auto it = decoded.find(name);
+        if (it != decoded.end()) {
+            decodedBytes -= it->second.rgba.size();
+            decoded.erase(it);
+        }
+    }
+
+    void MaterialPacker::Bind(int firstUnit) {
+        if (placeholderID == 0) {
+            CreatePlaceholder();
+        }
+        for (int i = 0; i < MAX_ARRAYS; i++) {
+            bool hasArray = built && i < static_cast<int>(arrays.size());
+            glActiveTexture(GL_TEXTURE0 + firstUnit + i);
+            glBindTexture(GL_TEXTURE_2D_ARRAY, hasArray ? arrays[i].id : placeholderID);
+        }
+    }
+
+    unsigned int MaterialPacker::GetTextureID() {
+        if (built && !arrays.empty()) {
+            return arrays[0].id;
+        }
+
+        if (placeholderID == 0) {
+            CreatePlaceholder();
+        }
+        return placeholderID;
+    }
+
+    void MaterialPacker::Clear() {
+        DeleteArrays();
+        for (Layer& layer : layers) {
+            KeepDecoded(layer);
+        }
+        layers.clear();
+        layerLookup.clear();
+        layerSlots.clear();
+        built = false;
+    }
+
+    size_t MaterialPacker::GetMemoryBytes() const {
+        if (!built) return 0;
+        // RGBA8 base level plus ~1/3 for the mip chain
+        size_t base = 0;
+        for (const MaterialArray& array : arrays) {
+            base += static_cast<size_t>(array.width) * array.height * 4 * array.layerCount;
+        }
+        return base + base / 3;
+    }
+
+    void MaterialPacker::DeleteArrays() {
+        for (MaterialArray& array : arrays) {
+            if (array.id != 0) {
+                glDeleteTextures(1, &array.id);
+            }
+        }
+        arrays.clear();
+    }
+
+    void MaterialPacker::KeepDecoded(Layer& layer) {
+        if (layer.rgba.empty()) return;
+
+        ForgetDecoded(layer.name);
+        DecodedImage& image = decoded[layer.name];
+        image.rgba.swap(layer.rgba);
+        image.width = layer.width;
+        image.height = layer.height;
+        image.lastUsed = ++decodeTick;
+        decodedBytes += image.rgba.size();
+        std::vector<unsigned char>().swap(layer.rgba);
+
+        // Least recently kept first; an image larger than the whole cache evicts itself
+        while (decodedBytes > DECODED_CACHE_BYTES) {
+            auto oldest = decoded.begin();
+            for (auto it = decoded.begin(); it != decoded.end(); ++it) {
+                if (it->second.lastUsed < oldest->second.lastUsed) {
+                    oldest = it;
+                }
+            }
+            decodedBytes -= oldest->second.rgba.size();
+            decoded.erase(oldest);
+        }
+    }
+
+    int MaterialPacker::ClassSize(int size) {
+        int classSize = 1;
+        while (classSize < size && classSize < MAX_LAYER_SIZE) {
+            classSize *= 2;
+        }
+        return classSize;
+    }
+
+    void MaterialPacker::CreatePlaceholder() {
+        unsigned char white[] = { 255, 255, 255, 255 };
+
+        glGenTextures(1, &placeholderID);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, placeholderID);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, 1, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    }
+
+    std::vector<unsigned char> MaterialPacker::Resample(const Layer& layer, int width, int height) {
+        // Nearest neighbour; exact for the power-of-two ratios typical of world textures
+        std::vector<unsigned char> result(static_cast<size_t>(width) * height * 4);
+        for (int y = 0; y < height; y++) {
+            int srcY = y * layer.height / height;
+            for (int x = 0; x < width; x++) {
+                int srcX = x * layer.width / width;
+                const unsigned char* src = &layer.rgba[(static_cast<size_t>(srcY) * layer.width + srcX) * 4];
+                unsigned char* dst = &result[(static_cast<size_t>(y) * width + x) * 4];
+                dst[0] = src[0];
+                dst[1] = src[1];
+                dst[2] = src[2];
+                dst[3] = src[3];
+            }
+        }
+        return result;
+    }
+
+} // namespace VibeReaper
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstddef>
+#include <cstdint>
+
+namespace VibeReaper {
+
+    /**
+     * @brief Packs world materials into GL_TEXTURE_2D_ARRAYs, one per size class
+     *
+     * Usage:
+     * 1. AddMaterial() for every texture name used by the level (assigns layers)
+     * 2. BrushConverter writes GetLayer() into each vertex's texLayer
+     * 3. SetLayerPixels() as decoded images arrive (any order, any thread-safe source)
+     * 4. Build() on the GL thread once all layers are in
+     * 5. Bind() and GetLayerSlots() (uLayerSlots) before drawing
+     *
+     * Vertices keep the material's layer. Build() rounds each layer's size up to
+     * a power of two (at most MAX_LAYER_SIZE) and gives every size class its own
+     * array; uLayerSlots maps a layer to its (array, slice). Beyond MAX_ARRAYS
+     * classes, the smallest class is folded into the next larger one.
+     *
+     * Decoded images outlive the level: Build(), UpdateLayer() and Clear() move
+     * them into an LRU cache of up to DECODED_CACHE_BYTES, and AddMaterial() takes
+     * a cached image back, so the next level only decodes textures it has not
+     * seen recently (check HasLayerPixels() before requesting a decode).
+     *
+     * Brush UVs are independent of texture resolution (see BrushConverter::CalculateUV),
+     * so layers whose source image differs from their class size are resampled
+     * (nearest neighbour) without changing how the surface looks. Until Build() runs,
+     * Bind() binds a 1x1 white placeholder array (GL clamps all layers to it).
+     */
+    class MaterialPacker {
+    public:
+        static const int MAX_LAYERS = 256;          // GL 3.3 minimum; also the uLayerSlots size
+        static const int MAX_ARRAYS = 4;            // uTextureArrays size
+        static const int MAX_LAYER_SIZE = 1024;     // Larger images are downsampled
+        static const int SLICE_BITS = 16;           // Layer slot = array << SLICE_BITS | slice
+        static const size_t DECODED_CACHE_BYTES = 64 * 1024 * 1024;
+
+        MaterialPacker();
+        ~MaterialPacker();
+
+        MaterialPacker(const MaterialPacker&) = delete;
+        MaterialPacker& operator=(const MaterialPacker&) = delete;
+
+        // Register a material; returns its layer (existing layer if already registered).
+        // A cached decode of the same name becomes the layer's pixels.
+        int AddMaterial(const std::string& name);
+
+        // Layer for a material name (0 if unknown)
+        int GetLayer(const std::string& name) const;
+        bool HasMaterial(const std::string& name) const { return layerLookup.count(name) != 0; }
+
+        // Provide decoded pixels for a layer (nullptr keeps the layer white)
+        void SetLayerPixels(int layer, const unsigned char* pixels, int width, int height, int channels);
+        bool HasLayerPixels(int layer) const { return !layers[layer].rgba.empty(); }
+
+        // Drop the cached decode of a material whose source file changed
+        void ForgetDecoded(const std::string& name);
+
+        // Sort layers into size classes from the images set so far (no GL; Build() calls it)
+        void PlanArrays();
+
+        // Allocate the arrays and upload all layers (GL thread)
+        bool Build();
+
+        // Replace one layer's image (hot reload). Once built, the layer is uploaded
+        // in place at its array's size; before that it behaves like SetLayerPixels.
+        void UpdateLayer(int layer, const unsigned char* pixels, int width, int height, int channels);
+
+        // Bind array i (or the placeholder) to unit firstUnit + i for all MAX_ARRAYS
+        void Bind(int firstUnit);
+
+        // GL_TEXTURE_2D_ARRAY name of the first array, or the placeholder until built
+        unsigned int GetTextureID();
+
+        // Drop all materials and GL storage (decoded images stay cached)
+        void Clear();
+
+        // Getters
+        int GetLayerCount() const { return static_cast<int>(layers.size()); }
+        const std::string& GetLayerName(int layer) const { return layers[layer].name; }
+        int GetArrayCount() const { return static_cast<int>(arrays.size()); }
+        int GetArrayWidth(int array) const { return arrays[array].width; }
+        int GetArrayHeight(int array) const { return arrays[array].height; }
+        int GetLayerArray(int layer) const { return layers[layer].array; }
+        const std::vector<int>& GetLayerSlots() const { return layerSlots; }
+        bool IsBuilt() const { return built; }
+        size_t GetMemoryBytes() const;
+        size_t GetDecodedCacheBytes() const { return decodedBytes; }
+
+    private:
+        struct Layer {
+            std::string name;
+            std::vector<unsigned char> rgba;   // CPU copy until Build()
+            int width = 0;
+            int height = 0;
+            int array = 0;                     // Size class, assigned by PlanArrays()
+            int slice = 0;
+        };
+
+        struct DecodedImage {
+            std::vector<unsigned char> rgba;
+            int width = 0;
+            int height = 0;
+            uint64_t lastUsed = 0;
+        };
+
+        struct MaterialArray {
+            unsigned int id = 0;
+            int width = 1;
+            int height = 1;
+            int layerCount = 0;
+        };
+
+        std::vector<Layer> layers;
+        std::map<std::string, int> layerLookup;
+        std::vector<MaterialArray> arrays;
+        std::vector<int> layerSlots;
+        std::map<std::string, DecodedImage> decoded;
+        size_t decodedBytes;
+        uint64_t decodeTick;
+
+        unsigned int placeholderID;
+        bool built;
+
+        void CreatePlaceholder();
+        void DeleteArrays();
+        void KeepDecoded(Layer& layer);
+        static int ClassSize(int size);
+        static std::vector<unsigned char> Resample(const Layer& layer, int width, int height);
+    };
+
+} // namespace VibeReaper
@@ -1,17 +1,29 @@
 #include "Mesh.h"
 #include "../Utils/Logger.h"
 #include <glm/gtc/constants.hpp>
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <utility>
 
 namespace VibeReaper {
 
     Mesh::Mesh()
-        : VAO(0), VBO(0), EBO(0), isSetup(false) {
+        : VAO(0), VBO(0), EBO(0), isSetup(false), vertexFormat(VertexFormat::Float),
+          indexFormat(IndexFormat::Auto), indexType(GL_UNSIGNED_INT), retention(MeshRetention::Keep),
+          uploadedVertices(0), uploadedIndices(0) {
     }
 
     Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
-        : vertices(vertices), indices(indices), VAO(0), VBO(0), EBO(0), isSetup(false) {
+        : vertices(vertices), indices(indices), VAO(0), VBO(0), EBO(0), isSetup(false),
+          vertexFormat(VertexFormat::Float), indexFormat(IndexFormat::Auto), indexType(GL_UNSIGNED_INT),
+          retention(MeshRetention::Keep), uploadedVertices(0), uploadedIndices(0) {
+    }
+
+    Mesh::Mesh(std::vector<Vertex>&& vertices, std::vector<unsigned int>&& indices)
+        : vertices(std::move(vertices)), indices(std::move(indices)), VAO(0), VBO(0), EBO(0), isSetup(false),
+          vertexFormat(VertexFormat::Float), indexFormat(IndexFormat::Auto), indexType(GL_UNSIGNED_INT),
+          retention(MeshRetention::Keep), uploadedVertices(0), uploadedIndices(0) {
     }
 
     Mesh::~Mesh() {
@@ -24,7 +36,14 @@ namespace VibeReaper {
           VAO(other.VAO),
           VBO(other.VBO),
           EBO(other.EBO),
-          isSetup(other.isSetup) {
+          isSetup(other.isSetup),
+          vertexFormat(other.vertexFormat),
+          indexFormat(other.indexFormat),
+          indexType(other.indexType),
+          retention(other.retention),
+          uploadedVertices(other.uploadedVertices),
+          uploadedIndices(other.uploadedIndices),
+          collision(std::move(other.collision)) {
         
         // Reset other
         other.VAO = 0;
@@ -43,6 +62,13 @@ namespace VibeReaper {
             VBO = other.VBO;
             EBO = other.EBO;
             isSetup = other.isSetup;
+            vertexFormat = other.vertexFormat;
+            indexFormat = other.indexFormat;
+            indexType = other.indexType;
+            retention = other.retention;
+            uploadedVertices = other.uploadedVertices;
+            uploadedIndices = other.uploadedIndices;
+            collision = std::move(other.collision);
 
             // Reset other
             other.VAO = 0;
@@ -64,16 +90,85 @@ namespace VibeReaper {
         // Bind VAO
         glBindVertexArray(VAO);
 
+        // Half-float UVs only hold ~1/256 of a tile beyond 8 repeats
+        if (vertexFormat == VertexFormat::Packed && !CanPack(vertices)) {
+            vertexFormat = VertexFormat::Float;
+        }
+
         // Upload vertex data
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+        if (vertexFormat == VertexFormat::Packed) {
+            std::vector<PackedVertex> packed;
+            packed.reserve(vertices.size());
+            for (const auto& vertex : vertices) {
+                packed.push_back(PackVertex(vertex));
+            }
+            glBufferData(GL_ARRAY_BUFFER, packed.size() * sizeof(PackedVertex), packed.data(), GL_STATIC_DRAW);
+        } else {
+            glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+        }
+
+        // Upload index data (16-bit halves index memory and fetch bandwidth;
+        // 65536 vertices still fit since primitive restart is not used)
+        bool shortIndices = indexFormat != IndexFormat::UInt32 && vertices.size() <= 65536;
+        if (indexFormat == IndexFormat::UInt16 && !shortIndices) {
+            LOG_WARNING("Mesh has " + std::to_string(vertices.size()) + " vertices, too many for 16-bit indices");
+        }
+        indexType = shortIndices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
 
-        // Upload index data
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+        if (shortIndices) {
+            std::vector<uint16_t> shortData(indices.begin(), indices.end());
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, shortData.size() * sizeof(uint16_t), shortData.data(), GL_STATIC_DRAW);
+        } else {
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+        }
 
         // Set vertex attribute pointers
+        if (vertexFormat == VertexFormat::Packed) {
+            SetupPackedAttributes();
+        } else {
+            SetupFloatAttributes();
+        }
 
+        // Unbind VAO
+        glBindVertexArray(0);
+
+        isSetup = true;
+        uploadedVertices = vertices.size();
+        uploadedIndices = indices.size();
+        LOG_CAT_DEBUG(Render, "Mesh setup complete: {} vertices, {} indices", vertices.size(), indices.size());
+
+        ApplyRetention();
+    }
+
+    void Mesh::ApplyRetention() {
+        if (retention == MeshRetention::Keep) return;
+
+        if (retention == MeshRetention::KeepCollision && collision.IsEmpty()) {
+            collision = BuildCollision(vertices, indices);
+        }
+
+        // swap() with empty vectors actually returns the memory (clear() keeps capacity)
+        std::vector<Vertex>().swap(vertices);
+        std::vector<unsigned int>().swap(indices);
+    }
+
+    CollisionMesh Mesh::BuildCollision(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
+        std::vector<glm::vec3> positions;
+        positions.reserve(vertices.size());
+        for (const auto& vertex : vertices) {
+            positions.push_back(vertex.position);
+        }
+        return CollisionMesh::Build(positions, indices);
+    }
+
+    size_t Mesh::GetCPUMemoryUsage() const {
+        return vertices.capacity() * sizeof(Vertex) + indices.capacity() * sizeof(unsigned int) +
+               collision.GetMemoryUsage();
+    }
+
+    void Mesh::SetupFloatAttributes() {
         // Position attribute (location = 0)
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
@@ -86,12 +181,171 @@ namespace VibeReaper {
         glEnableVertexAttribArray(2);
         glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
 
-        // Unbind VAO
-        glBindVertexArray(0);
+        // Texture array layer attribute (location = 3)
+        glEnableVertexAttribArray(3);
+        glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texLayer));
+    }
 
-        isSetup = true;
-        LOG_INFO("Mesh setup complete: " + std::to_string(vertices.size()) + " vertices, " + 
-                 std::to_string(indices.size()) + " indices");
+    void Mesh::SetupPackedAttributes() {
+        // Same locations as the float layout; the vertex fetch converts each
+        // format to float, so shaders read vec3/vec2/float either way
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, position));
+
+        // Signed normalized 10:10:10 (w unused)
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, normal));
+
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, texCoord));
+
+        // Integer layer converted to float (not normalized)
+        glEnableVertexAttribArray(3);
+        glVertexAttribPointer(3, 1, GL_UNSIGNED_SHORT, GL_FALSE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, texLayer));
+    }
+
+    size_t Mesh::GetVertexStride() const {
+        return vertexFormat == VertexFormat::Packed ? sizeof(PackedVertex) : sizeof(Vertex);
+    }
+
+    size_t Mesh::GetIndexBufferSize() const {
+        return static_cast<size_t>(GetIndexCount()) * (indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(unsigned int));
+    }
+
+    std::vector<Mesh> Mesh::SplitIntoChunks(const std::vector<Vertex>& vertices,
+                                            const std::vector<unsigned int>& indices,
+                                            size_t maxVertices) {
+        std::vector<Mesh> chunks;
+        if (maxVertices < 3) return chunks;
+
+        // remap[source vertex] = index in the current chunk, or -1
+        std::vector<int> remap(vertices.size(), -1);
+        std::vector<unsigned int> chunkSources;
+        Mesh chunk;
+
+        auto flush = [&]() {
+            if (chunk.indices.empty()) return;
+            for (unsigned int source : chunkSources) {
+                remap[source] = -1;
+            }
+            chunkSources.clear();
+            chunks.push_back(std::move(chunk));
+            chunk = Mesh();
+        };
+
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            // Start a new chunk if this triangle's new vertices would not fit
+            size_t added = 0;
+            for (size_t corner = 0; corner < 3; corner++) {
+                if (remap[indices[i + corner]] < 0) added++;
+            }
+            if (chunk.vertices.size() + added > maxVertices) {
+                flush();
+            }
+
+            for (size_t corner = 0; corner < 3; corner++) {
+                unsigned int source = indices[i + corner];
+                if (remap[source] < 0) {
+                    remap[source] = static_cast<int>(chunk.vertices.size());
+                    chunk.vertices.push_back(vertices[source]);
+                    chunkSources.push_back(source);
+                }
+                chunk.indices.push_back(static_cast<unsigned int>(remap[source]));
+            }
+        }
+        flush();
+
+        return chunks;
+    }
+
+    // ========================================================================
+    // Packed vertex encoding
+    // ========================================================================
+
+    PackedVertex Mesh::PackVertex(const Vertex& vertex) {
+        PackedVertex packed;
+        packed.position = vertex.position;
+        packed.normal = PackNormal(vertex.normal);
+        packed.texCoord[0] = FloatToHalf(vertex.texCoord.x);
+        packed.texCoord[1] = FloatToHalf(vertex.texCoord.y);
+        packed.texLayer = static_cast<uint16_t>(std::clamp(vertex.texLayer, 0.0f, 65535.0f) + 0.5f);
+        packed.padding = 0;
+        return packed;
+    }
+
+    uint32_t Mesh::PackNormal(const glm::vec3& normal) {
+        // x in bits 0-9, y in 10-19, z in 20-29 (two's complement, 511 = 1.0)
+        auto component = [](float value) -> uint32_t {
+            int scaled = static_cast<int>(std::round(std::clamp(value, -1.0f, 1.0f) * 511.0f));
+            return static_cast<uint32_t>(scaled) & 0x3FF;
+        };
+        return component(normal.x) | (component(normal.y) << 10) | (component(normal.z) << 20);
+    }
+
+    glm::vec3 Mesh::UnpackNormal(uint32_t packed) {
+        auto component = [](uint32_t bits) -> float {
+            int value = static_cast<int>(bits & 0x3FF);
+            if (value & 0x200) value -= 0x400;   // Sign extend
+            return std::max(static_cast<float>(value) / 511.0f, -1.0f);
+        };
+        return glm::vec3(component(packed), component(packed >> 10), component(packed >> 20));
+    }
+
+    uint16_t Mesh::FloatToHalf(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        uint32_t sign = (bits >> 16) & 0x8000;
+        int exponent = static_cast<int>((bits >> 23) & 0xFF) - 127 + 15;
+        uint32_t mantissa = bits & 0x7FFFFF;
+
+        if (exponent >= 31) {
+            // Overflow (and NaN/Inf) saturates to infinity
+            return static_cast<uint16_t>(sign | 0x7C00);
+        }
+        if (exponent <= 0) {
+            // Subnormal half or zero
+            if (exponent < -10) return static_cast<uint16_t>(sign);
+            mantissa |= 0x800000;
+            int shift = 14 - exponent;
+            uint32_t half = mantissa >> shift;
+            if ((mantissa >> (shift - 1)) & 1) half++;   // Round half up
+            return static_cast<uint16_t>(sign | half);
+        }
+
+        // Round to nearest; a mantissa carry correctly bumps the exponent
+        uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+        if (mantissa & 0x1000) half++;
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    float Mesh::HalfToFloat(uint16_t half) {
+        uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+        int exponent = (half >> 10) & 0x1F;
+        uint32_t mantissa = half & 0x3FF;
+
+        float magnitude;
+        if (exponent == 0) {
+            magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        } else if (exponent == 31) {
+            magnitude = mantissa ? NAN : INFINITY;
+        } else {
+            magnitude = std::ldexp(static_cast<float>(mantissa | 0x400), exponent - 25);
+        }
+        return sign ? -magnitude : magnitude;
+    }
+
+    bool Mesh::CanPack(const std::vector<Vertex>& vertices) {
+        const float MAX_TEXCOORD = 8.0f;
+        for (const auto& vertex : vertices) {
+            if (std::abs(vertex.texCoord.x) > MAX_TEXCOORD || std::abs(vertex.texCoord.y) > MAX_TEXCOORD) {
+                return false;
+            }
+            if (vertex.texLayer < 0.0f || vertex.texLayer > 65535.0f) {
+                return false;
+            }
+        }
+        return true;
     }
 
     void Mesh::Draw(Shader& shader) {
@@ -102,7 +356,48 @@ namespace VibeReaper {
 
         shader.Use();
         glBindVertexArray(VAO);
-        glDrawElements(GL_TRIANGLES, (GLsizei)indices.size(), GL_UNSIGNED_INT, 0);
+        glDrawElements(GL_TRIANGLES, GetIndexCount(), indexType, 0);
+        glBindVertexArray(0);
+    }
+
+    void Mesh::AttachInstanceBuffer(const InstanceBuffer& instances) {
+        if (!isSetup || instances.GetBuffer() == 0) {
+            LOG_ERROR("Mesh::AttachInstanceBuffer() needs a set up mesh and a created instance buffer");
+            return;
+        }
+
+        glBindVertexArray(VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, instances.GetBuffer());
+
+        // Model matrix (locations 4-7, one vec4 column each), advanced once per instance
+        for (GLuint column = 0; column < 4; column++) {
+            GLuint location = InstanceBuffer::MODEL_LOCATION + column;
+            glEnableVertexAttribArray(location);
+            glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+                                  (void*)(offsetof(InstanceData, model) + sizeof(glm::vec4) * column));
+            glVertexAttribDivisor(location, 1);
+        }
+
+        // Color (location 8)
+        glEnableVertexAttribArray(InstanceBuffer::COLOR_LOCATION);
+        glVertexAttribPointer(InstanceBuffer::COLOR_LOCATION, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+                              (void*)offsetof(InstanceData, color));
+        glVertexAttribDivisor(InstanceBuffer::COLOR_LOCATION, 1);
+
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void Mesh::DrawInstanced(Shader& shader, GLsizei count) {
+        if (!isSetup) {
+            LOG_ERROR("Mesh::DrawInstanced() called before SetupMesh()");
+            return;
+        }
+        if (count <= 0) return;
+
+        shader.Use();
+        glBindVertexArray(VAO);
+        glDrawElementsInstanced(GL_TRIANGLES, GetIndexCount(), indexType, 0, count);
         glBindVertexArray(0);
     }
 
@@ -176,7 +471,7 @@ namespace VibeReaper {
 
         Mesh cube(vertices, indices);
         cube.SetupMesh();
-        LOG_INFO("Procedural cube generated: 24 vertices, 36 indices");
+        LOG_CAT_DEBUG(Render, "Procedural cube generated: 24 vertices, 36 indices");
         return cube;
     }
 
@@ -225,8 +520,7 @@ namespace VibeReaper {
 
         Mesh sphere(vertices, indices);
         sphere.SetupMesh();
-        LOG_INFO("Procedural sphere generated: " + std::to_string(vertices.size()) + " vertices, " + 
-                 std::to_string(indices.size()) + " indices");
+        LOG_CAT_DEBUG(Render, "Procedural sphere generated: {} vertices, {} indices", vertices.size(), indices.size());
         return sphere;
     }
 
@@ -249,7 +543,7 @@ namespace VibeReaper {
 
         Mesh plane(vertices, indices);
         plane.SetupMesh();
-        LOG_INFO("Procedural plane generated: 4 vertices, 6 indices");
+        LOG_CAT_DEBUG(Render, "Procedural plane generated: 4 vertices, 6 indices");
         return plane;
     }
 
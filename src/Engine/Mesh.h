@@ -3,7 +3,12 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
 #include "Shader.h"
+#include "InstanceBuffer.h"
+#include "Collision.h"
 
 namespace VibeReaper {
 
@@ -12,10 +17,41 @@ namespace VibeReaper {
         glm::vec3 position;
         glm::vec3 normal;
         glm::vec2 texCoord;
+        float texLayer;     // Material array layer (0 for non-array textures)
 
-        Vertex() : position(0.0f), normal(0.0f), texCoord(0.0f) {}
-        Vertex(glm::vec3 pos, glm::vec3 norm, glm::vec2 uv)
-            : position(pos), normal(norm), texCoord(uv) {}
+        Vertex() : position(0.0f), normal(0.0f), texCoord(0.0f), texLayer(0.0f) {}
+        Vertex(glm::vec3 pos, glm::vec3 norm, glm::vec2 uv, float layer = 0.0f)
+            : position(pos), normal(norm), texCoord(uv), texLayer(layer) {}
+    };
+
+    // GPU vertex layout, chosen per mesh before SetupMesh()
+    enum class VertexFormat : uint8_t {
+        Float,      // Vertex as is (36 bytes)
+        Packed      // PackedVertex (24 bytes), decoded by the vertex fetch
+    };
+
+    // GPU index width, chosen per mesh before SetupMesh()
+    enum class IndexFormat : uint8_t {
+        Auto,       // 16-bit when every index fits, else 32-bit
+        UInt16,     // Falls back to 32-bit for meshes with more than 65536 vertices
+        UInt32
+    };
+
+    // What SetupMesh() keeps of the CPU-side vertices/indices after uploading them
+    enum class MeshRetention : uint8_t {
+        Keep,           // Leave vertices/indices as they are (procedural/editable meshes)
+        Release,        // Free them; the mesh can only be drawn afterwards
+        KeepCollision   // Free them but keep a welded CollisionMesh (narrow-phase collision)
+    };
+
+    // Compact vertex for static geometry: position stays float, the normal is
+    // 10:10:10:2 signed normalized, UVs are half floats and the layer a uint16
+    struct PackedVertex {
+        glm::vec3 position;
+        uint32_t normal;        // GL_INT_2_10_10_10_REV
+        uint16_t texCoord[2];   // GL_HALF_FLOAT
+        uint16_t texLayer;
+        uint16_t padding;       // Keeps the stride 4-byte aligned
     };
 
     class Mesh {
@@ -27,6 +63,7 @@ namespace VibeReaper {
         // Constructor
         Mesh();
         Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+        Mesh(std::vector<Vertex>&& vertices, std::vector<unsigned int>&& indices);
         
         // Move semantics
         Mesh(Mesh&& other) noexcept;
@@ -38,21 +75,87 @@ namespace VibeReaper {
 
         ~Mesh();
 
+        // Vertex layout used by the next SetupMesh(). Packed falls back to Float
+        // for meshes whose UVs would lose precision as half floats.
+        void SetVertexFormat(VertexFormat format) { vertexFormat = format; }
+        VertexFormat GetVertexFormat() const { return vertexFormat; }
+
+        void SetIndexFormat(IndexFormat format) { indexFormat = format; }
+
+        // CPU data kept after the next SetupMesh() (default Keep)
+        void SetRetention(MeshRetention policy) { retention = policy; }
+        MeshRetention GetRetention() const { return retention; }
+
         // Setup mesh buffers on GPU
         void SetupMesh();
 
+        // Bytes one vertex takes on the GPU in the current format
+        size_t GetVertexStride() const;
+        size_t GetVertexBufferSize() const { return GetVertexCount() * GetVertexStride(); }
+
+        // Counts survive SetupMesh() releasing the CPU copies
+        size_t GetVertexCount() const { return isSetup ? uploadedVertices : vertices.size(); }
+
+        // GL_UNSIGNED_SHORT or GL_UNSIGNED_INT, as uploaded by SetupMesh()
+        GLenum GetIndexType() const { return indexType; }
+        size_t GetIndexBufferSize() const;
+
         // Draw the mesh
         void Draw(Shader& shader);
 
+        // Instancing: bind per-instance attributes from a buffer into this mesh's VAO
+        // (after SetupMesh), then draw count instances in one call
+        void AttachInstanceBuffer(const InstanceBuffer& instances);
+        void DrawInstanced(Shader& shader, GLsizei count);
+
+        // GPU handles for queued draws (see RenderQueue)
+        unsigned int GetVAO() const { return VAO; }
+        GLsizei GetIndexCount() const { return static_cast<GLsizei>(isSetup ? uploadedIndices : indices.size()); }
+        bool IsSetup() const { return isSetup; }
+
+        // Collision copy built by SetupMesh() under MeshRetention::KeepCollision
+        const CollisionMesh& GetCollision() const { return collision; }
+        // Supply it ready-made (e.g. built on a worker thread); SetupMesh() then keeps it
+        void SetCollision(CollisionMesh mesh) { collision = std::move(mesh); }
+        static CollisionMesh BuildCollision(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+
+        // Bytes held in RAM (vertices/indices plus the collision copy)
+        size_t GetCPUMemoryUsage() const;
+
         // Procedural geometry generators
         static Mesh GenerateCube();
         static Mesh GenerateSphere(int subdivisions = 2);
         static Mesh GeneratePlane(float width = 10.0f, float depth = 10.0f);
 
+        // Packed vertex encoding (exposed for tests and tools)
+        static PackedVertex PackVertex(const Vertex& vertex);
+        static uint32_t PackNormal(const glm::vec3& normal);
+        static glm::vec3 UnpackNormal(uint32_t packed);
+        static uint16_t FloatToHalf(float value);
+        static float HalfToFloat(uint16_t half);
+        static bool CanPack(const std::vector<Vertex>& vertices);
+
+        // Split merged geometry into meshes of at most maxVertices vertices (whole
+        // triangles, re-indexed per chunk), so each chunk can use 16-bit indices
+        static std::vector<Mesh> SplitIntoChunks(const std::vector<Vertex>& vertices,
+                                                 const std::vector<unsigned int>& indices,
+                                                 size_t maxVertices = 65536);
+
     private:
         // OpenGL buffer objects
         unsigned int VAO, VBO, EBO;
         bool isSetup;
+        VertexFormat vertexFormat;
+        IndexFormat indexFormat;
+        GLenum indexType;
+        MeshRetention retention;
+        size_t uploadedVertices, uploadedIndices;
+        CollisionMesh collision;
+
+        void ApplyRetention();
+
+        void SetupFloatAttributes();
+        void SetupPackedAttributes();
 
         // Cleanup
         void Cleanup();
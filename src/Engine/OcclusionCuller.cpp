@@ -0,0 +1,183 @@
+#include "OcclusionCuller.h"
+#include "../Utils/Logger.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <tuple>
+
+namespace VibeReaper {
+
+    namespace {
+        // Query boxes are drawn slightly enlarged so geometry on the cluster edge can't hide them
+        const float BOX_MARGIN = 2.0f;
+
+        // Within this distance of a cluster the box may clip the near plane; draw without testing
+        const float CAMERA_MARGIN = 16.0f;
+    }
+
+    OcclusionCuller::OcclusionCuller()
+        : cameraPosition(0.0f), frame(0), activeQuery(-1) {
+    }
+
+    OcclusionCuller::~OcclusionCuller() {
+        Clear();
+    }
+
+    void OcclusionCuller::Build(const std::vector<AABB>& objectBounds, float clusterSize) {
+        Clear();
+
+        std::map<std::tuple<int, int, int>, int> cells;
+        objectClusters.resize(objectBounds.size());
+        for (size_t i = 0; i < objectBounds.size(); i++) {
+            glm::vec3 center = objectBounds[i].GetCenter();
+            auto key = std::make_tuple(static_cast<int>(std::floor(center.x / clusterSize)),
+                                       static_cast<int>(std::floor(center.y / clusterSize)),
+                                       static_cast<int>(std::floor(center.z / clusterSize)));
+
+            auto it = cells.find(key);
+            if (it == cells.end()) {
+                it = cells.emplace(key, static_cast<int>(clusters.size())).first;
+                Cluster cluster;
+                cluster.bounds = objectBounds[i];
+                clusters.push_back(cluster);
+            } else {
+                AABB& bounds = clusters[it->second].bounds;
+                bounds.Expand(objectBounds[i].min);
+                bounds.Expand(objectBounds[i].max);
+            }
+            objectClusters[i] = it->second;
+        }
+
+        LOG_INFO("Occlusion: " + std::to_string(objectBounds.size()) + " objects in " +
+                 std::to_string(clusters.size()) + " clusters");
+    }
+
+    void OcclusionCuller::Clear() {
+        for (auto& cluster : clusters) {
+            if (cluster.query != 0) {
+                glDeleteQueries(1, &cluster.query);
+            }
+        }
+        clusters.clear();
+        objectClusters.clear();
+        hiddenClusters.clear();
+        activeQuery = -1;
+        stats = OcclusionStats();
+    }
+
+    void OcclusionCuller::BeginFrame(const glm::vec3& position) {
+        auto start = std::chrono::steady_clock::now();
+        frame++;
+        cameraPosition = position;
+        hiddenClusters.clear();
+        stats = OcclusionStats();
+
+        // Non-blocking readback: a result that isn't ready yet is simply used next frame
+        uint32_t latencyTotal = 0;
+        int results = 0;
+        for (auto& cluster : clusters) {
+            if (!cluster.queryPending) continue;
+
+            GLuint available = 0;
+            glGetQueryObjectuiv(cluster.query, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) {
+                stats.queriesPending++;
+                continue;
+            }
+
+            GLuint samplesPassed = 0;
+            glGetQueryObjectuiv(cluster.query, GL_QUERY_RESULT, &samplesPassed);
+            cluster.visible = samplesPassed != 0;
+            cluster.queryPending = false;
+            latencyTotal += frame - cluster.queryFrame;
+            results++;
+        }
+
+        stats.averageLatencyFrames = results > 0 ? static_cast<float>(latencyTotal) / results : 0.0f;
+        stats.pollMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    bool OcclusionCuller::ShouldDraw(int index, int objectCount) {
+        Cluster& cluster = clusters[index];
+        stats.clusters++;
+
+        // A result from before the cluster left the view says nothing about now
+        bool wasInView = cluster.lastInViewFrame + 1 == frame;
+        cluster.lastInViewFrame = frame;
+
+        AABB nearBounds(cluster.bounds.min - glm::vec3(CAMERA_MARGIN), cluster.bounds.max + glm::vec3(CAMERA_MARGIN));
+        cluster.containsCamera = nearBounds.Contains(cameraPosition);
+
+        if (!wasInView || cluster.containsCamera || cluster.visible) {
+            if (!wasInView || cluster.containsCamera) {
+                cluster.visible = true;
+            }
+            return true;
+        }
+
+        hiddenClusters.push_back(index);
+        stats.clustersCulled++;
+        stats.objectsCulled += objectCount;
+        return false;
+    }
+
+    void OcclusionCuller::BeginQuery(int index) {
+        Cluster& cluster = clusters[index];
+        if (cluster.queryPending || cluster.containsCamera) {
+            return;
+        }
+        IssueQuery(cluster);
+        activeQuery = index;
+    }
+
+    void OcclusionCuller::EndQuery(int index) {
+        if (activeQuery == index) {
+            glEndQuery(GL_ANY_SAMPLES_PASSED);
+            activeQuery = -1;
+        }
+    }
+
+    void OcclusionCuller::QueryHidden(Shader& shader) {
+        if (hiddenClusters.empty()) return;
+
+        if (!boxMesh.IsSetup()) {
+            boxMesh = Mesh::GenerateCube();
+            boxMesh.SetupMesh();
+        }
+
+        // Depth test only: the boxes must not show up or occlude anything
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        glDepthMask(GL_FALSE);
+
+        for (int index : hiddenClusters) {
+            Cluster& cluster = clusters[index];
+            if (cluster.queryPending) continue;
+
+            glm::vec3 size = cluster.bounds.GetSize() + glm::vec3(BOX_MARGIN * 2.0f);
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), cluster.bounds.GetCenter());
+            model = glm::scale(model, size);
+            shader.SetMat4("uModel", model);
+
+            IssueQuery(cluster);
+            boxMesh.Draw(shader);
+            glEndQuery(GL_ANY_SAMPLES_PASSED);
+        }
+
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glDepthMask(GL_TRUE);
+        shader.SetMat4("uModel", glm::mat4(1.0f));
+        hiddenClusters.clear();
+    }
+
+    void OcclusionCuller::IssueQuery(Cluster& cluster) {
+        if (cluster.query == 0) {
+            glGenQueries(1, &cluster.query);
+        }
+        glBeginQuery(GL_ANY_SAMPLES_PASSED, cluster.query);
+        cluster.queryPending = true;
+        cluster.queryFrame = frame;
+        stats.queriesIssued++;
+    }
+
+} // namespace VibeReaper
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Collision.h"
+#include "Mesh.h"
+#include "Shader.h"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+
+namespace VibeReaper {
+
+    // Per-frame occlusion query counters
+    struct OcclusionStats {
+        int clusters = 0;               // Clusters in view this frame
+        int queriesIssued = 0;
+        int clustersCulled = 0;         // Skipped because their last query found no samples
+        int objectsCulled = 0;
+        int queriesPending = 0;         // Still in flight at the start of the frame
+        float averageLatencyFrames = 0.0f;  // Issue -> result available, for results read this frame
+        double pollMs = 0.0;
+    };
+
+    /**
+     * @brief Hardware occlusion queries over clusters of world objects
+     *
+     * Objects are grouped into clusters on a coarse grid. Each frame, clusters
+     * use the result of their last query instead of waiting on the GPU
+     * (coherent hierarchical culling): visible clusters are drawn with their
+     * draw calls wrapped in a query, hidden clusters are skipped and re-tested
+     * with a bounding box after the rest of the frame is drawn. Clusters that
+     * just entered the view, or contain the camera, are always drawn, so a
+     * hidden cluster that becomes visible can appear one frame late but nothing
+     * in plain sight is ever dropped.
+     *
+     * All per-frame methods must be called from the GL thread.
+     */
+    class OcclusionCuller {
+    public:
+        static constexpr float DEFAULT_CLUSTER_SIZE = 512.0f;
+
+        OcclusionCuller();
+        ~OcclusionCuller();
+
+        OcclusionCuller(const OcclusionCuller&) = delete;
+        OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+        // Group objects (by bounds center) into clusters; no GL calls
+        void Build(const std::vector<AABB>& objectBounds, float clusterSize = DEFAULT_CLUSTER_SIZE);
+
+        // Release queries and clusters
+        void Clear();
+
+        // Read back finished queries (never blocks)
+        void BeginFrame(const glm::vec3& cameraPosition);
+
+        // Whether a cluster in view should be drawn; hidden ones are queued for a box test
+        bool ShouldDraw(int cluster, int objectCount);
+
+        // Wrap a drawn cluster's draw calls (skipped while its previous query is in flight)
+        void BeginQuery(int cluster);
+        void EndQuery(int cluster);
+
+        // Box-test the clusters skipped this frame (call after all visible geometry is drawn).
+        // Leaves uModel set to identity.
+        void QueryHidden(Shader& shader);
+
+        int GetObjectCluster(uint32_t objectIndex) const { return objectClusters[objectIndex]; }
+        const AABB& GetClusterBounds(int cluster) const { return clusters[cluster].bounds; }
+        int GetClusterCount() const { return static_cast<int>(clusters.size()); }
+        bool IsBuilt() const { return !clusters.empty(); }
+        const OcclusionStats& GetStats() const { return stats; }
+
+    private:
+        struct Cluster {
+            AABB bounds;
+            GLuint query = 0;
+            uint32_t queryFrame = 0;        // Frame the in-flight query was issued
+            uint32_t lastInViewFrame = 0;
+            bool queryPending = false;
+            bool visible = true;            // Last query result
+            bool containsCamera = false;    // This frame
+        };
+
+        std::vector<Cluster> clusters;
+        std::vector<int> objectClusters;
+        std::vector<int> hiddenClusters;
+        Mesh boxMesh;
+        glm::vec3 cameraPosition;
+        uint32_t frame;
+        int activeQuery;
+        OcclusionStats stats;
+
+        void IssueQuery(Cluster& cluster);
+    };
+
+} // namespace VibeReaper
@@ -0,0 +1,283 @@
+#include "RegionStreamer.h"
+#include "../Utils/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <utility>
+
+namespace VibeReaper {
+
+    namespace {
+        const size_t BOUNDS_GRAIN = 64;
+
+        // Same tolerance BrushConverter::BuildFace() uses to put a corner on a face
+        const float FACE_EPSILON = 0.01f;
+
+        float DistanceToBounds(const glm::vec3& point, const AABB& bounds) {
+            glm::vec3 outside = glm::max(glm::max(bounds.min - point, point - bounds.max), glm::vec3(0.0f));
+            return glm::length(outside);
+        }
+
+        // What ConvertBrush() will produce: a face with k corners fans into k - 2
+        // triangles of unshared vertices and sequential indices, and the collision
+        // copy welds down to at most the brush's corners
+        size_t EstimateBrushBytes(const Brush& brush, const std::vector<glm::vec3>& corners, bool collision) {
+            size_t triangles = 0;
+            for (const Plane& plane : brush.planes) {
+                size_t onFace = 0;
+                for (const glm::vec3& corner : corners) {
+                    if (std::abs(glm::dot(plane.normal, corner) - plane.distance) < FACE_EPSILON) onFace++;
+                }
+                if (onFace >= 3) triangles += onFace - 2;
+            }
+
+            size_t bytes = triangles * 3 * (sizeof(Vertex) + sizeof(unsigned int));
+            if (collision) {
+                bytes += corners.size() * sizeof(glm::vec3) + triangles * 3 * sizeof(unsigned int);
+            }
+            return bytes;
+        }
+
+        size_t GetGeometryBytes(const BrushGeometry& geometry) {
+            return geometry.vertices.size() * sizeof(Vertex) + geometry.indices.size() * sizeof(unsigned int) +
+                   geometry.collision.GetMemoryUsage();
+        }
+    }
+
+    RegionStreamer::RegionStreamer(JobSystem& jobs) : jobs(jobs), buildCollision(false) {}
+
+    RegionStreamer::~RegionStreamer() {
+        Clear();
+    }
+
+    void RegionStreamer::Build(std::vector<Brush> sourceBrushes, const StreamingSettings& streamingSettings,
+                               bool collision) {
+        Clear();
+        settings = streamingSettings;
+        buildCollision = collision;
+        brushes = std::move(sourceBrushes);
+
+        // Corners only (plane triple intersections): far cheaper than building faces
+        std::vector<AABB> brushBounds(brushes.size());
+        std::vector<size_t> brushBytes(brushes.size(), 0);
+        std::vector<uint8_t> hasBounds(brushes.size(), 0);
+        jobs.ParallelFor(brushes.size(), BOUNDS_GRAIN, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                std::vector<glm::vec3> corners = BrushConverter::CalculateVertices(brushes[i].planes);
+                if (corners.empty()) continue;
+                AABB bounds(corners[0], corners[0]);
+                for (const glm::vec3& corner : corners) {
+                    bounds.Expand(corner);
+                }
+                brushBounds[i] = bounds;
+                brushBytes[i] = EstimateBrushBytes(brushes[i], corners, buildCollision);
+                hasBounds[i] = 1;
+            }
+        });
+
+        // Each brush joins the X/Z cell holding its center
+        std::map<std::pair<int, int>, uint32_t> cells;
+        for (size_t i = 0; i < brushes.size(); i++) {
+            if (!hasBounds[i]) continue;
+
+            glm::vec3 center = brushBounds[i].GetCenter();
+            std::pair<int, int> cell(static_cast<int>(std::floor(center.x / settings.regionSize)),
+                                     static_cast<int>(std::floor(center.z / settings.regionSize)));
+            auto it = cells.find(cell);
+            if (it == cells.end()) {
+                it = cells.emplace(cell, static_cast<uint32_t>(regions.size())).first;
+                regions.push_back(std::make_unique<Region>());
+                regions.back()->bounds = brushBounds[i];
+            }
+
+            Region& region = *regions[it->second];
+            region.brushes.push_back(static_cast<uint32_t>(i));
+            region.bounds.Expand(brushBounds[i].min);
+            region.bounds.Expand(brushBounds[i].max);
+            region.estimatedBytes += brushBytes[i];
+        }
+
+        stats.regions = regions.size();
+        LOG_CAT_INFO(Map, "Streaming {} brushes in {} regions ({} unit grid, load {} / unload {}, budget {} MB)",
+                     brushes.size(), regions.size(), settings.regionSize, settings.loadRadius, settings.unloadRadius,
+                     settings.memoryBudget / (1024 * 1024));
+    }
+
+    void RegionStreamer::Clear() {
+        // Workers write into regions and read brushes; both must outlive them
+        for (auto& region : regions) {
+            if (region->state == RegionState::Loading) {
+                jobs.Wait(region->counter);
+            }
+        }
+        regions.clear();
+        brushes.clear();
+        order.clear();
+        stats = StreamingStats();
+    }
+
+    void RegionStreamer::Update(const glm::vec3& position, const LoadedCallback& onLoaded,
+                                const UnloadedCallback& onUnloaded) {
+        auto start = std::chrono::steady_clock::now();
+
+        for (auto& region : regions) {
+            region->distance = DistanceToBounds(position, region->bounds);
+        }
+
+        FinishLoads(onLoaded, onUnloaded);
+
+        for (uint32_t i = 0; i < regions.size(); i++) {
+            Region& region = *regions[i];
+            if (region.state == RegionState::Resident && region.distance > settings.unloadRadius) {
+                Unload(region, i, onUnloaded);
+            }
+        }
+
+        StartLoads(onUnloaded);
+
+        stats.resident = 0;
+        stats.loading = 0;
+        for (const auto& region : regions) {
+            if (region->state == RegionState::Resident) stats.resident++;
+            if (region->state == RegionState::Loading) stats.loading++;
+        }
+        stats.peakBytes = std::max(stats.peakBytes, stats.residentBytes + stats.inFlightBytes);
+        stats.lastUpdateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        stats.maxUpdateMs = std::max(stats.maxUpdateMs, stats.lastUpdateMs);
+    }
+
+    void RegionStreamer::FinishLoads(const LoadedCallback& onLoaded, const UnloadedCallback& onUnloaded) {
+        order.clear();
+        for (uint32_t i = 0; i < regions.size(); i++) {
+            if (regions[i]->state == RegionState::Loading && regions[i]->counter.IsDone()) {
+                order.push_back(i);
+            }
+        }
+        std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+            return regions[a]->distance < regions[b]->distance;
+        });
+
+        // Nearest first; the rest wait for the next frame so one Update() never uploads a burst
+        int uploads = 0;
+        for (uint32_t index : order) {
+            Region& region = *regions[index];
+            bool discard = region.distance > settings.unloadRadius;
+            if (!discard && uploads >= settings.maxUploadsPerFrame) continue;
+
+            // Returns at once; also syncs with the worker that may still hold the counter's lock
+            jobs.Wait(region.counter);
+            stats.inFlightBytes -= region.estimatedBytes;
+            if (discard) {
+                std::vector<BrushGeometry>().swap(region.geometry);
+                region.state = RegionState::Unloaded;
+                stats.discarded++;
+                continue;
+            }
+
+            // The estimate can still be short (vector capacity, fewer welded corners than
+            // expected), so the budget is checked again with the real size before upload.
+            // Without room the region keeps its geometry, counted in flight, and retries.
+            size_t actualBytes = 0;
+            for (const BrushGeometry& geometry : region.geometry) {
+                actualBytes += GetGeometryBytes(geometry);
+            }
+            if (!MakeRoom(actualBytes, region.distance, onUnloaded)) {
+                region.estimatedBytes = actualBytes;
+                stats.inFlightBytes += actualBytes;
+                stats.budgetDeferrals++;
+                continue;
+            }
+
+            // Exact bounds now that the geometry exists
+            bool first = true;
+            region.residentBytes = actualBytes;
+            for (const BrushGeometry& geometry : region.geometry) {
+                if (geometry.vertices.empty()) continue;
+                if (first) {
+                    region.bounds = geometry.bounds;
+                    first = false;
+                } else {
+                    region.bounds.Expand(geometry.bounds.min);
+                    region.bounds.Expand(geometry.bounds.max);
+                }
+            }
+
+            region.state = RegionState::Resident;
+            stats.residentBytes += region.residentBytes;
+            stats.loads++;
+            onLoaded(index, region.geometry);
+            std::vector<BrushGeometry>().swap(region.geometry);
+            uploads++;
+        }
+        stats.lastUploads = static_cast<size_t>(uploads);
+    }
+
+    void RegionStreamer::StartLoads(const UnloadedCallback& onUnloaded) {
+        int inFlight = 0;
+        order.clear();
+        for (uint32_t i = 0; i < regions.size(); i++) {
+            const Region& region = *regions[i];
+            if (region.state == RegionState::Loading) {
+                inFlight++;
+            } else if (region.state == RegionState::Unloaded && region.distance <= settings.loadRadius) {
+                order.push_back(i);
+            }
+        }
+        std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+            return regions[a]->distance < regions[b]->distance;
+        });
+
+        for (uint32_t index : order) {
+            if (inFlight >= settings.maxLoadsInFlight) break;
+
+            Region& region = *regions[index];
+            if (!MakeRoom(region.estimatedBytes, region.distance, onUnloaded)) {
+                stats.budgetDeferrals++;
+                break;
+            }
+
+            region.state = RegionState::Loading;
+            stats.inFlightBytes += region.estimatedBytes;
+            inFlight++;
+
+            Region* target = &region;
+            jobs.Run([this, target]() {
+                target->geometry.reserve(target->brushes.size());
+                for (uint32_t brush : target->brushes) {
+                    target->geometry.push_back(BrushConverter::ConvertBrush(brushes[brush], nullptr, buildCollision));
+                }
+            }, &region.counter);
+        }
+    }
+
+    bool RegionStreamer::MakeRoom(size_t bytes, float candidateDistance, const UnloadedCallback& onUnloaded) {
+        while (stats.residentBytes + stats.inFlightBytes + bytes > settings.memoryBudget) {
+            // Only regions already outside loadRadius (kept by hysteresis) and farther
+            // than the candidate give way, farthest first
+            uint32_t victim = UINT32_MAX;
+            for (uint32_t i = 0; i < regions.size(); i++) {
+                const Region& region = *regions[i];
+                if (region.state != RegionState::Resident || region.distance <= settings.loadRadius ||
+                    region.distance <= candidateDistance) {
+                    continue;
+                }
+                if (victim == UINT32_MAX || region.distance > regions[victim]->distance) {
+                    victim = i;
+                }
+            }
+            if (victim == UINT32_MAX) return false;
+            Unload(*regions[victim], victim, onUnloaded);
+        }
+        return true;
+    }
+
+    void RegionStreamer::Unload(Region& region, uint32_t index, const UnloadedCallback& onUnloaded) {
+        stats.residentBytes -= region.residentBytes;
+        region.residentBytes = 0;
+        region.state = RegionState::Unloaded;
+        stats.unloads++;
+        onUnloaded(index);
+    }
+
+} // namespace VibeReaper
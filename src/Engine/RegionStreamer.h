@@ -0,0 +1,115 @@
+#pragma once
+
+#include "BrushConverter.h"
+#include "JobSystem.h"
+#include "Collision.h"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace VibeReaper {
+
+    struct StreamingSettings {
+        float regionSize = 2048.0f;         // Grid cell edge on X/Z, map units (32 m)
+        float loadRadius = 4096.0f;         // Regions nearer than this are loaded...
+        float unloadRadius = 6144.0f;       // ...and only dropped beyond this (hysteresis)
+        size_t memoryBudget = 96u * 1024u * 1024u;  // Resident plus in-flight region bytes
+        int maxLoadsInFlight = 2;           // Regions converting on workers at once
+        int maxUploadsPerFrame = 1;         // Converted regions handed to the owner per Update()
+    };
+
+    struct StreamingStats {
+        size_t regions = 0;
+        size_t resident = 0;
+        size_t loading = 0;
+        size_t residentBytes = 0;
+        size_t inFlightBytes = 0;           // Regions converting (estimates) or converted but not uploaded
+        size_t peakBytes = 0;               // Highest resident + in-flight total seen
+        size_t loads = 0;                   // Regions made resident
+        size_t unloads = 0;
+        size_t discarded = 0;               // Finished converting after the viewer left
+        size_t budgetDeferrals = 0;         // Loads or uploads postponed because of the memory budget
+        size_t lastUploads = 0;             // Regions handed to onLoaded by the last Update()
+        double lastUpdateMs = 0.0;          // Update() on the calling thread, callbacks included
+        double maxUpdateMs = 0.0;
+    };
+
+    enum class RegionState : uint8_t { Unloaded, Loading, Resident };
+
+    /**
+     * @brief Splits level brushes into grid regions and streams them around a viewer
+     *
+     * Regions are X/Z grid cells (engine space, Y-up); each brush belongs to the
+     * cell holding its center. Update() starts background conversion (JobSystem)
+     * for unloaded regions within loadRadius, nearest first, and hands finished
+     * geometry to onLoaded on the calling thread, so the owner does the GL work.
+     * Resident regions beyond unloadRadius go to onUnloaded. When a load would
+     * exceed the memory budget, resident regions in the hysteresis band farther
+     * away are evicted first; if that is not enough the load waits. Loads start on
+     * an estimate from each brush's triangle count, and the real size is checked
+     * the same way before the geometry is handed over. Only CPU-side geometry is
+     * counted; GPU buffers and textures are the owner's.
+     *
+     * No GL calls, so the streaming policy is testable without a context.
+     */
+    class RegionStreamer {
+    public:
+        using LoadedCallback = std::function<void(uint32_t region, std::vector<BrushGeometry>& geometry)>;
+        using UnloadedCallback = std::function<void(uint32_t region)>;
+
+        explicit RegionStreamer(JobSystem& jobs);
+        ~RegionStreamer();
+
+        RegionStreamer(const RegionStreamer&) = delete;
+        RegionStreamer& operator=(const RegionStreamer&) = delete;
+
+        // Partition brushes (engine space) into regions; nothing is converted yet.
+        // Brush bounds come from plane intersections only, computed in parallel.
+        void Build(std::vector<Brush> brushes, const StreamingSettings& settings, bool buildCollision);
+
+        // Waits for in-flight conversions, then drops everything (no callbacks)
+        void Clear();
+
+        // Stream around position; callbacks run on this thread before it returns
+        void Update(const glm::vec3& position, const LoadedCallback& onLoaded, const UnloadedCallback& onUnloaded);
+
+        // Brush index of a region's geometry[i] passed to onLoaded
+        const std::vector<uint32_t>& GetRegionBrushes(uint32_t region) const { return regions[region]->brushes; }
+        const Brush& GetBrush(uint32_t index) const { return brushes[index]; }
+        const AABB& GetRegionBounds(uint32_t region) const { return regions[region]->bounds; }
+        RegionState GetRegionState(uint32_t region) const { return regions[region]->state; }
+        size_t GetRegionCount() const { return regions.size(); }
+
+        const StreamingSettings& GetSettings() const { return settings; }
+        const StreamingStats& GetStats() const { return stats; }
+
+    private:
+        struct Region {
+            AABB bounds;                        // Brush corners; exact geometry bounds once loaded
+            std::vector<uint32_t> brushes;
+            RegionState state = RegionState::Unloaded;
+            size_t estimatedBytes = 0;          // Before conversion, from triangle counts
+            size_t residentBytes = 0;
+            float distance = 0.0f;              // To the viewer, refreshed each Update()
+            std::vector<BrushGeometry> geometry;    // Written by the worker while Loading
+            JobCounter counter;
+        };
+
+        void FinishLoads(const LoadedCallback& onLoaded, const UnloadedCallback& onUnloaded);
+        void StartLoads(const UnloadedCallback& onUnloaded);
+        bool MakeRoom(size_t bytes, float candidateDistance, const UnloadedCallback& onUnloaded);
+        void Unload(Region& region, uint32_t index, const UnloadedCallback& onUnloaded);
+
+        JobSystem& jobs;
+        StreamingSettings settings;
+        bool buildCollision;
+        std::vector<Brush> brushes;
+        std::vector<std::unique_ptr<Region>> regions;
+        std::vector<uint32_t> order;            // Scratch: regions sorted by distance
+        StreamingStats stats;
+    };
+
+} // namespace VibeReaper
@@ -0,0 +1,281 @@
+#include "RenderQueue.h"
+#include "../Utils/Logger.h"
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace VibeReaper {
+
+    // ========================================================================
+    // GLStateCache
+    // ========================================================================
+
+    GLStateCache::GLStateCache() {
+        Invalidate();
+    }
+
+    void GLStateCache::Invalidate() {
+        // ~0 never matches a real name, so the next bind of each kind goes through
+        program = ~0u;
+        vertexArray = ~0u;
+        activeUnit = -1;
+        for (int i = 0; i < MAX_TEXTURE_UNITS; i++) {
+            textures[i] = ~0u;
+            textureTargets[i] = 0;
+        }
+        uniforms.clear();
+    }
+
+    void GLStateCache::ResetCounters() {
+        requested = StateCounters();
+        issued = StateCounters();
+    }
+
+    void GLStateCache::UseProgram(GLuint newProgram) {
+        requested.programs++;
+        if (newProgram == program) return;
+
+        glUseProgram(newProgram);
+        program = newProgram;
+        issued.programs++;
+    }
+
+    void GLStateCache::BindVertexArray(GLuint vao) {
+        requested.vertexArrays++;
+        if (vao == vertexArray) return;
+
+        glBindVertexArray(vao);
+        vertexArray = vao;
+        issued.vertexArrays++;
+    }
+
+    void GLStateCache::BindTexture(int unit, GLenum target, GLuint texture) {
+        requested.textures++;
+        if (unit >= 0 && unit < MAX_TEXTURE_UNITS && textures[unit] == texture && textureTargets[unit] == target) {
+            return;
+        }
+
+        if (unit != activeUnit) {
+            glActiveTexture(GL_TEXTURE0 + unit);
+            activeUnit = unit;
+        }
+        glBindTexture(target, texture);
+        issued.textures++;
+
+        if (unit >= 0 && unit < MAX_TEXTURE_UNITS) {
+            textures[unit] = texture;
+            textureTargets[unit] = target;
+        }
+    }
+
+    bool GLStateCache::UniformChanged(GLint location, const float* data, int count) {
+        requested.uniforms++;
+
+        std::vector<float>& cached = uniforms[std::make_pair(program, location)];
+        if (static_cast<int>(cached.size()) == count && std::memcmp(cached.data(), data, sizeof(float) * count) == 0) {
+            return false;
+        }
+
+        cached.assign(data, data + count);
+        issued.uniforms++;
+        return true;
+    }
+
+    void GLStateCache::SetUniform(GLint location, int value) {
+        if (location < 0) return;
+        float stored = static_cast<float>(value);
+        if (UniformChanged(location, &stored, 1)) {
+            glUniform1i(location, value);
+        }
+    }
+
+    void GLStateCache::SetUniform(GLint location, const glm::vec3& value) {
+        if (location < 0) return;
+        if (UniformChanged(location, glm::value_ptr(value), 3)) {
+            glUniform3fv(location, 1, glm::value_ptr(value));
+        }
+    }
+
+    void GLStateCache::SetUniform(GLint location, const glm::mat4& value) {
+        if (location < 0) return;
+        if (UniformChanged(location, glm::value_ptr(value), 16)) {
+            glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+        }
+    }
+
+    // ========================================================================
+    // RenderQueue
+    // ========================================================================
+
+    namespace {
+        const int PASS_SHIFT = 62;
+        const int SHADER_SHIFT = 52;
+        const int MATERIAL_SHIFT = 36;
+        const int DEPTH_SHIFT = 12;
+        const uint64_t SHADER_MASK = (1ull << 10) - 1;
+        const uint64_t MATERIAL_MASK = (1ull << 16) - 1;
+        const uint64_t DEPTH_MASK = (1ull << 24) - 1;
+    }
+
+    RenderQueue::RenderQueue()
+        : nearDistance(0.0f), farDistance(1000.0f) {
+    }
+
+    void RenderQueue::SetDepthRange(float nearValue, float farValue) {
+        nearDistance = nearValue;
+        farDistance = std::max(farValue, nearValue + 0.001f);
+    }
+
+    uint64_t RenderQueue::MakeSortKey(RenderPass pass, uint32_t shaderIndex, uint32_t materialIndex, float depth01) {
+        depth01 = std::clamp(depth01, 0.0f, 1.0f);
+        uint64_t depth = static_cast<uint64_t>(depth01 * static_cast<float>(DEPTH_MASK));
+
+        return (static_cast<uint64_t>(pass) << PASS_SHIFT) |
+               ((shaderIndex & SHADER_MASK) << SHADER_SHIFT) |
+               ((materialIndex & MATERIAL_MASK) << MATERIAL_SHIFT) |
+               ((depth & DEPTH_MASK) << DEPTH_SHIFT);
+    }
+
+    void RenderQueue::Submit(const DrawPacket& packet, float viewDistance, RenderPass pass) {
+        if (!packet.shader || packet.vertexArray == 0 || packet.indexCount == 0) return;
+
+        float depth01 = (viewDistance - nearDistance) / (farDistance - nearDistance);
+        if (pass == RenderPass::Transparent) {
+            depth01 = 1.0f - depth01;   // Back to front
+        }
+
+        SortItem item;
+        item.key = MakeSortKey(pass, GetProgramIndex(*packet.shader), GetMaterialIndex(packet), depth01);
+        item.index = static_cast<uint32_t>(packets.size());
+        sortItems.push_back(item);
+        packets.push_back(packet);
+    }
+
+    void RenderQueue::Flush() {
+        // Anything may have touched GL since the last frame
+        state.Invalidate();
+
+        auto sortStart = std::chrono::steady_clock::now();
+        RadixSort(sortItems, sortScratch);
+        stats.sortMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sortStart).count();
+
+        for (const SortItem& item : sortItems) {
+            Execute(packets[item.index]);
+        }
+        if (!sortItems.empty()) {
+            state.BindVertexArray(0);
+        }
+
+        stats.packets += static_cast<int>(packets.size());
+        stats.requested = state.GetRequested();
+        stats.issued = state.GetIssued();
+        lastStats = stats;
+
+        stats = RenderStats();
+        state.ResetCounters();
+        packets.clear();
+        sortItems.clear();
+    }
+
+    void RenderQueue::DrawImmediate(const DrawPacket& packet) {
+        if (!packet.shader || packet.vertexArray == 0 || packet.indexCount == 0) return;
+        stats.packets++;
+        Execute(packet);
+    }
+
+    void RenderQueue::Execute(const DrawPacket& packet) {
+        const ProgramInfo& info = programs[GetProgramIndex(*packet.shader)];
+
+        state.UseProgram(info.program);
+        if (packet.texture != 0) {
+            state.BindTexture(packet.textureUnit, packet.textureTarget, packet.texture);
+        }
+        state.SetUniform(info.useTextureArrayLocation, packet.useTextureArray ? 1 : 0);
+        state.SetUniform(info.instancedLocation, packet.instanceCount > 0 ? 1 : 0);
+        state.SetUniform(info.modelLocation, packet.model);
+        state.SetUniform(info.colorLocation, packet.color);
+        state.BindVertexArray(packet.vertexArray);
+
+        if (packet.instanceCount > 0) {
+            glDrawElementsInstanced(GL_TRIANGLES, packet.indexCount, packet.indexType, 0, packet.instanceCount);
+            stats.instances += packet.instanceCount;
+        } else {
+            glDrawElements(GL_TRIANGLES, packet.indexCount, packet.indexType, 0);
+            stats.instances++;
+        }
+        stats.drawCalls++;
+    }
+
+    void RenderQueue::ResetPrograms() {
+        programs.clear();
+        programLookup.clear();
+        state.Invalidate();
+    }
+
+    uint32_t RenderQueue::GetProgramIndex(const Shader& shader) {
+        GLuint program = shader.GetProgramID();
+        auto it = programLookup.find(program);
+        if (it != programLookup.end()) {
+            return it->second;
+        }
+
+        // Resolve uniform locations once per program instead of per draw
+        ProgramInfo info;
+        info.program = program;
+        info.modelLocation = glGetUniformLocation(program, "uModel");
+        info.colorLocation = glGetUniformLocation(program, "uColor");
+        info.useTextureArrayLocation = glGetUniformLocation(program, "uUseTextureArray");
+        info.instancedLocation = glGetUniformLocation(program, "uInstanced");
+
+        uint32_t index = static_cast<uint32_t>(programs.size());
+        if (index > SHADER_MASK) {
+            LOG_WARNING("RenderQueue: more than " + std::to_string(SHADER_MASK + 1) + " shaders, sort keys will alias");
+        }
+        programs.push_back(info);
+        programLookup[program] = index;
+        return index;
+    }
+
+    uint32_t RenderQueue::GetMaterialIndex(const DrawPacket& packet) {
+        if (packet.texture == 0) return 0;
+
+        auto key = std::make_pair(packet.textureTarget, packet.texture);
+        auto it = materialLookup.find(key);
+        if (it != materialLookup.end()) {
+            return it->second;
+        }
+
+        uint32_t index = static_cast<uint32_t>(materialLookup.size()) + 1;
+        materialLookup[key] = index;
+        return index;
+    }
+
+    void RenderQueue::RadixSort(std::vector<SortItem>& items, std::vector<SortItem>& scratch) {
+        scratch.resize(items.size());
+
+        // 8 passes of 8 bits, least significant first; passes where every key
+        // shares the same byte are skipped (common for pass/shader bits)
+        for (int shift = 0; shift < 64; shift += 8) {
+            size_t counts[256] = {};
+            for (const SortItem& item : items) {
+                counts[(item.key >> shift) & 0xFF]++;
+            }
+            if (items.empty() || counts[(items[0].key >> shift) & 0xFF] == items.size()) {
+                continue;
+            }
+
+            size_t offset = 0;
+            for (size_t& count : counts) {
+                size_t bucket = count;
+                count = offset;
+                offset += bucket;
+            }
+            for (const SortItem& item : items) {
+                scratch[counts[(item.key >> shift) & 0xFF]++] = item;
+            }
+            items.swap(scratch);
+        }
+    }
+
+} // namespace VibeReaper
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Shader.h"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <map>
+#include <utility>
+#include <cstdint>
+
+namespace VibeReaper {
+
+    // Draw order buckets (highest bits of the sort key)
+    enum class RenderPass : uint8_t {
+        Opaque = 0,         // Sorted by shader, material, then front to back
+        Transparent = 1,    // Back to front
+        Overlay = 2         // Debug/UI on top
+    };
+
+    // GL state change counts: requested by draw code vs actually issued
+    struct StateCounters {
+        int programs = 0;
+        int vertexArrays = 0;
+        int textures = 0;
+        int uniforms = 0;
+
+        int Total() const { return programs + vertexArrays + textures + uniforms; }
+    };
+
+    struct RenderStats {
+        int packets = 0;
+        int drawCalls = 0;
+        int instances = 0;          // Objects drawn (instanced draws count each instance)
+        StateCounters requested;    // What binding per draw would cost
+        StateCounters issued;       // After redundant changes are filtered
+        double sortMs = 0.0;
+    };
+
+    /**
+     * @brief Shadow copy of the GL binding state to drop redundant calls
+     *
+     * Tracks the bound program, VAO, per-unit textures and uniform values per
+     * (program, location). Anything that changes GL state behind the cache's
+     * back (Mesh::Draw, Shader::Set*) must be followed by Invalidate().
+     */
+    class GLStateCache {
+    public:
+        GLStateCache();
+
+        void UseProgram(GLuint program);
+        void BindVertexArray(GLuint vao);
+        void BindTexture(int unit, GLenum target, GLuint texture);
+        void SetUniform(GLint location, int value);
+        void SetUniform(GLint location, const glm::vec3& value);
+        void SetUniform(GLint location, const glm::mat4& value);
+
+        // Forget everything (next request of each kind is always issued)
+        void Invalidate();
+
+        const StateCounters& GetRequested() const { return requested; }
+        const StateCounters& GetIssued() const { return issued; }
+        void ResetCounters();
+
+    private:
+        static const int MAX_TEXTURE_UNITS = 8;
+
+        GLuint program;
+        GLuint vertexArray;
+        int activeUnit;
+        GLuint textures[MAX_TEXTURE_UNITS];
+        GLenum textureTargets[MAX_TEXTURE_UNITS];
+        std::map<std::pair<GLuint, GLint>, std::vector<float>> uniforms;
+        StateCounters requested;
+        StateCounters issued;
+
+        bool UniformChanged(GLint location, const float* data, int count);
+    };
+
+    // One indexed draw with the state it needs
+    struct DrawPacket {
+        const Shader* shader = nullptr;
+        GLuint vertexArray = 0;
+        GLsizei indexCount = 0;
+        GLenum indexType = GL_UNSIGNED_INT;
+        GLuint texture = 0;                 // 0 = leave the unit as it is
+        GLenum textureTarget = GL_TEXTURE_2D;
+        int textureUnit = 0;
+        bool useTextureArray = false;       // uUseTextureArray
+        glm::mat4 model = glm::mat4(1.0f);  // uModel
+        glm::vec3 color = glm::vec3(1.0f);  // uColor
+        GLsizei instanceCount = 0;          // > 0: instanced draw, model/color come from the VAO's instance attributes
+    };
+
+    /**
+     * @brief Sorted list of draw packets executed through a GLStateCache
+     *
+     * Submit() packs a 64-bit sort key per packet:
+     *   [63..62] pass | [61..52] shader | [51..36] material | [35..12] depth
+     * Flush() radix-sorts the keys (stable, so equal keys keep submission
+     * order), then draws with redundant program/VAO/texture/uniform changes
+     * filtered out. Shader and material fields are dense indices assigned on
+     * first use, so the key order groups identical state together.
+     *
+     * Shaders must use uModel/uColor/uUseTextureArray/uInstanced (lighting.vert/frag).
+     */
+    class RenderQueue {
+    public:
+        RenderQueue();
+
+        // View distances mapped to the depth field (outside values are clamped)
+        void SetDepthRange(float nearDistance, float farDistance);
+
+        void Submit(const DrawPacket& packet, float viewDistance, RenderPass pass = RenderPass::Opaque);
+
+        // Sort and draw everything submitted since the last Flush()
+        void Flush();
+
+        // Draw one packet right away through the same state cache (e.g. inside an occlusion query)
+        void DrawImmediate(const DrawPacket& packet);
+
+        // Call after drawing outside the queue (Mesh::Draw, direct glUseProgram/uniforms)
+        void InvalidateState() { state.Invalidate(); }
+
+        // Forget cached programs and uniform locations after a shader was relinked
+        // (hot reload; GL may reuse a deleted program's name). Call between frames.
+        void ResetPrograms();
+
+        // Stats of the last frame: immediate draws plus the Flush() that ended it
+        const RenderStats& GetStats() const { return lastStats; }
+
+        static uint64_t MakeSortKey(RenderPass pass, uint32_t shaderIndex, uint32_t materialIndex, float depth01);
+
+        // Stable LSD radix sort of (key, index) pairs by key; scratch is reused
+        struct SortItem {
+            uint64_t key;
+            uint32_t index;
+        };
+        static void RadixSort(std::vector<SortItem>& items, std::vector<SortItem>& scratch);
+
+    private:
+        struct ProgramInfo {
+            GLuint program;
+            GLint modelLocation;
+            GLint colorLocation;
+            GLint useTextureArrayLocation;
+            GLint instancedLocation;
+        };
+
+        std::vector<DrawPacket> packets;
+        std::vector<SortItem> sortItems;
+        std::vector<SortItem> sortScratch;
+        std::vector<ProgramInfo> programs;
+        std::map<GLuint, uint32_t> programLookup;
+        std::map<std::pair<GLenum, GLuint>, uint32_t> materialLookup;
+        GLStateCache state;
+        RenderStats stats;
+        RenderStats lastStats;
+        float nearDistance, farDistance;
+
+        uint32_t GetProgramIndex(const Shader& shader);
+        uint32_t GetMaterialIndex(const DrawPacket& packet);
+        void Execute(const DrawPacket& packet);
+    };
+
+} // namespace VibeReaper
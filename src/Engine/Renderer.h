@@ -2,6 +2,7 @@
 
 #include <glad/glad.h>
 #include <SDL2/SDL.h>
+#include "RenderQueue.h"
 
 namespace VibeReaper {
 
@@ -31,7 +32,11 @@ public:
     // Swap buffers (call after rendering)
     void SwapBuffers(SDL_Window* window);
 
+    // Draw packets for this frame; Flush() it before SwapBuffers()
+    RenderQueue& GetRenderQueue() { return m_renderQueue; }
+
 private:
+    RenderQueue m_renderQueue;
     float m_clearColor[4];
     bool m_wireframeMode;
     bool m_vsyncEnabled;
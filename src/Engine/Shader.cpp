@@ -16,6 +16,9 @@ Shader::~Shader() {
 }
 
 bool Shader::LoadFromFiles(const std::string& vertexPath, const std::string& fragmentPath) {
+    m_vertexPath = vertexPath;
+    m_fragmentPath = fragmentPath;
+
     // Read shader source code from files
     std::string vertexCode = ReadFile(vertexPath);
     std::string fragmentCode = ReadFile(fragmentPath);
@@ -31,21 +34,44 @@ bool Shader::LoadFromFiles(const std::string& vertexPath, const std::string& fra
 
     if (vertexShader == 0 || fragmentShader == 0) {
         LOG_ERROR("Failed to compile shaders");
+        if (vertexShader != 0) glDeleteShader(vertexShader);
+        if (fragmentShader != 0) glDeleteShader(fragmentShader);
         return false;
     }
 
     // Link program
-    bool success = LinkProgram(vertexShader, fragmentShader);
+    GLuint program = LinkProgram(vertexShader, fragmentShader);
 
     // Clean up shader objects (they're linked into the program now)
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
 
-    if (success) {
-        LOG_INFO("Shader program created successfully: " + vertexPath + " + " + fragmentPath);
+    if (program == 0) {
+        return false;
     }
 
-    return success;
+    // The old program is only replaced once the new one linked
+    if (m_programID != 0) {
+        glDeleteProgram(m_programID);
+    }
+    m_programID = program;
+    LOG_INFO("Shader program created successfully: " + vertexPath + " + " + fragmentPath);
+    return true;
+}
+
+bool Shader::Reload() {
+    if (m_vertexPath.empty()) {
+        return false;
+    }
+
+    // Copies: LoadFromFiles assigns the members it is passed
+    std::string vertexPath = m_vertexPath;
+    std::string fragmentPath = m_fragmentPath;
+    if (!LoadFromFiles(vertexPath, fragmentPath)) {
+        LOG_WARNING("Shader reload failed, keeping the previous program: " + vertexPath + " + " + fragmentPath);
+        return false;
+    }
+    return true;
 }
 
 void Shader::Use() const {
@@ -56,6 +82,10 @@ void Shader::SetInt(const std::string& name, int value) const {
     glUniform1i(glGetUniformLocation(m_programID, name.c_str()), value);
 }
 
+void Shader::SetIntArray(const std::string& name, const int* values, int count) const {
+    glUniform1iv(glGetUniformLocation(m_programID, name.c_str()), count, values);
+}
+
 void Shader::SetFloat(const std::string& name, float value) const {
     glUniform1f(glGetUniformLocation(m_programID, name.c_str()), value);
 }
@@ -107,24 +137,23 @@ GLuint Shader::CompileShader(GLenum type, const std::string& source) {
     return shader;
 }
 
-bool Shader::LinkProgram(GLuint vertexShader, GLuint fragmentShader) {
-    m_programID = glCreateProgram();
-    glAttachShader(m_programID, vertexShader);
-    glAttachShader(m_programID, fragmentShader);
-    glLinkProgram(m_programID);
+GLuint Shader::LinkProgram(GLuint vertexShader, GLuint fragmentShader) {
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
 
     // Check for linking errors
-    CheckLinkErrors(m_programID);
+    CheckLinkErrors(program);
 
     GLint success;
-    glGetProgramiv(m_programID, GL_LINK_STATUS, &success);
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
     if (!success) {
-        glDeleteProgram(m_programID);
-        m_programID = 0;
-        return false;
+        glDeleteProgram(program);
+        return 0;
     }
 
-    return true;
+    return program;
 }
 
 void Shader::CheckCompileErrors(GLuint shader, const std::string& type) {
@@ -11,14 +11,23 @@ public:
     Shader();
     ~Shader();
 
-    // Load and compile shaders from file paths
+    // Load and compile shaders from file paths. On failure a previously linked
+    // program stays in use, so a broken edit never leaves the shader unusable.
     bool LoadFromFiles(const std::string& vertexPath, const std::string& fragmentPath);
 
+    // Recompile and relink from the files last passed to LoadFromFiles (hot reload).
+    // The program ID changes on success.
+    bool Reload();
+
+    // Whether path is one of this shader's source files
+    bool UsesFile(const std::string& path) const { return path == m_vertexPath || path == m_fragmentPath; }
+
     // Activate this shader program
     void Use() const;
 
     // Uniform setters for various types
     void SetInt(const std::string& name, int value) const;
+    void SetIntArray(const std::string& name, const int* values, int count) const;
     void SetFloat(const std::string& name, float value) const;
     void SetVec2(const std::string& name, const glm::vec2& value) const;
     void SetVec3(const std::string& name, const glm::vec3& value) const;
@@ -30,11 +39,13 @@ public:
 
 private:
     GLuint m_programID;
+    std::string m_vertexPath;
+    std::string m_fragmentPath;
 
     // Helper functions
     std::string ReadFile(const std::string& filePath);
     GLuint CompileShader(GLenum type, const std::string& source);
-    bool LinkProgram(GLuint vertexShader, GLuint fragmentShader);
+    GLuint LinkProgram(GLuint vertexShader, GLuint fragmentShader);
     void CheckCompileErrors(GLuint shader, const std::string& type);
     void CheckLinkErrors(GLuint program);
 };
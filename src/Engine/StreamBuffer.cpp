@@ -0,0 +1,144 @@
+#include "StreamBuffer.h"
+#include "../Utils/Logger.h"
+#include <chrono>
+#include <cstring>
+
+namespace VibeReaper {
+
+    namespace {
+        // Give up waiting after one second (lost context, hung driver) rather than freezing
+        const GLuint64 FENCE_TIMEOUT_NS = 1000000000ull;
+    }
+
+    void StreamRing::Reset(size_t segmentBytes, size_t align) {
+        alignment = align;
+        segmentSize = StreamBuffer::AlignUp(segmentBytes, alignment);
+        segment = SEGMENTS - 1;     // First Advance() moves to segment 0
+        writeOffset = segmentSize;  // Nothing writable until Advance()
+    }
+
+    int StreamRing::Advance() {
+        segment = (segment + 1) % SEGMENTS;
+        writeOffset = 0;
+        return segment;
+    }
+
+    size_t StreamRing::Reserve(size_t bytes) {
+        size_t alignedBytes = StreamBuffer::AlignUp(bytes, alignment);
+        if (bytes == 0 || alignedBytes > segmentSize - writeOffset) return NO_SPACE;
+
+        size_t offset = StreamBuffer::SegmentOffset(segment, segmentSize) + writeOffset;
+        writeOffset += alignedBytes;
+        return offset;
+    }
+
+    StreamBuffer::StreamBuffer()
+        : buffer(0), inFrame(false) {
+        for (int i = 0; i < SEGMENTS; i++) {
+            fences[i] = nullptr;
+        }
+    }
+
+    StreamBuffer::~StreamBuffer() {
+        Destroy();
+    }
+
+    bool StreamBuffer::Create(size_t segmentBytes, size_t align) {
+        Destroy();
+        if (segmentBytes == 0 || align == 0) return false;
+
+        ring.Reset(segmentBytes, align);
+
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        glBufferData(GL_ARRAY_BUFFER, ring.GetSegmentSize() * SEGMENTS, nullptr, GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        LOG_INFO("StreamBuffer created: " + std::to_string(SEGMENTS) + " x " +
+                 std::to_string(ring.GetSegmentSize() / 1024) + " KB");
+        return true;
+    }
+
+    void StreamBuffer::Destroy() {
+        for (int i = 0; i < SEGMENTS; i++) {
+            if (fences[i]) {
+                glDeleteSync(fences[i]);
+                fences[i] = nullptr;
+            }
+        }
+        if (buffer != 0) {
+            glDeleteBuffers(1, &buffer);
+            buffer = 0;
+        }
+        ring.Reset(0, 1);
+        inFrame = false;
+    }
+
+    void StreamBuffer::BeginFrame() {
+        if (buffer == 0) return;
+        if (inFrame) EndFrame();
+
+        int segment = ring.Advance();
+        inFrame = true;
+        stats.bytesWritten = 0;
+        stats.bytesDropped = 0;
+        stats.writes = 0;
+
+        // The fence is normally signaled already (the segment was drawn from
+        // SEGMENTS - 1 frames ago); only a GPU running that far behind waits here
+        GLsync fence = fences[segment];
+        if (!fence) return;
+
+        GLenum result = glClientWaitSync(fence, 0, 0);
+        if (result == GL_TIMEOUT_EXPIRED) {
+            auto waitStart = std::chrono::steady_clock::now();
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT_NS);
+            stats.stalls++;
+            stats.waitMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - waitStart).count();
+        }
+        if (result == GL_WAIT_FAILED || result == GL_TIMEOUT_EXPIRED) {
+            LOG_WARNING("StreamBuffer: fence wait failed, segment may still be in use");
+        }
+        glDeleteSync(fence);
+        fences[segment] = nullptr;
+    }
+
+    size_t StreamBuffer::Write(const void* data, size_t bytes) {
+        if (!inFrame || bytes == 0) return NO_SPACE;
+
+        size_t offset = ring.Reserve(bytes);
+        if (offset == NO_SPACE) {
+            stats.bytesDropped += bytes;
+            return NO_SPACE;
+        }
+
+        // Unsynchronized: the fence wait in BeginFrame() already guarantees the
+        // GPU is done with this segment. Invalidating the range lets the driver
+        // skip preserving its old contents.
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        void* mapped = glMapBufferRange(GL_ARRAY_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(bytes),
+                                        GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+        if (!mapped) {
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            LOG_ERROR("StreamBuffer: glMapBufferRange failed");
+            return NO_SPACE;
+        }
+        std::memcpy(mapped, data, bytes);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        stats.bytesWritten += bytes;
+        stats.writes++;
+        return offset;
+    }
+
+    void StreamBuffer::EndFrame() {
+        if (!inFrame) return;
+        inFrame = false;
+
+        // Nothing drawn from this segment, nothing to wait for later
+        if (stats.writes == 0) return;
+        fences[ring.GetSegment()] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+} // namespace VibeReaper
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <vector>
+#include <cstddef>
+
+namespace VibeReaper {
+
+    struct StreamBufferStats {
+        size_t bytesWritten = 0;    // This frame
+        size_t bytesDropped = 0;    // Writes that did not fit in the segment
+        int writes = 0;
+        int stalls = 0;             // Frames that had to wait for the GPU (total)
+        double waitMs = 0.0;        // Time spent waiting on fences (total)
+    };
+
+    /**
+     * @brief CPU-side bookkeeping of the StreamBuffer ring (no GL calls)
+     *
+     * Hands out aligned ranges of the current segment. Advance() moves to the
+     * next segment, so a range is only handed out again SEGMENTS frames later,
+     * after StreamBuffer waited on that segment's fence.
+     */
+    class StreamRing {
+    public:
+        static const int SEGMENTS = 3;
+        static const size_t NO_SPACE = static_cast<size_t>(-1);
+
+        // segmentBytes is rounded up to the alignment; nothing is writable until Advance()
+        void Reset(size_t segmentBytes, size_t alignment);
+
+        // Start the next segment and return its index
+        int Advance();
+
+        // Buffer offset of bytes (aligned) in the current segment, or NO_SPACE if it is full
+        size_t Reserve(size_t bytes);
+
+        int GetSegment() const { return segment; }
+        size_t GetSegmentSize() const { return segmentSize; }
+        size_t GetRemaining() const { return segmentSize - writeOffset; }
+
+    private:
+        size_t segmentSize = 0;
+        size_t alignment = 16;
+        int segment = 0;
+        size_t writeOffset = 0;
+    };
+
+    /**
+     * @brief Ring buffer for geometry rewritten every frame (debug lines, particles, UI)
+     *
+     * One GL buffer split into SEGMENTS equal parts; frame N writes into segment
+     * N % SEGMENTS. Writes map their range with GL_MAP_UNSYNCHRONIZED_BIT, so the
+     * driver never waits for draws that still read older data. That is only safe
+     * because each segment is fenced when its frame ends, and BeginFrame() waits
+     * on the fence of the segment it is about to reuse (normally already signaled
+     * two frames later).
+     *
+     * Persistent mapping would save the map/unmap per write but needs
+     * GL 4.4 / ARB_buffer_storage, above the GL 3.3 core context we create.
+     */
+    class StreamBuffer {
+    public:
+        static const int SEGMENTS = StreamRing::SEGMENTS;
+
+        StreamBuffer();
+        ~StreamBuffer();
+
+        StreamBuffer(const StreamBuffer&) = delete;
+        StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+        // Allocate segmentBytes per frame (rounded up to the alignment)
+        bool Create(size_t segmentBytes, size_t alignment = 16);
+        void Destroy();
+
+        // Start writing the next segment (waits if the GPU still reads it)
+        void BeginFrame();
+
+        // Copy data into this frame's segment. Returns the byte offset of the data
+        // in the buffer, or NO_SPACE if the segment is full.
+        static const size_t NO_SPACE = StreamRing::NO_SPACE;
+        size_t Write(const void* data, size_t bytes);
+
+        // Fence this frame's segment after the draws that read it were issued
+        void EndFrame();
+
+        GLuint GetBuffer() const { return buffer; }
+        size_t GetSegmentSize() const { return ring.GetSegmentSize(); }
+        size_t GetRemaining() const { return ring.GetRemaining(); }
+        const StreamBufferStats& GetStats() const { return stats; }
+
+        // Byte offset of a segment in the buffer (exposed for tests)
+        static size_t SegmentOffset(int segment, size_t segmentSize) { return static_cast<size_t>(segment) * segmentSize; }
+        static size_t AlignUp(size_t value, size_t alignment) { return (value + alignment - 1) / alignment * alignment; }
+
+    private:
+        GLuint buffer;
+        StreamRing ring;
+        bool inFrame;
+        GLsync fences[SEGMENTS];
+        StreamBufferStats stats;
+    };
+
+} // namespace VibeReaper
@@ -1,13 +1,22 @@
 #include "Texture.h"
 #include "../Utils/Logger.h"
+#include <algorithm>
+#include <vector>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
 
 namespace VibeReaper {
 
+    namespace {
+        // OpenGL expects texture origin at bottom-left. stb_image keeps this flag in a
+        // process-wide global, so it is set once during static initialization, before
+        // any TextureLoader worker exists, and never written again.
+        const bool flipOnLoad = (stbi_set_flip_vertically_on_load(1), true);
+    }
+
     Texture::Texture()
-        : textureID(0), width(0), height(0), channels(0), loaded(false) {
+        : textureID(0), width(0), height(0), channels(0), loaded(false), compressed(false), memoryBytes(0) {
     }
 
     Texture::~Texture() {
@@ -19,7 +28,9 @@ namespace VibeReaper {
           width(other.width),
           height(other.height),
           channels(other.channels),
-          loaded(other.loaded) {
+          loaded(other.loaded),
+          compressed(other.compressed),
+          memoryBytes(other.memoryBytes) {
         
         // Reset other
         other.textureID = 0;
@@ -27,6 +38,8 @@ namespace VibeReaper {
         other.height = 0;
         other.channels = 0;
         other.loaded = false;
+        other.compressed = false;
+        other.memoryBytes = 0;
     }
 
     Texture& Texture::operator=(Texture&& other) noexcept {
@@ -38,6 +51,8 @@ namespace VibeReaper {
             height = other.height;
             channels = other.channels;
             loaded = other.loaded;
+            compressed = other.compressed;
+            memoryBytes = other.memoryBytes;
 
             // Reset other
             other.textureID = 0;
@@ -45,6 +60,8 @@ namespace VibeReaper {
             other.height = 0;
             other.channels = 0;
             other.loaded = false;
+            other.compressed = false;
+            other.memoryBytes = 0;
         }
         return *this;
     }
@@ -55,15 +72,49 @@ namespace VibeReaper {
             Cleanup();
         }
 
+        // Precompressed mips upload directly, no decode or runtime mip generation
+        if (IsCompressionSupported() && TextureCompression::HasUpToDateCompressed(path)) {
+            std::string compressedPath = TextureCompression::GetCompressedPath(path);
+            CompressedImage image;
+            if (TextureCompression::LoadKTX(compressedPath, image) && UploadCompressed(image)) {
+                LOG_INFO("Texture loaded: " + compressedPath + " (" + std::to_string(width) + "x" +
+                         std::to_string(height) + ", " + std::to_string(image.mips.size()) + " mips, compressed)");
+                return true;
+            }
+            LOG_WARNING("Failed to load compressed texture " + compressedPath + ", falling back to " + path);
+        }
+
         // Load image using stb_image
-        stbi_set_flip_vertically_on_load(true); // OpenGL expects texture origin at bottom-left
-        unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+        int imageWidth = 0, imageHeight = 0, imageChannels = 0;
+        unsigned char* data = DecodeImage(path, imageWidth, imageHeight, imageChannels);
 
         if (!data) {
             LOG_ERROR("Failed to load texture: " + path);
             return false;
         }
 
+        bool success = UploadPixels(data, imageWidth, imageHeight, imageChannels);
+
+        // Free image data
+        FreeImage(data);
+
+        if (success) {
+            LOG_INFO("Texture loaded: " + path + " (" + std::to_string(width) + "x" + 
+                     std::to_string(height) + ", " + std::to_string(channels) + " channels)");
+        }
+
+        return success;
+    }
+
+    bool Texture::UploadPixels(const unsigned char* data, int imageWidth, int imageHeight, int imageChannels) {
+        if (loaded) {
+            Cleanup();
+        }
+
+        width = imageWidth;
+        height = imageHeight;
+        channels = imageChannels;
+
         // Determine format based on number of channels
         GLenum format = GL_RGB;
         if (channels == 1)
@@ -89,18 +140,95 @@ namespace VibeReaper {
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
-        // Free image data
-        stbi_image_free(data);
-
         glBindTexture(GL_TEXTURE_2D, 0);
 
         loaded = true;
-        LOG_INFO("Texture loaded: " + path + " (" + std::to_string(width) + "x" + 
-                 std::to_string(height) + ", " + std::to_string(channels) + " channels)");
+        compressed = false;
+        // Base level plus ~1/3 for the mip chain
+        memoryBytes = static_cast<size_t>(width) * height * channels * 4 / 3;
+        return true;
+    }
+
+    bool Texture::UploadCompressed(const CompressedImage& image) {
+        if (image.mips.empty()) return false;
+
+        if (loaded) {
+            Cleanup();
+        }
+
+        GLenum internalFormat = TextureCompression::GetGLInternalFormat(image.format);
+
+        // Drain stale errors so the check below only reports this upload
+        while (glGetError() != GL_NO_ERROR) {}
+
+        glGenTextures(1, &textureID);
+        glBindTexture(GL_TEXTURE_2D, textureID);
+
+        for (size_t level = 0; level < image.mips.size(); level++) {
+            const CompressedMip& mip = image.mips[level];
+            glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), internalFormat, mip.width, mip.height, 0,
+                                   static_cast<GLsizei>(mip.data.size()), mip.data.data());
+        }
+
+        if (glGetError() != GL_NO_ERROR) {
+            LOG_ERROR("Compressed texture upload failed");
+            glBindTexture(GL_TEXTURE_2D, 0);
+            Cleanup();
+            return false;
+        }
+
+        // Only the levels present in the file; no glGenerateMipmap needed
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.mips.size() - 1));
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        glBindTexture(GL_TEXTURE_2D, 0);
 
+        width = image.width;
+        height = image.height;
+        channels = image.format == CompressedFormat::BC1 ? 3 : 4;
+        loaded = true;
+        compressed = true;
+        memoryBytes = image.GetDataSize();
         return true;
     }
 
+    bool Texture::IsCompressionSupported() {
+        // -1 = not queried yet
+        static int supported = -1;
+        if (supported >= 0) {
+            return supported == 1;
+        }
+
+        GLint formatCount = 0;
+        glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &formatCount);
+
+        std::vector<GLint> formats(static_cast<size_t>(std::max(formatCount, 0)));
+        if (!formats.empty()) {
+            glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data());
+        }
+
+        bool hasBC1 = std::find(formats.begin(), formats.end(),
+            static_cast<GLint>(TextureCompression::GetGLInternalFormat(CompressedFormat::BC1))) != formats.end();
+        bool hasBC3 = std::find(formats.begin(), formats.end(),
+            static_cast<GLint>(TextureCompression::GetGLInternalFormat(CompressedFormat::BC3))) != formats.end();
+
+        supported = (hasBC1 && hasBC3) ? 1 : 0;
+        LOG_INFO(std::string("S3TC texture compression ") + (supported ? "supported" : "not supported, using PNG only"));
+        return supported == 1;
+    }
+
+    unsigned char* Texture::DecodeImage(const std::string& path, int& imageWidth, int& imageHeight, int& imageChannels) {
+        // Flipped by stb_image (see flipOnLoad); safe to call from any thread
+        return stbi_load(path.c_str(), &imageWidth, &imageHeight, &imageChannels, 0);
+    }
+
+    void Texture::FreeImage(unsigned char* data) {
+        stbi_image_free(data);
+    }
+
     void Texture::CreateWhiteTexture() {
         if (loaded) {
             Cleanup();
@@ -125,6 +253,8 @@ namespace VibeReaper {
         glBindTexture(GL_TEXTURE_2D, 0);
 
         loaded = true;
+        compressed = false;
+        memoryBytes = 4;
         LOG_INFO("Created fallback white texture");
     }
 
@@ -148,6 +278,8 @@ namespace VibeReaper {
             textureID = 0;
         }
         loaded = false;
+        compressed = false;
+        memoryBytes = 0;
     }
 
 } // namespace VibeReaper
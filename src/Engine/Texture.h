@@ -1,7 +1,9 @@
 #pragma once
 
+#include "TextureCompression.h"
 #include <glad/glad.h>
 #include <string>
+#include <cstddef>
 
 namespace VibeReaper {
 
@@ -19,9 +21,25 @@ namespace VibeReaper {
         
         ~Texture();
 
-        // Load texture from file
+        // Load texture from file (decode + upload on the calling thread)
+        // Prefers an up-to-date .ktx next to the image (see tools/TextureCompiler)
         bool LoadFromFile(const std::string& path);
 
+        // Upload already-decoded pixels (GL thread only)
+        // If a GL_PIXEL_UNPACK_BUFFER is bound, data is an offset into it
+        bool UploadPixels(const unsigned char* data, int width, int height, int channels);
+
+        // Upload a block-compressed mip chain as-is (GL thread only)
+        bool UploadCompressed(const CompressedImage& image);
+
+        // Whether the driver accepts the BC1/BC3 formats (GL thread only, cached)
+        static bool IsCompressionSupported();
+
+        // Decode an image file to 8-bit pixels without touching OpenGL (thread-safe)
+        // Returns nullptr on failure; free the result with FreeImage()
+        static unsigned char* DecodeImage(const std::string& path, int& width, int& height, int& channels);
+        static void FreeImage(unsigned char* data);
+
         // Create a 1x1 white texture (fallback)
         void CreateWhiteTexture();
 
@@ -36,11 +54,15 @@ namespace VibeReaper {
         int GetWidth() const { return width; }
         int GetHeight() const { return height; }
         bool IsLoaded() const { return loaded; }
+        bool IsCompressed() const { return compressed; }
+        size_t GetMemoryBytes() const { return memoryBytes; }
 
     private:
         unsigned int textureID;
         int width, height, channels;
         bool loaded;
+        bool compressed;
+        size_t memoryBytes;     // Approximate GPU memory including mips
 
         void Cleanup();
     };
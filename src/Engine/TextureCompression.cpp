@@ -0,0 +1,434 @@
+#include "TextureCompression.h"
+#include "../Utils/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace VibeReaper {
+
+    namespace {
+        const uint8_t KTX_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+        const uint32_t KTX_ENDIANNESS = 0x04030201;
+        const uint32_t KTX_GL_RGB = 0x1907;
+        const uint32_t KTX_GL_RGBA = 0x1908;
+
+        // EXT_texture_compression_s3tc enums, spelled out because S3TC is an extension
+        // in GL 3.3 and the loader may not have generated them
+        const uint32_t GL_BC1_RGB = 0x83F0;     // GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+        const uint32_t GL_BC3_RGBA = 0x83F3;    // GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+
+        // KTX 1 header following the identifier (all fields uint32)
+        struct KTXHeader {
+            uint32_t endianness;
+            uint32_t glType;
+            uint32_t glTypeSize;
+            uint32_t glFormat;
+            uint32_t glInternalFormat;
+            uint32_t glBaseInternalFormat;
+            uint32_t pixelWidth;
+            uint32_t pixelHeight;
+            uint32_t pixelDepth;
+            uint32_t numberOfArrayElements;
+            uint32_t numberOfFaces;
+            uint32_t numberOfMipmapLevels;
+            uint32_t bytesOfKeyValueData;
+        };
+
+        uint16_t PackRGB565(const float* rgb) {
+            int r = std::clamp(static_cast<int>(rgb[0] * 31.0f / 255.0f + 0.5f), 0, 31);
+            int g = std::clamp(static_cast<int>(rgb[1] * 63.0f / 255.0f + 0.5f), 0, 63);
+            int b = std::clamp(static_cast<int>(rgb[2] * 31.0f / 255.0f + 0.5f), 0, 31);
+            return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+        }
+
+        void UnpackRGB565(uint16_t color, int* rgb) {
+            int r = (color >> 11) & 31;
+            int g = (color >> 5) & 63;
+            int b = color & 31;
+            rgb[0] = (r << 3) | (r >> 2);
+            rgb[1] = (g << 2) | (g >> 4);
+            rgb[2] = (b << 3) | (b >> 2);
+        }
+    }
+
+    size_t CompressedImage::GetDataSize() const {
+        size_t total = 0;
+        for (const auto& mip : mips) {
+            total += mip.data.size();
+        }
+        return total;
+    }
+
+    CompressedImage TextureCompression::Compress(const uint8_t* rgba, int width, int height, CompressedFormat format) {
+        CompressedImage image;
+        image.format = format;
+        image.width = width;
+        image.height = height;
+
+        if (!rgba || width <= 0 || height <= 0) return image;
+
+        const size_t blockBytes = format == CompressedFormat::BC1 ? 8 : 16;
+        std::vector<uint8_t> level(rgba, rgba + static_cast<size_t>(width) * height * 4);
+        int levelWidth = width;
+        int levelHeight = height;
+
+        while (true) {
+            CompressedMip mip;
+            mip.width = levelWidth;
+            mip.height = levelHeight;
+            mip.data.resize(GetMipSize(format, levelWidth, levelHeight));
+
+            int blocksX = (levelWidth + 3) / 4;
+            int blocksY = (levelHeight + 3) / 4;
+            uint8_t block[64];
+
+            for (int by = 0; by < blocksY; by++) {
+                for (int bx = 0; bx < blocksX; bx++) {
+                    // Gather the 4x4 block, clamping at the edges of small/odd mips
+                    for (int y = 0; y < 4; y++) {
+                        int srcY = std::min(by * 4 + y, levelHeight - 1);
+                        for (int x = 0; x < 4; x++) {
+                            int srcX = std::min(bx * 4 + x, levelWidth - 1);
+                            std::memcpy(&block[(y * 4 + x) * 4],
+                                        &level[(static_cast<size_t>(srcY) * levelWidth + srcX) * 4], 4);
+                        }
+                    }
+
+                    uint8_t* out = &mip.data[(static_cast<size_t>(by) * blocksX + bx) * blockBytes];
+                    if (format == CompressedFormat::BC1) {
+                        EncodeBC1Block(block, out);
+                    } else {
+                        EncodeBC3Block(block, out);
+                    }
+                }
+            }
+
+            image.mips.push_back(std::move(mip));
+
+            if (levelWidth == 1 && levelHeight == 1) break;
+            level = Downsample(level, levelWidth, levelHeight, levelWidth, levelHeight);
+        }
+
+        return image;
+    }
+
+    CompressedFormat TextureCompression::ChooseFormat(const uint8_t* rgba, int width, int height) {
+        size_t pixelCount = static_cast<size_t>(width) * height;
+        for (size_t i = 0; i < pixelCount; i++) {
+            if (rgba[i * 4 + 3] != 255) {
+                return CompressedFormat::BC3;
+            }
+        }
+        return CompressedFormat::BC1;
+    }
+
+    void TextureCompression::EncodeBC1Block(const uint8_t* block, uint8_t* out) {
+        EncodeColorBlock(block, out);
+    }
+
+    void TextureCompression::EncodeBC3Block(const uint8_t* block, uint8_t* out) {
+        // BC3 = BC4-style alpha block followed by a BC1 color block
+        EncodeAlphaBlock(block, out);
+        EncodeColorBlock(block, out + 8);
+    }
+
+    void TextureCompression::EncodeColorBlock(const uint8_t* block, uint8_t* out) {
+        // Fit endpoints along the principal axis of the block's colors
+        float mean[3] = { 0.0f, 0.0f, 0.0f };
+        for (int i = 0; i < 16; i++) {
+            for (int c = 0; c < 3; c++) {
+                mean[c] += block[i * 4 + c];
+            }
+        }
+        for (int c = 0; c < 3; c++) {
+            mean[c] /= 16.0f;
+        }
+
+        float cov[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f }; // rr rg rb gg gb bb
+        for (int i = 0; i < 16; i++) {
+            float r = block[i * 4 + 0] - mean[0];
+            float g = block[i * 4 + 1] - mean[1];
+            float b = block[i * 4 + 2] - mean[2];
+            cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+            cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+        }
+
+        // A few power iterations are plenty for a 3x3 covariance matrix
+        float axis[3] = { 1.0f, 1.0f, 1.0f };
+        for (int iteration = 0; iteration < 8; iteration++) {
+            float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+            float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+            float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+            float length = std::max(std::max(std::abs(x), std::abs(y)), std::abs(z));
+            if (length < 1e-6f) break;
+            axis[0] = x / length;
+            axis[1] = y / length;
+            axis[2] = z / length;
+        }
+
+        float minProj = 1e30f, maxProj = -1e30f;
+        for (int i = 0; i < 16; i++) {
+            float proj = (block[i * 4 + 0] - mean[0]) * axis[0] +
+                         (block[i * 4 + 1] - mean[1]) * axis[1] +
+                         (block[i * 4 + 2] - mean[2]) * axis[2];
+            minProj = std::min(minProj, proj);
+            maxProj = std::max(maxProj, proj);
+        }
+
+        float axisLengthSq = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+        float minColor[3], maxColor[3];
+        for (int c = 0; c < 3; c++) {
+            float scale = axisLengthSq > 0.0f ? axis[c] / axisLengthSq : 0.0f;
+            minColor[c] = std::clamp(mean[c] + minProj * scale, 0.0f, 255.0f);
+            maxColor[c] = std::clamp(mean[c] + maxProj * scale, 0.0f, 255.0f);
+        }
+
+        uint16_t color0 = PackRGB565(maxColor);
+        uint16_t color1 = PackRGB565(minColor);
+
+        // color0 > color1 selects the opaque 4-color mode
+        if (color0 < color1) {
+            std::swap(color0, color1);
+        }
+
+        uint32_t indices = 0;
+        if (color0 != color1) {
+            int palette[4][3];
+            UnpackRGB565(color0, palette[0]);
+            UnpackRGB565(color1, palette[1]);
+            for (int c = 0; c < 3; c++) {
+                palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+            }
+
+            for (int i = 0; i < 16; i++) {
+                int best = 0;
+                int bestError = 1 << 30;
+                for (int p = 0; p < 4; p++) {
+                    int dr = block[i * 4 + 0] - palette[p][0];
+                    int dg = block[i * 4 + 1] - palette[p][1];
+                    int db = block[i * 4 + 2] - palette[p][2];
+                    int error = dr * dr + dg * dg + db * db;
+                    if (error < bestError) {
+                        bestError = error;
+                        best = p;
+                    }
+                }
+                indices |= static_cast<uint32_t>(best) << (i * 2);
+            }
+        }
+
+        out[0] = static_cast<uint8_t>(color0 & 0xFF);
+        out[1] = static_cast<uint8_t>(color0 >> 8);
+        out[2] = static_cast<uint8_t>(color1 & 0xFF);
+        out[3] = static_cast<uint8_t>(color1 >> 8);
+        for (int i = 0; i < 4; i++) {
+            out[4 + i] = static_cast<uint8_t>((indices >> (i * 8)) & 0xFF);
+        }
+    }
+
+    void TextureCompression::EncodeAlphaBlock(const uint8_t* block, uint8_t* out) {
+        int alpha0 = 0, alpha1 = 255;
+        for (int i = 0; i < 16; i++) {
+            alpha0 = std::max(alpha0, static_cast<int>(block[i * 4 + 3]));
+            alpha1 = std::min(alpha1, static_cast<int>(block[i * 4 + 3]));
+        }
+
+        uint64_t indices = 0;
+        if (alpha0 != alpha1) {
+            // alpha0 > alpha1 selects the 8-value interpolation mode
+            int palette[8];
+            palette[0] = alpha0;
+            palette[1] = alpha1;
+            for (int p = 1; p < 7; p++) {
+                palette[p + 1] = ((7 - p) * alpha0 + p * alpha1) / 7;
+            }
+
+            for (int i = 0; i < 16; i++) {
+                int best = 0;
+                int bestError = 256;
+                for (int p = 0; p < 8; p++) {
+                    int error = std::abs(block[i * 4 + 3] - palette[p]);
+                    if (error < bestError) {
+                        bestError = error;
+                        best = p;
+                    }
+                }
+                indices |= static_cast<uint64_t>(best) << (i * 3);
+            }
+        }
+
+        out[0] = static_cast<uint8_t>(alpha0);
+        out[1] = static_cast<uint8_t>(alpha1);
+        for (int i = 0; i < 6; i++) {
+            out[2 + i] = static_cast<uint8_t>((indices >> (i * 8)) & 0xFF);
+        }
+    }
+
+    size_t TextureCompression::GetMipSize(CompressedFormat format, int width, int height) {
+        size_t blocks = static_cast<size_t>(std::max(1, (width + 3) / 4)) * std::max(1, (height + 3) / 4);
+        return blocks * (format == CompressedFormat::BC1 ? 8 : 16);
+    }
+
+    std::vector<uint8_t> TextureCompression::Downsample(const std::vector<uint8_t>& rgba, int width, int height,
+                                                        int& outWidth, int& outHeight) {
+        outWidth = std::max(1, width / 2);
+        outHeight = std::max(1, height / 2);
+
+        // 2x2 box filter (clamped for odd or 1-pixel dimensions)
+        std::vector<uint8_t> result(static_cast<size_t>(outWidth) * outHeight * 4);
+        for (int y = 0; y < outHeight; y++) {
+            int y0 = std::min(y * 2, height - 1);
+            int y1 = std::min(y * 2 + 1, height - 1);
+            for (int x = 0; x < outWidth; x++) {
+                int x0 = std::min(x * 2, width - 1);
+                int x1 = std::min(x * 2 + 1, width - 1);
+                for (int c = 0; c < 4; c++) {
+                    int sum = rgba[(static_cast<size_t>(y0) * width + x0) * 4 + c] +
+                              rgba[(static_cast<size_t>(y0) * width + x1) * 4 + c] +
+                              rgba[(static_cast<size_t>(y1) * width + x0) * 4 + c] +
+                              rgba[(static_cast<size_t>(y1) * width + x1) * 4 + c];
+                    result[(static_cast<size_t>(y) * outWidth + x) * 4 + c] = static_cast<uint8_t>((sum + 2) / 4);
+                }
+            }
+        }
+        return result;
+    }
+
+    bool TextureCompression::SaveKTX(const std::string& path, const CompressedImage& image) {
+        if (image.mips.empty()) {
+            LOG_ERROR("Cannot save empty compressed image: " + path);
+            return false;
+        }
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            LOG_ERROR("Failed to open KTX file for writing: " + path);
+            return false;
+        }
+
+        KTXHeader header = {};
+        header.endianness = KTX_ENDIANNESS;
+        header.glTypeSize = 1;
+        header.glInternalFormat = GetGLInternalFormat(image.format);
+        header.glBaseInternalFormat = image.format == CompressedFormat::BC1 ? KTX_GL_RGB : KTX_GL_RGBA;
+        header.pixelWidth = static_cast<uint32_t>(image.width);
+        header.pixelHeight = static_cast<uint32_t>(image.height);
+        header.numberOfFaces = 1;
+        header.numberOfMipmapLevels = static_cast<uint32_t>(image.mips.size());
+
+        file.write(reinterpret_cast<const char*>(KTX_IDENTIFIER), sizeof(KTX_IDENTIFIER));
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        // Block sizes are multiples of 4 bytes, so no mip padding is needed
+        for (const auto& mip : image.mips) {
+            uint32_t imageSize = static_cast<uint32_t>(mip.data.size());
+            file.write(reinterpret_cast<const char*>(&imageSize), sizeof(imageSize));
+            file.write(reinterpret_cast<const char*>(mip.data.data()), static_cast<std::streamsize>(mip.data.size()));
+        }
+
+        return file.good();
+    }
+
+    bool TextureCompression::LoadKTX(const std::string& path, CompressedImage& image) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        uint8_t identifier[12];
+        KTXHeader header;
+        file.read(reinterpret_cast<char*>(identifier), sizeof(identifier));
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file || std::memcmp(identifier, KTX_IDENTIFIER, sizeof(identifier)) != 0) {
+            LOG_WARNING("Not a KTX file: " + path);
+            return false;
+        }
+
+        if (header.endianness != KTX_ENDIANNESS) {
+            LOG_WARNING("Unsupported KTX endianness: " + path);
+            return false;
+        }
+
+        if (header.glInternalFormat == GetGLInternalFormat(CompressedFormat::BC1)) {
+            image.format = CompressedFormat::BC1;
+        } else if (header.glInternalFormat == GetGLInternalFormat(CompressedFormat::BC3)) {
+            image.format = CompressedFormat::BC3;
+        } else {
+            LOG_WARNING("Unsupported KTX internal format in " + path);
+            return false;
+        }
+
+        if (header.pixelWidth == 0 || header.pixelHeight == 0 || header.pixelDepth > 1 ||
+            header.numberOfArrayElements > 0 || header.numberOfFaces != 1) {
+            LOG_WARNING("Unsupported KTX layout (expected a single 2D texture): " + path);
+            return false;
+        }
+
+        file.seekg(header.bytesOfKeyValueData, std::ios::cur);
+
+        image.width = static_cast<int>(header.pixelWidth);
+        image.height = static_cast<int>(header.pixelHeight);
+        image.mips.clear();
+
+        uint32_t mipCount = std::max(1u, header.numberOfMipmapLevels);
+        int mipWidth = image.width;
+        int mipHeight = image.height;
+        for (uint32_t level = 0; level < mipCount; level++) {
+            uint32_t imageSize = 0;
+            file.read(reinterpret_cast<char*>(&imageSize), sizeof(imageSize));
+
+            CompressedMip mip;
+            mip.width = mipWidth;
+            mip.height = mipHeight;
+            if (!file || imageSize != GetMipSize(image.format, mipWidth, mipHeight)) {
+                LOG_WARNING("Truncated or corrupt KTX mip " + std::to_string(level) + " in " + path);
+                return false;
+            }
+
+            mip.data.resize(imageSize);
+            file.read(reinterpret_cast<char*>(mip.data.data()), imageSize);
+            if (!file) {
+                LOG_WARNING("Truncated KTX data in " + path);
+                return false;
+            }
+
+            image.mips.push_back(std::move(mip));
+            mipWidth = std::max(1, mipWidth / 2);
+            mipHeight = std::max(1, mipHeight / 2);
+        }
+
+        return true;
+    }
+
+    std::string TextureCompression::GetCompressedPath(const std::string& imagePath) {
+        return std::filesystem::path(imagePath).replace_extension(".ktx").string();
+    }
+
+    bool TextureCompression::HasUpToDateCompressed(const std::string& imagePath) {
+        std::error_code error;
+        std::filesystem::path compressedPath = GetCompressedPath(imagePath);
+        if (!std::filesystem::exists(compressedPath, error)) {
+            return false;
+        }
+
+        // No source image: the compressed file is all there is
+        if (!std::filesystem::exists(imagePath, error)) {
+            return true;
+        }
+
+        auto sourceTime = std::filesystem::last_write_time(imagePath, error);
+        if (error) return true;
+        auto compressedTime = std::filesystem::last_write_time(compressedPath, error);
+        if (error) return false;
+
+        return compressedTime >= sourceTime;
+    }
+
+    unsigned int TextureCompression::GetGLInternalFormat(CompressedFormat format) {
+        return format == CompressedFormat::BC1 ? GL_BC1_RGB : GL_BC3_RGBA;
+    }
+
+} // namespace VibeReaper
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace VibeReaper {
+
+    // Block-compressed formats produced by the offline texture compiler
+    enum class CompressedFormat {
+        BC1,    // DXT1: opaque RGB, 8 bytes per 4x4 block
+        BC3     // DXT5: RGBA, 16 bytes per 4x4 block
+    };
+
+    struct CompressedMip {
+        int width = 0;
+        int height = 0;
+        std::vector<uint8_t> data;
+    };
+
+    // A full mip chain of block-compressed data, level 0 first
+    struct CompressedImage {
+        CompressedFormat format = CompressedFormat::BC1;
+        int width = 0;
+        int height = 0;
+        std::vector<CompressedMip> mips;
+
+        size_t GetDataSize() const;
+    };
+
+    /**
+     * @brief BC1/BC3 encoding and KTX (version 1) container I/O
+     *
+     * Encoding runs offline in tools/TextureCompiler; the runtime only reads KTX
+     * files and hands the mips to glCompressedTexImage2D. Pixels are expected in
+     * the same orientation Texture::DecodeImage returns (bottom-left origin), so
+     * compressed and PNG textures look identical.
+     */
+    class TextureCompression {
+    public:
+        // Compress RGBA8 pixels, generating the full mip chain (box filter) down to 1x1
+        static CompressedImage Compress(const uint8_t* rgba, int width, int height, CompressedFormat format);
+
+        // BC3 if any pixel is not fully opaque, BC1 otherwise
+        static CompressedFormat ChooseFormat(const uint8_t* rgba, int width, int height);
+
+        // Encode a single 4x4 RGBA block (64 bytes in) into 8 (BC1) or 16 (BC3) bytes
+        static void EncodeBC1Block(const uint8_t* block, uint8_t* out);
+        static void EncodeBC3Block(const uint8_t* block, uint8_t* out);
+
+        // Bytes of compressed data for one mip level
+        static size_t GetMipSize(CompressedFormat format, int width, int height);
+
+        // KTX container (thread-safe, no GL calls)
+        static bool SaveKTX(const std::string& path, const CompressedImage& image);
+        static bool LoadKTX(const std::string& path, CompressedImage& image);
+
+        // KTX path that sits next to a source image (foo.png -> foo.ktx)
+        static std::string GetCompressedPath(const std::string& imagePath);
+
+        // True if a compressed file exists and is not older than its source image
+        static bool HasUpToDateCompressed(const std::string& imagePath);
+
+        // GL internal format enum for a compressed format
+        static unsigned int GetGLInternalFormat(CompressedFormat format);
+
+    private:
+        static std::vector<uint8_t> Downsample(const std::vector<uint8_t>& rgba, int width, int height,
+                                               int& outWidth, int& outHeight);
+        static void EncodeColorBlock(const uint8_t* block, uint8_t* out);
+        static void EncodeAlphaBlock(const uint8_t* block, uint8_t* out);
+    };
+
+} // namespace VibeReaper
@@ -0,0 +1,311 @@
+#include "TextureLoader.h"
+#include "../Utils/Logger.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace VibeReaper {
+
+    namespace {
+        double ElapsedMs(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    TextureLoader::TextureLoader(unsigned int threadCount)
+        : stopping(false), pendingCount(0), generation(0),
+          usePixelBuffers(false), pixelBuffer(0) {
+
+        if (threadCount == 0) {
+            unsigned int hardwareThreads = std::thread::hardware_concurrency();
+            threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        }
+
+        for (unsigned int i = 0; i < threadCount; i++) {
+            workers.emplace_back(&TextureLoader::WorkerLoop, this);
+        }
+
+        LOG_INFO("TextureLoader started with " + std::to_string(threadCount) + " decode threads");
+    }
+
+    TextureLoader::~TextureLoader() {
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            stopping = true;
+        }
+        jobAvailable.notify_all();
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        // Free anything decoded but never uploaded
+        for (auto& image : finished) {
+            Texture::FreeImage(image.pixels);
+        }
+        finished.clear();
+
+        if (pixelBuffer != 0) {
+            glDeleteBuffers(1, &pixelBuffer);
+            pixelBuffer = 0;
+        }
+    }
+
+    void TextureLoader::Request(const std::string& path, Texture* target, UploadCallback onUploaded,
+                                bool createPlaceholder) {
+        if (!target) return;
+
+        // Placeholder until the real image arrives
+        if (createPlaceholder) {
+            target->CreateWhiteTexture();
+        }
+
+        // Compression support needs GL, so it's resolved here rather than on the worker
+        Enqueue({ path, target, nullptr, std::move(onUploaded), generation.load(), Texture::IsCompressionSupported() });
+    }
+
+    void TextureLoader::Request(const std::string& path, PixelCallback onDecoded) {
+        if (!onDecoded) return;
+
+        // Callbacks always get plain pixels
+        Enqueue({ path, nullptr, std::move(onDecoded), nullptr, generation.load(), false });
+    }
+
+    void TextureLoader::Enqueue(DecodeJob job) {
+        pendingCount++;
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            jobQueue.push_back(std::move(job));
+        }
+        jobAvailable.notify_one();
+    }
+
+    void TextureLoader::WorkerLoop() {
+        while (true) {
+            DecodeJob job;
+            {
+                std::unique_lock<std::mutex> lock(jobMutex);
+                jobAvailable.wait(lock, [this] { return stopping || !jobQueue.empty(); });
+                if (stopping) return;
+
+                job = std::move(jobQueue.front());
+                jobQueue.pop_front();
+            }
+
+            DecodedImage image;
+            image.onDecoded = std::move(job.onDecoded);
+            image.onUploaded = std::move(job.onUploaded);
+            Decode(job, image);
+
+            {
+                std::lock_guard<std::mutex> lock(finishedMutex);
+                finished.push_back(std::move(image));
+            }
+            finishedAvailable.notify_all();
+        }
+    }
+
+    void TextureLoader::Decode(const DecodeJob& job, DecodedImage& image) {
+        auto start = std::chrono::steady_clock::now();
+
+        image.path = job.path;
+        image.target = job.target;
+        image.generation = job.generation;
+        image.pixels = nullptr;
+        image.width = image.height = image.channels = 0;
+
+        // Prefer precompressed mips; a missing, stale or broken .ktx falls back to the image
+        if (job.tryCompressed && TextureCompression::HasUpToDateCompressed(job.path)) {
+            if (!TextureCompression::LoadKTX(TextureCompression::GetCompressedPath(job.path), image.compressed)) {
+                image.compressed = CompressedImage();
+            }
+        }
+
+        if (image.compressed.mips.empty()) {
+            image.pixels = Texture::DecodeImage(job.path, image.width, image.height, image.channels);
+        } else {
+            image.width = image.compressed.width;
+            image.height = image.compressed.height;
+        }
+
+        image.decodeMs = ElapsedMs(start);
+    }
+
+    int TextureLoader::ProcessUploads(int maxUploads) {
+        std::vector<DecodedImage> ready;
+        {
+            std::lock_guard<std::mutex> lock(finishedMutex);
+            if (finished.empty()) return 0;
+
+            size_t count = finished.size();
+            if (maxUploads >= 0) {
+                count = std::min(count, static_cast<size_t>(maxUploads));
+            }
+
+            ready.assign(std::make_move_iterator(finished.begin()),
+                         std::make_move_iterator(finished.begin() + count));
+            finished.erase(finished.begin(), finished.begin() + count);
+        }
+
+        int uploaded = 0;
+        for (auto& image : ready) {
+            if (image.generation == generation.load()) {
+                Upload(image);
+                uploaded++;
+            }
+            Texture::FreeImage(image.pixels);
+            pendingCount--;
+        }
+
+        return uploaded;
+    }
+
+    bool TextureLoader::LoadSync(const std::string& path, Texture* target) {
+        if (!target) return false;
+
+        DecodedImage image;
+        Decode({ path, target, nullptr, nullptr, generation.load(), Texture::IsCompressionSupported() }, image);
+
+        bool success = Upload(image);
+        Texture::FreeImage(image.pixels);
+        return success;
+    }
+
+    bool TextureLoader::Upload(DecodedImage& image) {
+        if (image.onDecoded) {
+            if (!image.pixels) {
+                LOG_WARNING("Failed to decode texture: " + image.path);
+                stats.texturesFailed++;
+                image.onDecoded(nullptr, 0, 0, 0);
+                return false;
+            }
+
+            // Consumer does its own GL work (or none); time it as upload
+            auto start = std::chrono::steady_clock::now();
+            image.onDecoded(image.pixels, image.width, image.height, image.channels);
+            stats.texturesLoaded++;
+            stats.decodeMs += image.decodeMs;
+            stats.uploadMs += ElapsedMs(start);
+            LOG_INFO("Texture decoded: " + image.path + " (" + std::to_string(image.width) + "x" +
+                     std::to_string(image.height) + ", decode " + std::to_string(image.decodeMs) + " ms)");
+            return true;
+        }
+
+        bool success = UploadTexture(image);
+        if (image.onUploaded) {
+            image.onUploaded(success);
+        }
+        return success;
+    }
+
+    bool TextureLoader::UploadTexture(DecodedImage& image) {
+        if (!image.compressed.mips.empty()) {
+            auto start = std::chrono::steady_clock::now();
+            bool hadPlaceholder = image.target->IsLoaded();
+            if (image.target->UploadCompressed(image.compressed)) {
+                double uploadMs = ElapsedMs(start);
+                stats.texturesLoaded++;
+                stats.texturesCompressed++;
+                stats.decodeMs += image.decodeMs;
+                stats.uploadMs += uploadMs;
+
+                LOG_INFO("Texture loaded: " + image.path + " (" + std::to_string(image.width) + "x" +
+                         std::to_string(image.height) + ", " + std::to_string(image.compressed.mips.size()) +
+                         " compressed mips, read " + std::to_string(image.decodeMs) + " ms, upload " +
+                         std::to_string(uploadMs) + " ms)");
+                return true;
+            }
+
+            // Rejected by the driver: decode the source image here instead
+            LOG_WARNING("Compressed upload failed for " + image.path + ", decoding source image");
+            image.compressed = CompressedImage();
+            image.pixels = Texture::DecodeImage(image.path, image.width, image.height, image.channels);
+            if (hadPlaceholder) {
+                image.target->CreateWhiteTexture();
+            }
+        }
+
+        if (!image.pixels) {
+            LOG_WARNING("Failed to decode texture: " + image.path + ", keeping placeholder");
+            stats.texturesFailed++;
+            return false;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        size_t size = static_cast<size_t>(image.width) * image.height * image.channels;
+        bool staged = false;
+
+        if (usePixelBuffers) {
+            if (pixelBuffer == 0) {
+                glGenBuffers(1, &pixelBuffer);
+            }
+
+            // Orphan the previous storage so the driver doesn't wait on the last upload
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_DRAW);
+
+            void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(size),
+                                            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+            if (mapped) {
+                std::memcpy(mapped, image.pixels, size);
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+                staged = true;
+            } else {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            }
+        }
+
+        // With a bound unpack buffer the data pointer is an offset into it
+        image.target->UploadPixels(staged ? nullptr : image.pixels, image.width, image.height, image.channels);
+
+        if (staged) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+
+        double uploadMs = ElapsedMs(start);
+        stats.texturesLoaded++;
+        stats.decodeMs += image.decodeMs;
+        stats.uploadMs += uploadMs;
+
+        LOG_INFO("Texture loaded: " + image.path + " (" + std::to_string(image.width) + "x" +
+                 std::to_string(image.height) + ", " + std::to_string(image.channels) + " channels, decode " +
+                 std::to_string(image.decodeMs) + " ms, upload " + std::to_string(uploadMs) + " ms)");
+        return true;
+    }
+
+    void TextureLoader::WaitAll() {
+        while (pendingCount.load() > 0) {
+            {
+                std::unique_lock<std::mutex> lock(finishedMutex);
+                finishedAvailable.wait(lock, [this] { return !finished.empty(); });
+            }
+            ProcessUploads();
+        }
+    }
+
+    void TextureLoader::CancelAll() {
+        // Bump the generation so in-flight decodes are discarded instead of uploaded
+        generation++;
+
+        size_t dropped = 0;
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            dropped = jobQueue.size();
+            jobQueue.clear();
+        }
+        pendingCount -= dropped;
+
+        // Finished images are freed now; in-flight ones are freed by the next ProcessUploads
+        std::vector<DecodedImage> stale;
+        {
+            std::lock_guard<std::mutex> lock(finishedMutex);
+            stale.swap(finished);
+        }
+        for (auto& image : stale) {
+            Texture::FreeImage(image.pixels);
+            pendingCount--;
+        }
+    }
+
+} // namespace VibeReaper
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "Texture.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <cstddef>
+
+namespace VibeReaper {
+
+    // Aggregate timings for textures loaded through a TextureLoader
+    struct TextureLoadStats {
+        int texturesLoaded = 0;
+        int texturesFailed = 0;
+        int texturesCompressed = 0;  // Loaded from precompressed .ktx mips
+        double decodeMs = 0.0;   // Sum of worker decode time
+        double uploadMs = 0.0;   // Sum of GL-thread upload time
+    };
+
+    // Receives decoded pixels on the GL thread (pixels is nullptr if decoding failed)
+    using PixelCallback = std::function<void(const unsigned char* pixels, int width, int height, int channels)>;
+
+    // Runs on the GL thread once a Texture request has been uploaded (or failed)
+    using UploadCallback = std::function<void(bool success)>;
+
+    /**
+     * @brief Decodes textures on worker threads and uploads them on the GL thread
+     *
+     * Request() puts a 1x1 placeholder into the target texture and queues the file
+     * for decoding. Workers run stb_image in parallel while the caller continues
+     * (e.g. with map parsing and brush conversion). When an up-to-date .ktx sits
+     * next to the image and the driver supports it, workers read its compressed
+     * mips instead and the upload skips decoding and mip generation entirely. ProcessUploads() must be called
+     * from the thread owning the GL context; it uploads finished images, optionally
+     * staging them through a pixel buffer object.
+     *
+     * Target textures must stay at a stable address until their upload completes
+     * or CancelAll() is called.
+     */
+    class TextureLoader {
+    public:
+        // threadCount 0 = hardware concurrency - 1 (at least 1)
+        explicit TextureLoader(unsigned int threadCount = 0);
+        ~TextureLoader();
+
+        TextureLoader(const TextureLoader&) = delete;
+        TextureLoader& operator=(const TextureLoader&) = delete;
+
+        // Queue a texture for asynchronous loading (GL thread: creates the placeholder
+        // unless the caller supplies its own fallback). Cancelled requests never call onUploaded.
+        void Request(const std::string& path, Texture* target, UploadCallback onUploaded = nullptr,
+                     bool createPlaceholder = true);
+
+        // Queue a decode whose pixels are handed to a callback instead of a Texture
+        // (e.g. to fill a texture array layer). Called from ProcessUploads().
+        void Request(const std::string& path, PixelCallback onDecoded);
+
+        // Decode and upload on the calling thread with the same timing stats (GL thread)
+        bool LoadSync(const std::string& path, Texture* target);
+
+        // Upload finished decodes (GL thread). maxUploads < 0 means no limit.
+        // Returns the number of textures uploaded.
+        int ProcessUploads(int maxUploads = -1);
+
+        // Block until every queued texture is decoded and uploaded (GL thread)
+        void WaitAll();
+
+        // Drop all queued and finished work; targets keep their placeholder
+        void CancelAll();
+
+        // Number of requests not yet uploaded
+        size_t GetPendingCount() const { return pendingCount.load(); }
+        bool IsIdle() const { return pendingCount.load() == 0; }
+
+        // Stage uploads through a pixel buffer object instead of client memory
+        void SetUsePixelBuffers(bool enabled) { usePixelBuffers = enabled; }
+
+        const TextureLoadStats& GetStats() const { return stats; }
+        void ResetStats() { stats = TextureLoadStats(); }
+
+        unsigned int GetThreadCount() const { return static_cast<unsigned int>(workers.size()); }
+
+    private:
+        struct DecodeJob {
+            std::string path;
+            Texture* target;
+            PixelCallback onDecoded;
+            UploadCallback onUploaded;
+            unsigned int generation;
+            bool tryCompressed;
+        };
+
+        struct DecodedImage {
+            std::string path;
+            Texture* target;
+            PixelCallback onDecoded;
+            UploadCallback onUploaded;
+            unsigned int generation;
+            CompressedImage compressed;     // Used instead of pixels when it has mips
+            unsigned char* pixels;
+            int width, height, channels;
+            double decodeMs;
+        };
+
+        // Worker threads
+        std::vector<std::thread> workers;
+        bool stopping;
+
+        // Decode queue (main -> workers)
+        std::deque<DecodeJob> jobQueue;
+        std::mutex jobMutex;
+        std::condition_variable jobAvailable;
+
+        // Finished decodes (workers -> main)
+        std::vector<DecodedImage> finished;
+        std::mutex finishedMutex;
+        std::condition_variable finishedAvailable;
+
+        std::atomic<size_t> pendingCount;
+        std::atomic<unsigned int> generation;
+
+        // Upload state (GL thread only)
+        bool usePixelBuffers;
+        unsigned int pixelBuffer;
+        TextureLoadStats stats;
+
+        void Enqueue(DecodeJob job);
+        void WorkerLoop();
+        static void Decode(const DecodeJob& job, DecodedImage& image);
+        bool Upload(DecodedImage& image);
+        bool UploadTexture(DecodedImage& image);
+    };
+
+} // namespace VibeReaper
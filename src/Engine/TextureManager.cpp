@@ -0,0 +1,299 @@
+#include "TextureManager.h"
+#include "../Utils/Logger.h"
+#include <utility>
+
+namespace VibeReaper {
+
+    // ========================================================================
+    // TextureHandle
+    // ========================================================================
+
+    TextureHandle::TextureHandle(TextureManager* manager, TextureEntry* entry)
+        : manager(manager), entry(entry) {
+        if (manager && entry) {
+            manager->AddRef(entry);
+        }
+    }
+
+    TextureHandle::TextureHandle(const TextureHandle& other)
+        : TextureHandle(other.manager, other.entry) {
+    }
+
+    TextureHandle::TextureHandle(TextureHandle&& other) noexcept
+        : manager(other.manager), entry(other.entry) {
+        other.manager = nullptr;
+        other.entry = nullptr;
+    }
+
+    TextureHandle& TextureHandle::operator=(const TextureHandle& other) {
+        if (this != &other) {
+            // AddRef first so self-aliasing entries survive the release
+            if (other.manager && other.entry) {
+                other.manager->AddRef(other.entry);
+            }
+            Reset();
+            manager = other.manager;
+            entry = other.entry;
+        }
+        return *this;
+    }
+
+    TextureHandle& TextureHandle::operator=(TextureHandle&& other) noexcept {
+        if (this != &other) {
+            Reset();
+            manager = other.manager;
+            entry = other.entry;
+            other.manager = nullptr;
+            other.entry = nullptr;
+        }
+        return *this;
+    }
+
+    TextureHandle::~TextureHandle() {
+        Reset();
+    }
+
+    Texture* TextureHandle::Get() const {
+        if (!manager || !entry) return nullptr;
+        if (entry->texture.IsLoaded()) {
+            return &entry->texture;
+        }
+        return manager->GetFallback();
+    }
+
+    void TextureHandle::Reset() {
+        if (manager && entry) {
+            TextureManager* owner = manager;
+            TextureEntry* released = entry;
+            manager = nullptr;
+            entry = nullptr;
+            owner->Release(released);
+        }
+    }
+
+    bool TextureHandle::IsResident() const {
+        return entry && entry->texture.IsLoaded();
+    }
+
+    const std::string& TextureHandle::GetPath() const {
+        static const std::string empty;
+        return entry ? entry->path : empty;
+    }
+
+    // ========================================================================
+    // TextureManager
+    // ========================================================================
+
+    TextureManager::TextureManager(TextureLoader& loader, size_t budgetBytes)
+        : loader(loader), budgetBytes(budgetBytes), externalBytes(0), useTick(0),
+          cacheHits(0), cacheMisses(0), evictions(0), warnedOverBudget(false) {
+    }
+
+    TextureManager::~TextureManager() {
+        // Pending loads hold pointers into our entries and a callback into us
+        for (const auto& pair : entries) {
+            if (pair.second->pending) {
+                loader.CancelAll();
+                break;
+            }
+        }
+
+        for (const auto& pair : entries) {
+            if (pair.second->refCount > 0) {
+                LOG_WARNING("TextureManager destroyed with live handle to " + pair.first);
+            }
+        }
+    }
+
+    TextureHandle TextureManager::Acquire(const std::string& path, bool async) {
+        auto it = entries.find(path);
+        if (it != entries.end()) {
+            TextureEntry& entry = *it->second;
+
+            // Loaded, loading or known-missing: all reusable without touching the disk
+            if (entry.texture.IsLoaded() || entry.pending || entry.failed) {
+                cacheHits++;
+            } else {
+                // Load was cancelled by a map change
+                cacheMisses++;
+                Load(entry, async);
+            }
+            return TextureHandle(this, &entry);
+        }
+
+        cacheMisses++;
+        auto inserted = entries.emplace(path, std::make_unique<TextureEntry>());
+        TextureEntry& entry = *inserted.first->second;
+        entry.path = path;
+        Load(entry, async);
+        return TextureHandle(this, &entry);
+    }
+
+    bool TextureManager::Reload(const std::string& path) {
+        auto it = entries.find(path);
+        if (it == entries.end()) {
+            return false;
+        }
+
+        TextureEntry& entry = *it->second;
+        if (entry.refCount == 0 && !entry.pending) {
+            entries.erase(it);
+            return false;
+        }
+
+        // A queued load reads the file after this change anyway
+        if (!entry.pending) {
+            Load(entry, true);
+        }
+        return true;
+    }
+
+    void TextureManager::Load(TextureEntry& entry, bool async) {
+        entry.failed = false;
+
+        if (!async) {
+            entry.failed = !loader.LoadSync(entry.path, &entry.texture);
+            if (entry.failed) {
+                LOG_WARNING("Failed to load texture: " + entry.path + ", using fallback");
+            }
+            EnforceBudget();
+            return;
+        }
+
+        // No per-texture placeholder; handles return the shared fallback until uploaded
+        entry.pending = true;
+        TextureEntry* target = &entry;
+        loader.Request(entry.path, &entry.texture, [this, target](bool success) {
+            target->pending = false;
+            target->failed = !success;
+            EnforceBudget();
+        }, false);
+    }
+
+    Texture* TextureManager::GetFallback() {
+        if (!fallback.IsLoaded()) {
+            fallback.CreateWhiteTexture();
+        }
+        return &fallback;
+    }
+
+    void TextureManager::ResetPendingLoads() {
+        for (auto& pair : entries) {
+            pair.second->pending = false;
+        }
+    }
+
+    void TextureManager::SetBudget(size_t bytes) {
+        budgetBytes = bytes;
+        warnedOverBudget = false;
+        EnforceBudget();
+    }
+
+    void TextureManager::SetExternalBytes(size_t bytes) {
+        externalBytes = bytes;
+        EnforceBudget();
+    }
+
+    void TextureManager::EnforceBudget() {
+        while (GetResidentBytes() + externalBytes > budgetBytes) {
+            if (!EvictOne()) {
+                if (!warnedOverBudget) {
+                    LOG_WARNING("Texture memory " + std::to_string((GetResidentBytes() + externalBytes) / (1024 * 1024)) +
+                                " MB (" + std::to_string(externalBytes / (1024 * 1024)) + " MB material arrays)" +
+                                " exceeds budget of " + std::to_string(budgetBytes / (1024 * 1024)) +
+                                " MB, but every resident texture is in use");
+                    warnedOverBudget = true;
+                }
+                return;
+            }
+        }
+        warnedOverBudget = false;
+    }
+
+    void TextureManager::EvictUnused() {
+        for (auto it = entries.begin(); it != entries.end();) {
+            if (it->second->refCount == 0 && !it->second->pending) {
+                evictions++;
+                it = entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    bool TextureManager::EvictOne() {
+        auto victim = entries.end();
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            const TextureEntry& entry = *it->second;
+            if (entry.refCount > 0 || entry.pending || entry.texture.GetMemoryBytes() == 0) continue;
+            if (victim == entries.end() || entry.lastUsed < victim->second->lastUsed) {
+                victim = it;
+            }
+        }
+
+        if (victim == entries.end()) {
+            return false;
+        }
+
+        LOG_INFO("Evicting texture " + victim->first + " (" +
+                 std::to_string(victim->second->texture.GetMemoryBytes() / 1024) + " KB)");
+        entries.erase(victim);
+        evictions++;
+        return true;
+    }
+
+    void TextureManager::AddRef(TextureEntry* entry) {
+        entry->refCount++;
+        entry->lastUsed = ++useTick;
+    }
+
+    void TextureManager::Release(TextureEntry* entry) {
+        entry->refCount--;
+        entry->lastUsed = ++useTick;
+        if (entry->refCount == 0) {
+            EnforceBudget();
+        }
+    }
+
+    size_t TextureManager::GetResidentBytes() const {
+        size_t total = 0;
+        for (const auto& pair : entries) {
+            total += pair.second->texture.GetMemoryBytes();
+        }
+        return total;
+    }
+
+    TextureManagerStats TextureManager::GetStats() const {
+        TextureManagerStats stats;
+        stats.budgetBytes = budgetBytes;
+        stats.externalBytes = externalBytes;
+        stats.cacheHits = cacheHits;
+        stats.cacheMisses = cacheMisses;
+        stats.evictions = evictions;
+        for (const auto& pair : entries) {
+            const TextureEntry& entry = *pair.second;
+            stats.residentBytes += entry.texture.GetMemoryBytes();
+            if (entry.texture.IsLoaded()) stats.residentCount++;
+            if (entry.refCount > 0) stats.referencedCount++;
+        }
+        return stats;
+    }
+
+    void TextureManager::LogResidency() const {
+        TextureManagerStats stats = GetStats();
+        LOG_INFO("Texture residency: " + std::to_string(stats.residentCount) + " resident, " +
+                 std::to_string(stats.referencedCount) + " referenced, " +
+                 std::to_string(stats.residentBytes / 1024) + " KB + " + std::to_string(stats.externalBytes / 1024) +
+                 " KB material arrays / " + std::to_string(stats.budgetBytes / 1024) + " KB, " +
+                 std::to_string(stats.cacheHits) + " hits, " + std::to_string(stats.cacheMisses) + " misses, " + std::to_string(stats.evictions) + " evictions");
+
+        for (const auto& pair : entries) {
+            const TextureEntry& entry = *pair.second;
+            std::string state = entry.pending ? "loading" : (entry.failed ? "missing" : "resident");
+            LOG_DEBUG("  " + pair.first + ": " + std::to_string(entry.texture.GetMemoryBytes() / 1024) + " KB, " +
+                      std::to_string(entry.refCount) + " refs, " + state +
+                      (entry.texture.IsCompressed() ? ", compressed" : ""));
+        }
+    }
+
+} // namespace VibeReaper
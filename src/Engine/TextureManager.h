@@ -0,0 +1,146 @@
+#pragma once
+
+#include "Texture.h"
+#include "TextureLoader.h"
+#include <string>
+#include <map>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace VibeReaper {
+
+    class TextureManager;
+
+    // One cached texture (owned by TextureManager, stable address)
+    struct TextureEntry {
+        std::string path;
+        Texture texture;
+        int refCount = 0;
+        uint64_t lastUsed = 0;      // Use tick for LRU ordering
+        bool pending = false;       // Queued in the TextureLoader, must not be evicted
+        bool failed = false;        // Source missing/undecodable, fallback is used
+    };
+
+    /**
+     * @brief Reference-counted handle to a managed texture
+     *
+     * Get() always returns something bindable: the real texture once it is
+     * resident, otherwise the manager's single shared fallback. Handles must not
+     * outlive their TextureManager.
+     */
+    class TextureHandle {
+    public:
+        TextureHandle() : manager(nullptr), entry(nullptr) {}
+        TextureHandle(const TextureHandle& other);
+        TextureHandle(TextureHandle&& other) noexcept;
+        TextureHandle& operator=(const TextureHandle& other);
+        TextureHandle& operator=(TextureHandle&& other) noexcept;
+        ~TextureHandle();
+
+        // Texture to bind (shared fallback while loading or if loading failed)
+        Texture* Get() const;
+
+        // Drop the reference (the texture stays cached until evicted)
+        void Reset();
+
+        bool IsValid() const { return entry != nullptr; }
+        bool IsResident() const;
+        const std::string& GetPath() const;
+
+    private:
+        friend class TextureManager;
+        TextureHandle(TextureManager* manager, TextureEntry* entry);
+
+        TextureManager* manager;
+        TextureEntry* entry;
+    };
+
+    struct TextureManagerStats {
+        size_t residentBytes = 0;
+        size_t externalBytes = 0;   // Charged from outside the cache (SetExternalBytes)
+        size_t budgetBytes = 0;
+        int residentCount = 0;      // Entries with GPU storage
+        int referencedCount = 0;    // Entries with live handles
+        int cacheHits = 0;          // Acquire() found the texture already cached
+        int cacheMisses = 0;
+        int evictions = 0;
+    };
+
+    /**
+     * @brief Texture cache with a VRAM budget and LRU eviction
+     *
+     * Acquire() returns a handle to a cached texture, loading it (async through
+     * the given TextureLoader, or synchronously) on a miss. Textures stay cached
+     * after their last handle is released, so a level that reuses textures from
+     * the previous one finds them resident. Once resident memory plus external
+     * memory (e.g. the world's material arrays) exceeds the budget, the least
+     * recently used unreferenced textures are evicted; textures with live handles
+     * or pending loads are never evicted, and neither is external memory.
+     *
+     * All methods must be called from the GL thread.
+     */
+    class TextureManager {
+    public:
+        static constexpr size_t DEFAULT_BUDGET_BYTES = 256 * 1024 * 1024;
+
+        explicit TextureManager(TextureLoader& loader, size_t budgetBytes = DEFAULT_BUDGET_BYTES);
+        ~TextureManager();
+
+        TextureManager(const TextureManager&) = delete;
+        TextureManager& operator=(const TextureManager&) = delete;
+
+        // Get a handle to a texture, loading it on a cache miss
+        TextureHandle Acquire(const std::string& path, bool async = true);
+
+        // Single fallback used for every missing or still-loading texture
+        Texture* GetFallback();
+
+        // Source file changed (hot reload): referenced textures are decoded again and
+        // swapped in on upload, keeping the old image bound until then; unreferenced
+        // ones are dropped so the next Acquire() reads the new file. False if not cached.
+        bool Reload(const std::string& path);
+
+        // Call after TextureLoader::CancelAll(): cancelled loads are re-requested on next Acquire()
+        void ResetPendingLoads();
+
+        // Budget (evicts immediately if the new budget is exceeded)
+        void SetBudget(size_t bytes);
+        size_t GetBudget() const { return budgetBytes; }
+
+        // GPU memory owned elsewhere that shares the budget (replaces the previous amount)
+        void SetExternalBytes(size_t bytes);
+        size_t GetExternalBytes() const { return externalBytes; }
+
+        // Evict unreferenced textures (LRU first) until resident plus external memory fits the budget
+        void EnforceBudget();
+
+        // Evict every unreferenced texture
+        void EvictUnused();
+
+        TextureManagerStats GetStats() const;
+        size_t GetResidentBytes() const;
+
+        // Log every cached texture with its memory and reference count
+        void LogResidency() const;
+
+    private:
+        friend class TextureHandle;
+
+        TextureLoader& loader;
+        std::map<std::string, std::unique_ptr<TextureEntry>> entries;
+        Texture fallback;
+        size_t budgetBytes;
+        size_t externalBytes;
+        uint64_t useTick;
+        int cacheHits, cacheMisses, evictions;
+        bool warnedOverBudget;
+
+        void Load(TextureEntry& entry, bool async);
+        void AddRef(TextureEntry* entry);
+        void Release(TextureEntry* entry);
+        bool EvictOne();
+    };
+
+} // namespace VibeReaper
@@ -0,0 +1,673 @@
+#include "Visibility.h"
+#include "BrushConverter.h"
+#include "../Utils/Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <queue>
+#include <thread>
+
+namespace VibeReaper {
+
+    namespace {
+        const char PVS_MAGIC[4] = { 'V', 'P', 'V', 'S' };
+        const uint32_t PVS_VERSION = 2;
+
+        // Points this close outside a brush still count as inside. Map planes come from
+        // three integer points, so faces on a split plane miss it by float error.
+        const float CONTAINMENT_EPSILON = 0.01f;
+
+        // Brush face coordinates are rounded to 1/SPLIT_SNAP units before becoming split
+        // planes, so faces computed separately for touching brushes share one plane
+        const float SPLIT_SNAP = 128.0f;
+
+        // A split plane closer than this to an existing one is dropped
+        const float MIN_SPLIT_SPACING = 1.0f;
+
+        // Slack on the hull test; including an extra leaf only costs culling
+        const float HULL_EPSILON = 0.01f;
+
+        const long long MAX_FILE_LEAVES = 1 << 20;   // In a .pvs file; anything larger is corruption
+
+        struct Occluder {
+            AABB bounds;
+            std::vector<Plane> planes;
+        };
+
+        // Brushes are convex, so a box (or a face, with one axis flat) is inside when its corners are
+        bool ContainsBox(const Occluder& occluder, const glm::vec3& bmin, const glm::vec3& bmax) {
+            for (int corner = 0; corner < 8; corner++) {
+                glm::vec3 point((corner & 1) ? bmax.x : bmin.x, (corner & 2) ? bmax.y : bmin.y,
+                                (corner & 4) ? bmax.z : bmin.z);
+                if (!BrushConverter::IsPointInsideBrush(point, occluder.planes, CONTAINMENT_EPSILON)) return false;
+            }
+            return true;
+        }
+
+        // Cells (between consecutive boundaries) overlapping [lo, hi]; false if none
+        bool CellRange(const std::vector<float>& bounds, float lo, float hi, int& first, int& last) {
+            if (hi < bounds.front() || lo > bounds.back()) return false;
+            first = static_cast<int>(std::lower_bound(bounds.begin() + 1, bounds.end() - 1, lo) - (bounds.begin() + 1));
+            last = static_cast<int>(std::upper_bound(bounds.begin() + 1, bounds.end() - 1, hi) - (bounds.begin() + 1));
+            return first <= last;
+        }
+
+        // Narrow [t0, t1] to where p + q * t <= r
+        void ClipLinear(float p, float q, float r, float& t0, float& t1) {
+            r += HULL_EPSILON;
+            if (q > 0.0f) {
+                t1 = std::min(t1, (r - p) / q);
+            } else if (q < 0.0f) {
+                t0 = std::max(t0, (r - p) / q);
+            } else if (p > r) {
+                t0 = 2.0f;
+            }
+        }
+
+        long long CountLeaves(const std::vector<float> splits[3], int growAxis) {
+            long long count = 1;
+            for (int axis = 0; axis < 3; axis++) {
+                count *= static_cast<long long>(splits[axis].size()) - 1 + (axis == growAxis ? 1 : 0);
+            }
+            return count;
+        }
+
+        // True if position was added (it is not within MIN_SPLIT_SPACING of an existing split)
+        bool InsertSplit(std::vector<float>& bounds, float position) {
+            auto it = std::lower_bound(bounds.begin(), bounds.end(), position);
+            if (it != bounds.end() && *it - position < MIN_SPLIT_SPACING) return false;
+            if (it != bounds.begin() && position - *(it - 1) < MIN_SPLIT_SPACING) return false;
+            bounds.insert(it, position);
+            return true;
+        }
+
+        // Brush faces first, heaviest (largest bounds face area) first, then halve the
+        // longest leaves. Faces smaller than a leaf's face are not worth a split.
+        void ChooseSplits(const std::vector<Occluder>& occluders, const AABB& world, const VisibilitySettings& settings,
+                          float leafSize, std::vector<float> splits[3]) {
+            struct Candidate {
+                float weight;
+                int axis;
+                float position;
+            };
+
+            std::map<float, float> weights[3];
+            for (const Occluder& occluder : occluders) {
+                glm::vec3 size = occluder.bounds.GetSize();
+                for (int axis = 0; axis < 3; axis++) {
+                    float area = size[(axis + 1) % 3] * size[(axis + 2) % 3];
+                    weights[axis][std::round(occluder.bounds.min[axis] * SPLIT_SNAP) / SPLIT_SNAP] += area;
+                    weights[axis][std::round(occluder.bounds.max[axis] * SPLIT_SNAP) / SPLIT_SNAP] += area;
+                }
+            }
+
+            std::vector<Candidate> candidates;
+            for (int axis = 0; axis < 3; axis++) {
+                splits[axis] = { world.min[axis], world.max[axis] };
+                for (const auto& entry : weights[axis]) {
+                    if (entry.second >= leafSize * leafSize) {
+                        candidates.push_back({ entry.second, axis, entry.first });
+                    }
+                }
+            }
+            std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+                if (a.weight != b.weight) return a.weight > b.weight;
+                if (a.axis != b.axis) return a.axis < b.axis;
+                return a.position < b.position;
+            });
+
+            for (const Candidate& candidate : candidates) {
+                if (CountLeaves(splits, candidate.axis) > settings.maxLeaves) continue;
+                InsertSplit(splits[candidate.axis], candidate.position);
+            }
+
+            while (true) {
+                int bestAxis = -1;
+                size_t bestIndex = 0;
+                float bestLength = leafSize;
+                for (int axis = 0; axis < 3; axis++) {
+                    if (CountLeaves(splits, axis) > settings.maxLeaves) continue;
+                    for (size_t i = 0; i + 1 < splits[axis].size(); i++) {
+                        float length = splits[axis][i + 1] - splits[axis][i];
+                        if (length > bestLength) {
+                            bestLength = length;
+                            bestAxis = axis;
+                            bestIndex = i;
+                        }
+                    }
+                }
+                if (bestAxis < 0) break;
+                std::vector<float>& bounds = splits[bestAxis];
+                bounds.insert(bounds.begin() + bestIndex + 1, (bounds[bestIndex] + bounds[bestIndex + 1]) * 0.5f);
+            }
+        }
+
+        double ElapsedMs(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        /**
+         * Build-time state shared by the worker threads (read-only once pairs start)
+         */
+        struct VisBuilder {
+            glm::ivec3 dims;
+            const std::vector<float>* splits;
+            std::vector<uint8_t> solid;
+            std::vector<uint8_t> openFaces;     // Bit per axis: portal to the +axis neighbour
+
+            int LeafIndex(int x, int y, int z) const { return x + dims.x * (y + dims.y * z); }
+
+            glm::ivec3 LeafCoords(int leaf) const {
+                return glm::ivec3(leaf % dims.x, (leaf / dims.x) % dims.y, leaf / (dims.x * dims.y));
+            }
+
+            AABB CellBounds(const glm::ivec3& c) const {
+                return AABB(glm::vec3(splits[0][c.x], splits[1][c.y], splits[2][c.z]),
+                            glm::vec3(splits[0][c.x + 1], splits[1][c.y + 1], splits[2][c.z + 1]));
+            }
+
+            // Portal between prev and leaf, which is one step along axis in direction step
+            bool HasPortal(int prev, int leaf, int axis, int step) const {
+                return (openFaces[step > 0 ? prev : leaf] >> axis) & 1;
+            }
+
+            // Narrow [t0, t1] to the hull slices (the box lerped from a to b) overlapping cell on axis
+            void ClipToCell(const AABB& a, const AABB& b, int axis, int cell, float& t0, float& t1) const {
+                float cellMin = splits[axis][cell];
+                float cellMax = splits[axis][cell + 1];
+                ClipLinear(a.min[axis], b.min[axis] - a.min[axis], cellMax, t0, t1);
+                ClipLinear(-a.max[axis], a.max[axis] - b.max[axis], -cellMin, t0, t1);
+            }
+
+            // Is there a monotone run of empty leaves and portals from -> to inside the hull
+            // of both leaves? reached/stamp mark leaves reached for this pair; both per thread.
+            bool HasMonotoneRun(int from, int to, std::vector<uint32_t>& reached, uint32_t& stamp) const {
+                stamp++;
+
+                glm::ivec3 ca = LeafCoords(from);
+                glm::ivec3 cb = LeafCoords(to);
+                AABB a = CellBounds(ca);
+                AABB b = CellBounds(cb);
+                glm::ivec3 step(cb.x > ca.x ? 1 : (cb.x < ca.x ? -1 : 0), cb.y > ca.y ? 1 : (cb.y < ca.y ? -1 : 0),
+                                cb.z > ca.z ? 1 : (cb.z < ca.z ? -1 : 0));
+                int xMin = std::min(ca.x, cb.x), xMax = std::max(ca.x, cb.x);
+
+                // z, y, x each walk from -> to, so every predecessor is visited first
+                for (int z = ca.z;; z += step.z) {
+                    float tz0 = 0.0f, tz1 = 1.0f;
+                    ClipToCell(a, b, 2, z, tz0, tz1);
+                    for (int y = ca.y; tz0 <= tz1; y += step.y) {
+                        float t0 = tz0, t1 = tz1;
+                        ClipToCell(a, b, 1, y, t0, t1);
+                        int first, last;
+                        if (t0 <= t1) {
+                            // The hull's x extent over [t0, t1] is reached at an end of the interval
+                            float lo = std::min(a.min.x + (b.min.x - a.min.x) * t0, a.min.x + (b.min.x - a.min.x) * t1);
+                            float hi = std::max(a.max.x + (b.max.x - a.max.x) * t0, a.max.x + (b.max.x - a.max.x) * t1);
+                            if (CellRange(splits[0], lo - HULL_EPSILON, hi + HULL_EPSILON, first, last)) {
+                                first = std::max(first, xMin);
+                                last = std::min(last, xMax);
+                                for (int i = 0; i <= last - first; i++) {
+                                    int x = step.x >= 0 ? first + i : last - i;
+                                    int leaf = LeafIndex(x, y, z);
+                                    if (solid[leaf]) continue;
+
+                                    bool reach = leaf == from;
+                                    if (!reach && x != ca.x) {
+                                        int prev = LeafIndex(x - step.x, y, z);
+                                        reach = reached[prev] == stamp && HasPortal(prev, leaf, 0, step.x);
+                                    }
+                                    if (!reach && y != ca.y) {
+                                        int prev = LeafIndex(x, y - step.y, z);
+                                        reach = reached[prev] == stamp && HasPortal(prev, leaf, 1, step.y);
+                                    }
+                                    if (!reach && z != ca.z) {
+                                        int prev = LeafIndex(x, y, z - step.z);
+                                        reach = reached[prev] == stamp && HasPortal(prev, leaf, 2, step.z);
+                                    }
+                                    if (reach) reached[leaf] = stamp;
+                                }
+                            }
+                        }
+                        if (y == cb.y) break;
+                    }
+                    if (z == cb.z) break;
+                }
+                return reached[to] == stamp;
+            }
+        };
+    }
+
+    bool Visibility::Build(const std::vector<Brush>& brushes, const VisibilitySettings& settings) {
+        auto start = std::chrono::steady_clock::now();
+        Clear();
+
+        // Occluders: brush planes + bounds
+        std::vector<Occluder> occluders;
+        AABB worldBounds(glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX));
+        for (const auto& brush : brushes) {
+            std::vector<glm::vec3> vertices = BrushConverter::CalculateVertices(brush.planes);
+            if (vertices.size() < 4) continue;
+
+            Occluder occluder;
+            occluder.bounds = AABB(glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX));
+            for (const auto& vertex : vertices) {
+                occluder.bounds.Expand(vertex);
+            }
+            occluder.planes = brush.planes;
+            worldBounds.Expand(occluder.bounds.min);
+            worldBounds.Expand(occluder.bounds.max);
+            occluders.push_back(std::move(occluder));
+        }
+
+        if (occluders.empty()) {
+            LOG_WARNING("Visibility: no solid brushes, PVS disabled");
+            return false;
+        }
+
+        // Partition: split planes on brush faces, then halving, within the leaf budget
+        worldBounds.min -= glm::vec3(1.0f);
+        worldBounds.max += glm::vec3(1.0f);
+        ChooseSplits(occluders, worldBounds, settings, std::max(settings.leafSize, 1.0f), splits);
+        dims = glm::ivec3(static_cast<int>(splits[0].size()) - 1, static_cast<int>(splits[1].size()) - 1,
+                          static_cast<int>(splits[2].size()) - 1);
+
+        const int leafCount = dims.x * dims.y * dims.z;
+        std::vector<std::vector<uint32_t>> cellOccluders(leafCount);     // Brushes overlapping each leaf
+        std::vector<int> leaves;
+        for (uint32_t index = 0; index < occluders.size(); index++) {
+            GetLeavesOverlapping(occluders[index].bounds, leaves);
+            for (int leaf : leaves) {
+                cellOccluders[leaf].push_back(index);
+            }
+        }
+
+        VisBuilder builder;
+        builder.dims = dims;
+        builder.splits = splits;
+
+        // Solid leaves: contained in one brush
+        solid.assign(leafCount, 0);
+        for (int leaf = 0; leaf < leafCount; leaf++) {
+            AABB bounds = GetLeafBounds(leaf);
+            for (uint32_t index : cellOccluders[leaf]) {
+                if (ContainsBox(occluders[index], bounds.min, bounds.max)) {
+                    solid[leaf] = 1;
+                    break;
+                }
+            }
+        }
+        builder.solid = solid;
+
+        // Portals: faces between empty neighbours that no single brush covers
+        builder.openFaces.assign(leafCount, 0);
+        for (int z = 0; z < dims.z; z++) {
+            for (int y = 0; y < dims.y; y++) {
+                for (int x = 0; x < dims.x; x++) {
+                    int leaf = LeafIndex(x, y, z);
+                    if (solid[leaf]) continue;
+
+                    const glm::ivec3 neighbours[3] = { { x + 1, y, z }, { x, y + 1, z }, { x, y, z + 1 } };
+                    AABB bounds = GetLeafBounds(leaf);
+                    for (int axis = 0; axis < 3; axis++) {
+                        const glm::ivec3& n = neighbours[axis];
+                        if (n.x >= dims.x || n.y >= dims.y || n.z >= dims.z) continue;
+                        int other = LeafIndex(n.x, n.y, n.z);
+                        if (solid[other]) continue;
+
+                        glm::vec3 faceMin = bounds.min;
+                        faceMin[axis] = bounds.max[axis];
+                        bool covered = false;
+                        for (uint32_t index : cellOccluders[leaf]) {
+                            if (ContainsBox(occluders[index], faceMin, bounds.max)) {
+                                covered = true;
+                                break;
+                            }
+                        }
+
+                        if (!covered) {
+                            builder.openFaces[leaf] |= static_cast<uint8_t>(1 << axis);
+                            stats.portalCount++;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Regions: flood fill through portals
+        std::vector<int> region(leafCount, -1);
+        for (int leaf = 0; leaf < leafCount; leaf++) {
+            if (solid[leaf] || region[leaf] >= 0) continue;
+
+            std::queue<int> open;
+            open.push(leaf);
+            region[leaf] = stats.regionCount;
+            while (!open.empty()) {
+                int current = open.front();
+                open.pop();
+                glm::ivec3 c = LeafCoords(current);
+                for (int axis = 0; axis < 3; axis++) {
+                    for (int step = -1; step <= 1; step += 2) {
+                        glm::ivec3 n = c;
+                        n[axis] += step;
+                        if (n[axis] < 0 || n[axis] >= dims[axis]) continue;
+                        int next = LeafIndex(n.x, n.y, n.z);
+                        if (region[next] < 0 && builder.HasPortal(current, next, axis, step)) {
+                            region[next] = stats.regionCount;
+                            open.push(next);
+                        }
+                    }
+                }
+            }
+            stats.regionCount++;
+        }
+
+        // Different regions share no run of portals, so only leaves of the same region are paired
+        std::vector<std::vector<int>> regionLeaves(stats.regionCount);
+        for (int leaf = 0; leaf < leafCount; leaf++) {
+            if (region[leaf] >= 0) regionLeaves[region[leaf]].push_back(leaf);
+        }
+
+        // Leaf pairs straight into the bit rows, rows split across threads (each thread
+        // writes only j > i of its own rows, so no two threads share a byte)
+        rowBytes = (static_cast<size_t>(leafCount) + 7) / 8;
+        pvs.assign(rowBytes * leafCount, 0);
+        std::atomic<int> nextRow(0);
+
+        auto worker = [&]() {
+            std::vector<uint32_t> reached(leafCount, 0);
+            uint32_t stamp = 0;
+
+            int i;
+            while ((i = nextRow++) < leafCount) {
+                if (solid[i]) continue;
+                SetVisible(i, i);
+
+                const std::vector<int>& candidates = regionLeaves[region[i]];
+                for (auto it = std::upper_bound(candidates.begin(), candidates.end(), i); it != candidates.end(); ++it) {
+                    if (builder.HasMonotoneRun(i, *it, reached, stamp)) {
+                        SetVisible(i, *it);
+                    }
+                }
+            }
+        };
+        unsigned int threadCount = settings.threadCount;
+        if (threadCount == 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        std::vector<std::thread> threads;
+        for (unsigned int t = 1; t < threadCount; t++) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        // Mirror the upper triangle so rows are symmetric
+        for (const std::vector<int>& leaves : regionLeaves) {
+            for (size_t a = 0; a < leaves.size(); a++) {
+                for (size_t b = a + 1; b < leaves.size(); b++) {
+                    if (IsLeafVisible(leaves[a], leaves[b])) {
+                        SetVisible(leaves[b], leaves[a]);
+                    }
+                }
+            }
+        }
+
+        // Objects overlapping a solid leaf show their faces in its empty neighbours, so a
+        // solid leaf is visible wherever one of those is
+        std::vector<int> emptyNeighbours;
+        for (int s = 0; s < leafCount; s++) {
+            if (!solid[s]) continue;
+
+            emptyNeighbours.clear();
+            glm::ivec3 c = LeafCoords(s);
+            for (int axis = 0; axis < 3; axis++) {
+                for (int step = -1; step <= 1; step += 2) {
+                    glm::ivec3 n = c;
+                    n[axis] += step;
+                    if (n[axis] < 0 || n[axis] >= dims[axis]) continue;
+                    int neighbour = LeafIndex(n.x, n.y, n.z);
+                    if (!solid[neighbour]) emptyNeighbours.push_back(neighbour);
+                }
+            }
+
+            for (int e = 0; e < leafCount && !emptyNeighbours.empty(); e++) {
+                if (solid[e]) continue;
+                for (int neighbour : emptyNeighbours) {
+                    if (IsLeafVisible(e, neighbour)) {
+                        SetVisible(e, s);
+                        break;
+                    }
+                }
+            }
+        }
+
+        stats.leafCount = leafCount;
+        stats.emptyLeafCount = static_cast<int>(std::count(solid.begin(), solid.end(), 0));
+        stats.averageVisibleLeaves = CountAverageVisible();
+        stats.buildMs = ElapsedMs(start);
+        stats.loadedFromFile = false;
+
+        LOG_INFO("Visibility built: " + std::to_string(leafCount) + " leaves (" + std::to_string(dims.x) + "x" +
+                 std::to_string(dims.y) + "x" + std::to_string(dims.z) + ", " +
+                 std::to_string(stats.emptyLeafCount) + " empty), " + std::to_string(stats.portalCount) +
+                 " portals, " + std::to_string(stats.regionCount) + " regions, avg " +
+                 std::to_string(stats.averageVisibleLeaves) + " visible leaves, " +
+                 std::to_string(stats.buildMs) + " ms on " + std::to_string(threadCount) + " threads");
+        return true;
+    }
+
+    bool Visibility::Save(const std::string& path, uint64_t sourceHash) const {
+        if (!IsValid()) return false;
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            LOG_WARNING("Failed to write PVS file: " + path);
+            return false;
+        }
+
+        file.write(PVS_MAGIC, sizeof(PVS_MAGIC));
+        file.write(reinterpret_cast<const char*>(&PVS_VERSION), sizeof(PVS_VERSION));
+        file.write(reinterpret_cast<const char*>(&sourceHash), sizeof(sourceHash));
+        file.write(reinterpret_cast<const char*>(&dims), sizeof(int) * 3);
+        for (int axis = 0; axis < 3; axis++) {
+            file.write(reinterpret_cast<const char*>(splits[axis].data()),
+                       static_cast<std::streamsize>(splits[axis].size() * sizeof(float)));
+        }
+
+        int32_t counts[3] = { stats.portalCount, stats.regionCount, 0 };
+        file.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+        file.write(reinterpret_cast<const char*>(solid.data()), static_cast<std::streamsize>(solid.size()));
+        file.write(reinterpret_cast<const char*>(pvs.data()), static_cast<std::streamsize>(pvs.size()));
+
+        return file.good();
+    }
+
+    bool Visibility::Load(const std::string& path, uint64_t expectedHash) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+
+        auto start = std::chrono::steady_clock::now();
+
+        char magic[4];
+        uint32_t version = 0;
+        uint64_t hash = 0;
+        file.read(magic, sizeof(magic));
+        file.read(reinterpret_cast<char*>(&version), sizeof(version));
+        file.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+        if (!file || std::memcmp(magic, PVS_MAGIC, sizeof(magic)) != 0 || version != PVS_VERSION) {
+            LOG_WARNING("Ignoring incompatible PVS file: " + path);
+            return false;
+        }
+        if (hash != expectedHash) {
+            LOG_INFO("PVS file is out of date: " + path);
+            return false;
+        }
+
+        Clear();
+        int32_t counts[3];
+        file.read(reinterpret_cast<char*>(&dims), sizeof(int) * 3);
+        if (!file || dims.x <= 0 || dims.y <= 0 || dims.z <= 0 ||
+            static_cast<long long>(dims.x) * dims.y * dims.z > MAX_FILE_LEAVES) {
+            LOG_WARNING("Corrupt PVS header: " + path);
+            Clear();
+            return false;
+        }
+        for (int axis = 0; axis < 3; axis++) {
+            splits[axis].resize(static_cast<size_t>(dims[axis]) + 1);
+            file.read(reinterpret_cast<char*>(splits[axis].data()),
+                      static_cast<std::streamsize>(splits[axis].size() * sizeof(float)));
+        }
+        file.read(reinterpret_cast<char*>(counts), sizeof(counts));
+
+        size_t leafCount = static_cast<size_t>(dims.x) * dims.y * dims.z;
+        rowBytes = (leafCount + 7) / 8;
+        solid.resize(leafCount);
+        pvs.resize(rowBytes * leafCount);
+        file.read(reinterpret_cast<char*>(solid.data()), static_cast<std::streamsize>(solid.size()));
+        file.read(reinterpret_cast<char*>(pvs.data()), static_cast<std::streamsize>(pvs.size()));
+        if (!file) {
+            LOG_WARNING("Truncated PVS file: " + path);
+            Clear();
+            return false;
+        }
+
+        stats.leafCount = static_cast<int>(leafCount);
+        stats.emptyLeafCount = static_cast<int>(std::count(solid.begin(), solid.end(), 0));
+        stats.portalCount = counts[0];
+        stats.regionCount = counts[1];
+        stats.averageVisibleLeaves = CountAverageVisible();
+        stats.buildMs = ElapsedMs(start);
+        stats.loadedFromFile = true;
+
+        LOG_INFO("Visibility loaded from " + path + ": " + std::to_string(stats.leafCount) + " leaves, avg " +
+                 std::to_string(stats.averageVisibleLeaves) + " visible leaves");
+        return true;
+    }
+
+    uint64_t Visibility::HashFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return 0;
+
+        // FNV-1a 64
+        uint64_t hash = 14695981039346656037ull;
+        char buffer[4096];
+        while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0) {
+            std::streamsize count = file.gcount();
+            for (std::streamsize i = 0; i < count; i++) {
+                hash ^= static_cast<uint8_t>(buffer[i]);
+                hash *= 1099511628211ull;
+            }
+        }
+        return hash;
+    }
+
+    uint64_t Visibility::GetCacheKey(const std::string& mapPath, const VisibilitySettings& settings) {
+        // Settings change the partition, so they are part of the key (threadCount does not)
+        uint64_t hash = HashFile(mapPath);
+        uint32_t leafSizeBits;
+        std::memcpy(&leafSizeBits, &settings.leafSize, sizeof(leafSizeBits));
+        const uint32_t words[2] = { leafSizeBits, static_cast<uint32_t>(settings.maxLeaves) };
+        for (uint32_t word : words) {
+            for (int shift = 0; shift < 32; shift += 8) {
+                hash ^= (word >> shift) & 0xff;
+                hash *= 1099511628211ull;
+            }
+        }
+        return hash;
+    }
+
+    std::string Visibility::GetPVSPath(const std::string& mapPath) {
+        size_t dot = mapPath.find_last_of('.');
+        size_t slash = mapPath.find_last_of("/\\");
+        if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+            return mapPath + ".pvs";
+        }
+        return mapPath.substr(0, dot) + ".pvs";
+    }
+
+    void Visibility::Clear() {
+        solid.clear();
+        pvs.clear();
+        rowBytes = 0;
+        for (auto& bounds : splits) {
+            bounds.clear();
+        }
+        dims = glm::ivec3(0, 0, 0);
+        stats = VisibilityStats();
+    }
+
+    int Visibility::FindLeaf(const glm::vec3& point) const {
+        if (!IsValid()) return -1;
+
+        int coords[3];
+        for (int axis = 0; axis < 3; axis++) {
+            const std::vector<float>& bounds = splits[axis];
+            if (point[axis] < bounds.front() || point[axis] > bounds.back()) {
+                return -1;
+            }
+            coords[axis] = static_cast<int>(std::upper_bound(bounds.begin() + 1, bounds.end() - 1, point[axis]) -
+                                            (bounds.begin() + 1));
+        }
+        return LeafIndex(coords[0], coords[1], coords[2]);
+    }
+
+    bool Visibility::IsLeafVisible(int fromLeaf, int toLeaf) const {
+        return (pvs[static_cast<size_t>(fromLeaf) * rowBytes + (toLeaf >> 3)] >> (toLeaf & 7)) & 1;
+    }
+
+    void Visibility::GetLeavesOverlapping(const AABB& box, std::vector<int>& leaves) const {
+        leaves.clear();
+        if (dims.x <= 0) return;
+
+        int first[3], last[3];
+        for (int axis = 0; axis < 3; axis++) {
+            if (!CellRange(splits[axis], box.min[axis], box.max[axis], first[axis], last[axis])) return;
+        }
+
+        for (int z = first[2]; z <= last[2]; z++) {
+            for (int y = first[1]; y <= last[1]; y++) {
+                for (int x = first[0]; x <= last[0]; x++) {
+                    leaves.push_back(LeafIndex(x, y, z));
+                }
+            }
+        }
+    }
+
+    AABB Visibility::GetLeafBounds(int leaf) const {
+        glm::ivec3 c = LeafCoords(leaf);
+        return AABB(glm::vec3(splits[0][c.x], splits[1][c.y], splits[2][c.z]),
+                    glm::vec3(splits[0][c.x + 1], splits[1][c.y + 1], splits[2][c.z + 1]));
+    }
+
+    glm::ivec3 Visibility::LeafCoords(int leaf) const {
+        return glm::ivec3(leaf % dims.x, (leaf / dims.x) % dims.y, leaf / (dims.x * dims.y));
+    }
+
+    float Visibility::CountAverageVisible() const {
+        size_t visibleLeaves = 0;
+        size_t emptyLeaves = 0;
+        for (size_t leaf = 0; leaf < solid.size(); leaf++) {
+            if (solid[leaf]) continue;
+            emptyLeaves++;
+            for (size_t byte = 0; byte < rowBytes; byte++) {
+                for (uint8_t bits = pvs[leaf * rowBytes + byte]; bits; bits >>= 1) {
+                    visibleLeaves += bits & 1;
+                }
+            }
+        }
+        return emptyLeaves > 0 ? static_cast<float>(visibleLeaves) / emptyLeaves : 0.0f;
+    }
+
+    void Visibility::SetVisible(int fromLeaf, int toLeaf) {
+        pvs[static_cast<size_t>(fromLeaf) * rowBytes + (toLeaf >> 3)] |= static_cast<uint8_t>(1 << (toLeaf & 7));
+    }
+
+} // namespace VibeReaper
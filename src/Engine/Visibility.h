@@ -0,0 +1,94 @@
+#pragma once
+
+#include "MapLoader.h"
+#include "Collision.h"
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace VibeReaper {
+
+    struct VisibilitySettings {
+        float leafSize = 128.0f;    // Leaves longer than this are halved while the budget allows
+        int maxLeaves = 4096;       // Leaf budget
+        unsigned int threadCount = 0; // 0 = hardware concurrency
+    };
+
+    struct VisibilityStats {
+        int leafCount = 0;
+        int emptyLeafCount = 0;
+        int portalCount = 0;
+        int regionCount = 0;            // Connected groups of empty leaves
+        float averageVisibleLeaves = 0.0f;
+        double buildMs = 0.0;
+        bool loadedFromFile = false;
+    };
+
+    /**
+     * @brief Precomputed leaf-to-leaf visibility (PVS) for static world brushes
+     *
+     * The world bounds are split into axis-aligned leaves on a rectilinear grid.
+     * Split planes go on large axis-aligned brush faces first, so walls line up
+     * with leaf boundaries, then leaves longer than leafSize are halved while
+     * the leaf budget allows.
+     *
+     * The result is conservative: leaf B is only hidden from leaf A when no
+     * line between them can pass. A leaf is solid only if a single brush
+     * contains it, and neighbouring empty leaves share a portal unless a single
+     * brush covers their common face. Any sight line from A to B crosses a run
+     * of leaves that is monotone on every axis, stays inside the convex hull of
+     * both leaves and passes only empty leaves and portals; B is hidden when no
+     * such run exists. Leaves in different flood-filled regions have none at
+     * all. Openings of any width keep their portals, while walls that miss the
+     * split planes (or need several brushes to seal a leaf) only cost culling.
+     *
+     * Building is done once per map and cached in a .pvs file next to it,
+     * keyed by a hash of the map file and the settings (GetCacheKey).
+     */
+    class Visibility {
+    public:
+        // Build from engine-space brushes
+        bool Build(const std::vector<Brush>& brushes, const VisibilitySettings& settings = VisibilitySettings());
+
+        // .pvs cache (sourceHash = GetCacheKey(map, settings))
+        bool Save(const std::string& path, uint64_t sourceHash) const;
+        bool Load(const std::string& path, uint64_t expectedHash);
+        static uint64_t HashFile(const std::string& path);
+        static uint64_t GetCacheKey(const std::string& mapPath, const VisibilitySettings& settings);
+        static std::string GetPVSPath(const std::string& mapPath);
+
+        void Clear();
+
+        // Leaf containing a point, -1 if outside the partition
+        int FindLeaf(const glm::vec3& point) const;
+        bool IsLeafSolid(int leaf) const { return solid[leaf] != 0; }
+
+        // PVS lookup (a leaf always sees itself; solid leaves are seen through their empty neighbours)
+        bool IsLeafVisible(int fromLeaf, int toLeaf) const;
+
+        // Leaves whose bounds overlap a box (touching counts)
+        void GetLeavesOverlapping(const AABB& box, std::vector<int>& leaves) const;
+
+        AABB GetLeafBounds(int leaf) const;
+        int GetLeafCount() const { return static_cast<int>(solid.size()); }
+        bool IsValid() const { return !solid.empty(); }
+        const VisibilityStats& GetStats() const { return stats; }
+
+    private:
+        // Partition (leaf index = x + dims.x * (y + dims.y * z)); dims[axis] + 1
+        // sorted boundaries per axis, the world bounds first and last
+        glm::ivec3 dims;
+        std::vector<float> splits[3];
+        std::vector<uint8_t> solid;
+        std::vector<uint8_t> pvs;       // leafCount rows of rowBytes, bit per target leaf
+        size_t rowBytes = 0;
+        VisibilityStats stats;
+
+        int LeafIndex(int x, int y, int z) const { return x + dims.x * (y + dims.y * z); }
+        glm::ivec3 LeafCoords(int leaf) const;
+        void SetVisible(int fromLeaf, int toLeaf);
+        float CountAverageVisible() const;
+    };
+
+} // namespace VibeReaper
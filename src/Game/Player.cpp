@@ -66,7 +66,7 @@ namespace VibeReaper {
         velocity.y = 0.0f;
     }
 
-    void Player::Render(Shader& shader) {
+    void Player::Render(Shader& shader, RenderQueue& queue, const glm::vec3& viewPosition) {
         if (!meshInitialized) {
             InitializeMesh();
         }
@@ -82,11 +82,14 @@ namespace VibeReaper {
         model = glm::rotate(model, yaw, glm::vec3(0.0f, 1.0f, 0.0f));
         model = glm::scale(model, glm::vec3(WIDTH * 0.5f, HEIGHT * 0.5f, WIDTH * 0.5f));
 
-        shader.Use();
-        shader.SetMat4("uModel", model);
-        shader.SetVec3("uColor", glm::vec3(0.2f, 0.8f, 0.3f)); // Green player
-
-        playerMesh.Draw(shader);
+        DrawPacket packet;
+        packet.shader = &shader;
+        packet.vertexArray = playerMesh.GetVAO();
+        packet.indexCount = playerMesh.GetIndexCount();
+        packet.indexType = playerMesh.GetIndexType();
+        packet.model = model;
+        packet.color = glm::vec3(0.2f, 0.8f, 0.3f); // Green player
+        queue.Submit(packet, glm::length(renderPos - viewPosition));
     }
 
     glm::vec3 Player::GetForward() const {
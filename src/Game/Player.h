@@ -5,6 +5,7 @@
 #include "../Engine/Camera.h"
 #include "../Engine/Shader.h"
 #include "../Engine/Mesh.h"
+#include "../Engine/RenderQueue.h"
 #include "../Engine/Constants.h"
 
 namespace VibeReaper {
@@ -41,8 +42,10 @@ namespace VibeReaper {
         /**
          * @brief Render player model
          * @param shader Shader to use for rendering
+         * @param queue Render queue to submit the draw to
+         * @param viewPosition Camera position (for the sort key depth)
          */
-        void Render(Shader& shader);
+        void Render(Shader& shader, RenderQueue& queue, const glm::vec3& viewPosition);
 
         // Getters
         glm::vec3 GetPosition() const { return position; }
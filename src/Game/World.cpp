@@ -1,10 +1,156 @@
 #include "World.h"
+#include "../Engine/CoordinateSpace.h"
+#include "../Engine/Constants.h"
 #include "../Utils/Logger.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <unordered_map>
 #include <utility>
 
 namespace VibeReaper {
 
-    World::World() {
+    namespace {
+        const int MAX_TEXTURE_UPLOADS_PER_FRAME = 4;
+        const float DOOR_TRIGGER_PADDING = 60.0f;   // Quake's door trigger field, in map units
+        const size_t KEY_GRAIN = 256;               // Brushes hashed per job for cache keys
+
+        std::string GetBrushTextureName(const Brush& brush) {
+            if (!brush.planes.empty()) {
+                return brush.planes[0].texture;
+            }
+            return "test_texture"; // Default fallback
+        }
+
+        std::string GetTexturePath(const std::string& textureName) {
+            return "assets/textures/" + textureName + ".png";
+        }
+
+        // Inverse of GetTexturePath ("" for any other path)
+        std::string GetTextureName(const std::string& path) {
+            const std::string prefix = "assets/textures/";
+            const std::string suffix = ".png";
+            if (path.size() <= prefix.size() + suffix.size() || path.compare(0, prefix.size(), prefix) != 0 ||
+                path.compare(path.size() - suffix.size(), suffix.size(), suffix) != 0) {
+                return "";
+            }
+            return path.substr(prefix.size(), path.size() - prefix.size() - suffix.size());
+        }
+
+        double ElapsedMs(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        // Triggers are volumes only; worldspawn and every other brush entity are drawn
+        bool IsDrawnBrushEntity(const Entity& entity) {
+            return entity.classname.compare(0, 8, "trigger_") != 0;
+        }
+
+        void OffsetGeometry(BrushGeometry& geometry, const glm::vec3& offset) {
+            for (Vertex& vertex : geometry.vertices) {
+                vertex.position += offset;
+            }
+            for (glm::vec3& position : geometry.collision.positions) {
+                position += offset;
+            }
+            geometry.collision.bounds = AABB(geometry.collision.bounds.min + offset, geometry.collision.bounds.max + offset);
+            geometry.bounds = AABB(geometry.bounds.min + offset, geometry.bounds.max + offset);
+        }
+
+        AABB TransformBounds(const AABB& local, const glm::mat4& transform) {
+            AABB result;
+            for (int corner = 0; corner < 8; corner++) {
+                glm::vec3 point((corner & 1) ? local.max.x : local.min.x,
+                                (corner & 2) ? local.max.y : local.min.y,
+                                (corner & 4) ? local.max.z : local.min.z);
+                glm::vec3 world = glm::vec3(transform * glm::vec4(point, 1.0f));
+                if (corner == 0) {
+                    result = AABB(world, world);
+                } else {
+                    result.Expand(world);
+                }
+            }
+            return result;
+        }
+
+        glm::mat4 GetBrushEntityTransform(const BrushEntity& entity) {
+            if (entity.motion == BrushMotion::Slide) {
+                return glm::translate(glm::mat4(1.0f), entity.pivot + entity.moveOffset * entity.position);
+            }
+            glm::mat4 transform = glm::translate(glm::mat4(1.0f), entity.pivot);
+            if (entity.motion == BrushMotion::Rotate) {
+                transform = glm::rotate(transform, glm::radians(entity.openAngle * entity.position), glm::vec3(0.0f, 1.0f, 0.0f));
+            }
+            return transform;
+        }
+
+        // Flags and mover parameters from the entity's keys (FGD defaults; distances in map units)
+        void ConfigureBrushEntity(BrushEntity& entity, const Entity& source, const AABB& bounds) {
+            const std::string& classname = source.classname;
+            entity.classname = classname;
+            entity.visible = IsDrawnBrushEntity(source);
+            entity.solid = entity.visible && classname != "func_illusionary" && classname != "func_water";
+            entity.pivot = bounds.GetCenter();
+            entity.wait = source.GetFloat("wait", 3.0f);
+
+            if (classname == "func_door") {
+                // angle -1 moves down, -2 up, anything else is a Quake yaw (converted to Y-up)
+                int angle = source.GetInt("angle", 0);
+                glm::vec3 direction;
+                if (angle == -1) {
+                    direction = glm::vec3(0.0f, -1.0f, 0.0f);
+                } else if (angle == -2) {
+                    direction = glm::vec3(0.0f, 1.0f, 0.0f);
+                } else {
+                    float yaw = glm::radians(static_cast<float>(angle));
+                    direction = CoordinateSpace::QuakeToEngine(glm::vec3(std::cos(yaw), std::sin(yaw), 0.0f));
+                }
+
+                // Travels its own size along the direction, minus the lip left showing
+                glm::vec3 size = bounds.GetSize();
+                float travel = std::abs(glm::dot(direction, size)) - source.GetFloat("lip", 8.0f);
+                float speed = source.GetFloat("speed", 100.0f);
+                entity.motion = BrushMotion::Slide;
+                entity.moveOffset = direction * std::max(travel, 0.0f);
+                entity.travelTime = std::max(travel, 1.0f) / std::max(speed, 1.0f);
+            } else if (classname == "func_door_rotating") {
+                // Swings distance (default 90) degrees about its origin key, or the brush center
+                // when unset; speed is in degrees/s
+                if (source.properties.count("origin")) {
+                    entity.pivot = source.GetOrigin();
+                }
+                float distance = source.GetFloat("distance", 90.0f);
+                entity.motion = BrushMotion::Rotate;
+                entity.openAngle = (source.GetInt("spawnflags", 0) & 2) ? -distance : distance;
+                entity.travelTime = std::max(std::abs(distance), 1.0f) / std::max(source.GetFloat("speed", 100.0f), 1.0f);
+            }
+
+            // "Starts Open" (spawnflag 1 on both doors) spawns open and runs in reverse, as in Quake
+            if (entity.motion != BrushMotion::None && (source.GetInt("spawnflags", 0) & 1)) {
+                entity.startsOpen = true;
+                entity.position = 1.0f;
+            }
+
+            entity.activationBounds = AABB(bounds.min - glm::vec3(DOOR_TRIGGER_PADDING),
+                                           bounds.max + glm::vec3(DOOR_TRIGGER_PADDING));
+        }
+
+        std::string FormatKB(size_t bytes) {
+            char text[32];
+            std::snprintf(text, sizeof(text), "%.1f KB", bytes / 1024.0);
+            return text;
+        }
+    }
+
+    World::World()
+        : textureManager(textureLoader), levelMeshFormat(0), activator(0.0f), hasActivator(false), streamer(jobs),
+          streaming(false), streamingActive(false), frustumCulling(true), visibilityFrame(0), visibilityCulling(true),
+          occlusionCulling(false), asyncTextureLoading(true), useTextureArrays(true), packedVertices(true),
+          meshRetention(MeshRetention::Release), materialsActive(false), materialTexture(0),
+          reportTextureLoad(false) {
     }
 
     World::~World() {
@@ -14,9 +160,21 @@ namespace VibeReaper {
     bool World::LoadMap(const std::string& mapPath) {
         LOG_INFO("World: Loading map: " + mapPath);
 
+        // Reloading the same map: meshes built with the current settings are matched
+        // against the new brushes below, so unchanged ones skip conversion and upload
+        std::vector<RenderObject> previousGeometry;
+        std::vector<uint64_t> previousKeys;
+        if (mapPath == loadedMapPath && levelMeshFormat == GetMeshFormat()) {
+            previousGeometry.swap(levelGeometry);
+            previousKeys.swap(levelKeys);
+        }
+
         // Unload previous map
         Unload();
 
+        loadStartTime = std::chrono::steady_clock::now();
+        textureLoader.ResetStats();
+
         // Parse MAP file
         map = MapLoader::LoadFromFile(mapPath);
         if (map.entities.empty()) {
@@ -24,6 +182,10 @@ namespace VibeReaper {
             return false;
         }
 
+        // Convert from Quake Z-up to engine Y-up once, before any geometry is built
+        ConvertToEngineSpace();
+        loadedMapPath = mapPath;
+
         // Get worldspawn (entity 0)
         worldspawn = map.entities[0];
 
@@ -31,83 +193,787 @@ namespace VibeReaper {
             LOG_WARNING("First entity is not worldspawn, classname: " + worldspawn.classname);
         }
 
-        // Convert worldspawn brushes to meshes
-        LOG_INFO("Converting " + std::to_string(worldspawn.brushes.size()) + " brushes to meshes");
-        
-        for (const auto& brush : worldspawn.brushes) {
-            Mesh mesh = BrushConverter::ConvertBrushToMesh(brush);
-            
-            // Skip empty meshes
-            if (mesh.vertices.empty()) continue;
+        // Kick off texture decodes first so they overlap with brush conversion.
+        // Material layers must be assigned before conversion writes them into vertices.
+        // Streamed levels request textures region by region, so they can be released again.
+        streamingActive = streaming;
+        materialsActive = useTextureArrays && !streamingActive;
+        if (materialsActive) {
+            RequestMaterials();
+        } else if (asyncTextureLoading && !streamingActive) {
+            RequestTextures();
+        }
+
+        if (streamingActive) {
+            // Regions convert on workers once the activator comes near (see Update())
+            streamer.Build(worldspawn.brushes, streamingSettings, meshRetention == MeshRetention::KeepCollision);
+            regionObjects.resize(streamer.GetRegionCount());
+        } else {
+            // Brush meshes not kept from the previous load come from the cache file when
+            // their content is unchanged, otherwise they are converted
+            brushCache.Load(BrushCache::GetCachePath(mapPath));
+            BuildLevelGeometry(previousGeometry, previousKeys);
+            previousGeometry.clear();
+        }
 
-            // Setup mesh buffers
-            mesh.SetupMesh();
+        // Doors, walls and triggers get their own meshes, drawn with a per-entity transform
+        LoadBrushEntities();
+        SaveBrushCache(mapPath);
+        LogMeshMemory();
 
-            // Determine texture
-            std::string textureName = "test_texture"; // Default fallback
-            if (!brush.planes.empty()) {
-                textureName = brush.planes[0].texture;
-            }
-
-            // Load texture if not in cache
-            if (textureCache.find(textureName) == textureCache.end()) {
-                Texture texture;
-                std::string texturePath = "assets/textures/" + textureName + ".png";
-                
-                // Try to load texture
-                if (!texture.LoadFromFile(texturePath)) {
-                    LOG_WARNING("Failed to load texture: " + texturePath + ", using fallback");
-                    // Try to create fallback white texture if not already created
-                    // Note: We might want a shared fallback texture, but for now let's just create one per missing texture
-                    // or better, map all missing textures to a special "fallback" key?
-                    // Let's just create a white texture for this entry so we don't try to load it again
-                    texture.CreateWhiteTexture();
+        // The PVS and occlusion clusters index the full static level
+        if (!streamingActive) {
+            BuildStaticCulling(mapPath);
+        }
+
+        // Spawn entities (lights, enemies, etc.)
+        SpawnEntities();
+
+        // Upload whatever finished decoding during conversion; the rest streams in via Update()
+        if (materialsActive && !asyncTextureLoading) {
+            textureLoader.WaitAll();
+        } else {
+            textureLoader.ProcessUploads();
+        }
+        if (materialsActive && textureLoader.IsIdle()) {
+            BuildMaterials();
+        }
+
+        LOG_INFO("Map loaded successfully in " + std::to_string(ElapsedMs(loadStartTime)) + " ms (" +
+                 std::to_string(textureLoader.GetPendingCount()) + " textures still loading)");
+
+        reportTextureLoad = true;
+        if (textureLoader.IsIdle()) {
+            FinishTextureLoadReport();
+        }
+        return true;
+    }
+
+    bool World::ReloadMap() {
+        if (loadedMapPath.empty()) return false;
+        std::string mapPath = loadedMapPath;
+        auto reloadStart = std::chrono::steady_clock::now();
+
+        Map reloaded = MapLoader::LoadFromFile(mapPath);
+        if (reloaded.entities.empty()) {
+            LOG_WARNING("Hot reload: could not parse " + mapPath + ", keeping the current level");
+            return false;
+        }
+
+        // Regions rebuild from the full brush list, the texture array cannot grow in place,
+        // and kept meshes must match the current mesh settings
+        bool fullReload = streamingActive || levelMeshFormat != GetMeshFormat();
+        if (materialsActive) {
+            for (const auto& entity : reloaded.entities) {
+                if (!IsDrawnBrushEntity(entity)) continue;
+                for (const auto& brush : entity.brushes) {
+                    for (const auto& plane : brush.planes) {
+                        fullReload = fullReload || !materialPacker.HasMaterial(plane.texture);
+                    }
                 }
-                
-                textureCache[textureName] = std::move(texture);
             }
+        }
+        if (fullReload) {
+            LOG_INFO("Hot reload: reloading " + mapPath + " from scratch");
+            return LoadMap(mapPath);
+        }
 
-            // Store render object
-            RenderObject obj;
-            obj.mesh = std::move(mesh);
-            obj.texture = &textureCache[textureName];
-            levelGeometry.push_back(std::move(obj));
+        // The material layers stay as they are, so the outgoing keys remain comparable
+        std::vector<RenderObject> previous;
+        std::vector<uint64_t> previousKeys;
+        previous.swap(levelGeometry);
+        previousKeys.swap(levelKeys);
+        map = std::move(reloaded);
+        ConvertToEngineSpace();
+        worldspawn = map.entities[0];
+
+        // Re-acquire the textures the edited map uses. The old set is held until the
+        // end of the reload, then textures only removed or retextured brushes used
+        // are released (and evicted over budget) instead of staying referenced.
+        std::map<std::string, TextureHandle> previousTextures;
+        previousTextures.swap(levelTextures);
+        if (!materialsActive && asyncTextureLoading) {
+            RequestTextures();
         }
-        
-        LOG_INFO("Generated " + std::to_string(levelGeometry.size()) + " render objects");
 
-        // Spawn entities (lights, enemies, etc.)
+        brushCache.Load(BrushCache::GetCachePath(mapPath));
+        size_t kept = BuildLevelGeometry(previous, previousKeys);
+        size_t removed = previous.size() - kept;
+        previous.clear();
+
+        // Everything indexing levelGeometry, plus brush entities and markers, is rebuilt
+        brushEntities.clear();
+        LoadBrushEntities();
+        SaveBrushCache(mapPath);
+        // The O(leaves^2) PVS build would stall every save, so the PVS is only
+        // loaded from the cache here and otherwise rebuilt by the next full load
+        visibility.Clear();
+        BuildStaticCulling(mapPath, false);
+        visibleObjects.clear();
+        for (EntityBatch& batch : entityBatches) {
+            batch.instances.clear();
+            batch.bounds.clear();
+        }
         SpawnEntities();
 
-        LOG_INFO("Map loaded successfully");
+        LOG_INFO("Hot reload: {} in {} ms ({} meshes kept, {} removed)", mapPath, ElapsedMs(reloadStart), kept, removed);
         return true;
     }
 
+    bool World::ReloadTexture(const std::string& path) {
+        bool used = textureManager.Reload(path);
+
+        // A decode cached from an earlier level is stale now
+        materialPacker.ForgetDecoded(GetTextureName(path));
+
+        // Array layers decode again and upload in place once Update() processes them
+        if (materialsActive) {
+            for (int layer = 0; layer < materialPacker.GetLayerCount(); layer++) {
+                if (GetTexturePath(materialPacker.GetLayerName(layer)) != path) continue;
+                textureLoader.Request(path,
+                    [this, layer](const unsigned char* pixels, int width, int height, int channels) {
+                        materialPacker.UpdateLayer(layer, pixels, width, height, channels);
+                    });
+                used = true;
+            }
+        }
+        return used;
+    }
+
+    size_t World::BuildLevelGeometry(std::vector<RenderObject>& previous, const std::vector<uint64_t>& previousKeys) {
+        const std::vector<Brush>& brushes = worldspawn.brushes;
+        const MaterialPacker* materials = materialsActive ? &materialPacker : nullptr;
+        auto convertStart = std::chrono::steady_clock::now();
+        std::vector<uint64_t> keys = MakeBrushKeys(brushes);
+
+        // Previous meshes are matched by key; identical brushes are interchangeable
+        std::unordered_map<uint64_t, std::vector<uint32_t>> reusable;
+        for (uint32_t index = 0; index < previous.size(); index++) {
+            reusable[previousKeys[index]].push_back(index);
+        }
+        std::vector<uint32_t> reuse(brushes.size(), UINT32_MAX);
+        std::vector<uint32_t> pending;
+        for (uint32_t i = 0; i < brushes.size(); i++) {
+            auto it = reusable.find(keys[i]);
+            if (it != reusable.end() && !it->second.empty()) {
+                reuse[i] = it->second.back();
+                it->second.pop_back();
+                brushCache.MarkUsed(keys[i]);
+            } else {
+                pending.push_back(i);
+            }
+        }
+
+        // CPU stage: cache hits are copied, the rest converted in parallel into plain
+        // vertex/index arrays (plus the collision copy the retention policy keeps). No GL calls.
+        std::vector<BrushGeometry> converted = brushCache.Convert(
+            brushes, keys, pending, jobs, materials, meshRetention == MeshRetention::KeepCollision);
+        double convertMs = ElapsedMs(convertStart);
+
+        // GL stage: create buffers on this thread, in brush order
+        auto uploadStart = std::chrono::steady_clock::now();
+        levelGeometry.clear();
+        levelKeys.clear();
+        levelGeometry.reserve(brushes.size());
+        levelKeys.reserve(brushes.size());
+        meshMemory = MeshMemoryStats();
+        size_t next = 0;
+        size_t kept = 0;
+        for (size_t i = 0; i < brushes.size(); i++) {
+            if (reuse[i] != UINT32_MAX) {
+                RenderObject& obj = previous[reuse[i]];
+                size_t sourceBytes = obj.mesh.GetVertexCount() * sizeof(Vertex) +
+                                     static_cast<size_t>(obj.mesh.GetIndexCount()) * sizeof(unsigned int);
+                AccumulateMeshMemory(obj.mesh, sourceBytes);
+                levelGeometry.push_back(std::move(obj));
+                kept++;
+            } else {
+                BrushGeometry& geometry = converted[next++];
+
+                // Skip empty meshes
+                if (geometry.vertices.empty()) continue;
+
+                levelGeometry.push_back(UploadBrush(geometry, brushes[i]));
+            }
+            levelKeys.push_back(keys[i]);
+        }
+        IndexLevelGeometry();
+        levelMeshFormat = GetMeshFormat();
+        double uploadMs = ElapsedMs(uploadStart);
+
+        const BrushCacheStats& cacheStats = brushCache.GetStats();
+        LOG_INFO("Built {} render objects from {} brushes: {} meshes kept, {} from the brush cache, {} converted "
+                 "({} ms on {} threads), uploaded in {} ms", levelGeometry.size(), brushes.size(), kept,
+                 cacheStats.hits, cacheStats.misses, convertMs, jobs.GetWorkerCount() + 1, uploadMs);
+        return kept;
+    }
+
+    void World::IndexLevelGeometry() {
+        // Brush entities add their own proxies afterwards (LoadBrushEntities)
+        cullBounds.Clear();
+        colliders.Clear();
+        for (uint32_t index = 0; index < levelGeometry.size(); index++) {
+            cullBounds.Add(levelGeometry[index].bounds);
+            colliders.Insert(levelGeometry[index].bounds, index);
+        }
+    }
+
+    void World::BuildStaticCulling(const std::string& mapPath, bool buildVisibility) {
+        // Leaf PVS from the .pvs cache, rebuilt when the map or settings changed
+        LoadVisibility(mapPath, buildVisibility);
+
+        // Occlusion query clusters (queries themselves are created on first use)
+        std::vector<AABB> objectBounds;
+        objectBounds.reserve(levelGeometry.size());
+        for (const auto& obj : levelGeometry) {
+            objectBounds.push_back(obj.bounds);
+        }
+        occlusion.Build(objectBounds);
+        clusterObjects.assign(occlusion.GetClusterCount(), std::vector<uint32_t>());
+    }
+
+    std::vector<uint64_t> World::MakeBrushKeys(const std::vector<Brush>& brushes) {
+        const MaterialPacker* materials = materialsActive ? &materialPacker : nullptr;
+        bool collision = meshRetention == MeshRetention::KeepCollision;
+        std::vector<uint64_t> keys(brushes.size());
+        jobs.ParallelFor(brushes.size(), KEY_GRAIN, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                keys[i] = BrushCache::MakeKey(brushes[i], materials, collision);
+            }
+        });
+        return keys;
+    }
+
+    void World::SaveBrushCache(const std::string& mapPath) {
+        // Streamed levels never load the cache, so saving would drop worldspawn's entries
+        if (!streamingActive && brushCache.IsDirty()) {
+            std::string cachePath = BrushCache::GetCachePath(mapPath);
+            if (!brushCache.Save(cachePath)) {
+                LOG_WARNING("Could not cache brush meshes to " + cachePath + ", they will be converted on next load");
+            }
+        }
+
+        // Entries are copies of meshes that are uploaded by now
+        brushCache.Clear();
+    }
+
+    void World::RequestTextures() {
+        // One request per unique texture; textures still resident from the last map are reused
+        size_t requested = textureLoader.GetPendingCount();
+        for (const auto& entity : map.entities) {
+            if (!IsDrawnBrushEntity(entity)) continue;
+            for (const auto& brush : entity.brushes) {
+                AcquireTexture(GetBrushTextureName(brush));
+            }
+        }
+        requested = textureLoader.GetPendingCount() - requested;
+
+        LOG_INFO("Level uses " + std::to_string(levelTextures.size()) + " textures, queued " +
+                 std::to_string(requested) + " for async decoding on " +
+                 std::to_string(textureLoader.GetThreadCount()) + " threads");
+    }
+
+    void World::RequestMaterials() {
+        // Every face keeps its own texture: register all plane textures as array layers
+        for (const auto& entity : map.entities) {
+            if (!IsDrawnBrushEntity(entity)) continue;
+            for (const auto& brush : entity.brushes) {
+                for (const auto& plane : brush.planes) {
+                    materialPacker.AddMaterial(plane.texture);
+                }
+            }
+        }
+
+        // Decoded pixels go straight into the packer's CPU layers; Build() uploads them at once.
+        // Layers decoded for an earlier level already have their pixels.
+        int queued = 0;
+        for (int layer = 0; layer < materialPacker.GetLayerCount(); layer++) {
+            if (materialPacker.HasLayerPixels(layer)) continue;
+            const std::string& textureName = materialPacker.GetLayerName(layer);
+            textureLoader.Request(GetTexturePath(textureName),
+                [this, layer](const unsigned char* pixels, int width, int height, int channels) {
+                    materialPacker.SetLayerPixels(layer, pixels, width, height, channels);
+                });
+            queued++;
+        }
+
+        LOG_INFO("Queued " + std::to_string(queued) + " of " + std::to_string(materialPacker.GetLayerCount()) +
+                 " materials for the texture array on " + std::to_string(textureLoader.GetThreadCount()) +
+                 " threads (rest cached from earlier levels)");
+    }
+
+    void World::BuildMaterials() {
+        materialPacker.Build();
+
+        // The arrays share the texture budget; cached per-brush textures are evicted to make room
+        textureManager.SetExternalBytes(materialPacker.GetMemoryBytes());
+    }
+
+    TextureHandle World::AcquireTexture(const std::string& textureName) {
+        auto it = levelTextures.find(textureName);
+        if (it != levelTextures.end()) {
+            return it->second;
+        }
+
+        // Missing textures share the manager's fallback instead of getting their own
+        TextureHandle handle = textureManager.Acquire(GetTexturePath(textureName), asyncTextureLoading);
+        levelTextures[textureName] = handle;
+        return handle;
+    }
+
+    RenderObject World::UploadBrush(BrushGeometry& geometry, const Brush& brush) {
+        // Setup mesh buffers (packed falls back to float per mesh when UVs don't fit);
+        // the CPU copy is dropped after upload unless the retention policy keeps it
+        RenderObject obj;
+        obj.bounds = geometry.bounds;
+        Mesh mesh(std::move(geometry.vertices), std::move(geometry.indices));
+        if (packedVertices) {
+            mesh.SetVertexFormat(VertexFormat::Packed);
+        }
+        mesh.SetRetention(meshRetention);
+        size_t sourceBytes = mesh.GetCPUMemoryUsage();
+        mesh.SetCollision(std::move(geometry.collision));
+        mesh.SetupMesh();
+        AccumulateMeshMemory(mesh, sourceBytes);
+
+        // Texture already queued in async mode, per-face layers in array mode. Streamed
+        // objects hold the only references, so a region's textures can go when it does.
+        obj.mesh = std::move(mesh);
+        if (streamingActive) {
+            obj.texture = textureManager.Acquire(GetTexturePath(GetBrushTextureName(brush)), asyncTextureLoading);
+        } else if (!materialsActive) {
+            obj.texture = AcquireTexture(GetBrushTextureName(brush));
+        }
+        return obj;
+    }
+
+    void World::LoadBrushEntities() {
+        // All brush entity brushes go through one parallel conversion pass
+        std::vector<const Entity*> sources;
+        std::vector<size_t> firstBrush;
+        std::vector<Brush> brushes;
+        for (size_t i = 1; i < map.entities.size(); i++) {
+            const Entity& entity = map.entities[i];
+            if (entity.brushes.empty()) continue;
+            sources.push_back(&entity);
+            firstBrush.push_back(brushes.size());
+            brushes.insert(brushes.end(), entity.brushes.begin(), entity.brushes.end());
+        }
+        if (sources.empty()) return;
+        firstBrush.push_back(brushes.size());
+
+        const MaterialPacker* materials = materialsActive ? &materialPacker : nullptr;
+        std::vector<uint32_t> indices(brushes.size());
+        std::iota(indices.begin(), indices.end(), 0u);
+        std::vector<BrushGeometry> converted = brushCache.Convert(
+            brushes, MakeBrushKeys(brushes), indices, jobs, materials, meshRetention == MeshRetention::KeepCollision);
+
+        size_t movers = 0;
+        brushEntities.reserve(sources.size());
+        for (size_t e = 0; e < sources.size(); e++) {
+            // Closed (as authored) world bounds of the entity's non-empty brushes
+            AABB bounds;
+            bool hasBounds = false;
+            for (size_t b = firstBrush[e]; b < firstBrush[e + 1]; b++) {
+                if (converted[b].vertices.empty()) continue;
+                if (!hasBounds) {
+                    bounds = converted[b].bounds;
+                    hasBounds = true;
+                } else {
+                    bounds.Expand(converted[b].bounds.min);
+                    bounds.Expand(converted[b].bounds.max);
+                }
+            }
+            if (!hasBounds) continue;
+
+            BrushEntity entity;
+            ConfigureBrushEntity(entity, *sources[e], bounds);
+            entity.localBounds = AABB(bounds.min - entity.pivot, bounds.max - entity.pivot);
+
+            // Meshes are built relative to the pivot so moving them is a matrix update
+            if (entity.visible) {
+                for (size_t b = firstBrush[e]; b < firstBrush[e + 1]; b++) {
+                    if (converted[b].vertices.empty()) continue;
+                    OffsetGeometry(converted[b], -entity.pivot);
+                    entity.parts.push_back(UploadBrush(converted[b], brushes[b]));
+                }
+            }
+
+            // Starts Open doors spawn away from where the map places them
+            entity.transform = GetBrushEntityTransform(entity);
+            entity.bounds = TransformBounds(entity.localBounds, entity.transform);
+            if (entity.solid) {
+                entity.proxy = colliders.Insert(entity.bounds, static_cast<uint32_t>(brushEntities.size()) | BRUSH_ENTITY_PROXY);
+            }
+            if (entity.motion != BrushMotion::None) movers++;
+
+            LOG_CAT_DEBUG(Map, "Brush entity {}: {} brushes, {} parts", entity.classname,
+                          firstBrush[e + 1] - firstBrush[e], entity.parts.size());
+            brushEntities.push_back(std::move(entity));
+        }
+
+        LOG_INFO("Built {} brush entities ({} movers) from {} brushes", brushEntities.size(), movers, brushes.size());
+    }
+
+    void World::FinishTextureLoadReport() {
+        const TextureLoadStats& stats = textureLoader.GetStats();
+        LOG_INFO("Textures resident: " + std::to_string(stats.texturesLoaded) + " loaded, " +
+                 std::to_string(stats.texturesFailed) + " failed, decode " + std::to_string(stats.decodeMs) +
+                 " ms (worker total), upload " + std::to_string(stats.uploadMs) + " ms (" +
+                 (asyncTextureLoading ? "async" : "sync") + ")");
+        LOG_INFO("Total map load time: " + std::to_string(ElapsedMs(loadStartTime)) + " ms");
+        textureManager.LogResidency();
+        reportTextureLoad = false;
+    }
+
+    void World::AccumulateMeshMemory(const Mesh& mesh, size_t sourceBytes) {
+        meshMemory.meshes++;
+        meshMemory.vertices += mesh.GetVertexCount();
+        meshMemory.indices += static_cast<size_t>(mesh.GetIndexCount());
+        meshMemory.gpuVertexBytes += mesh.GetVertexBufferSize();
+        meshMemory.gpuIndexBytes += mesh.GetIndexBufferSize();
+        meshMemory.cpuSourceBytes += sourceBytes;
+        meshMemory.cpuRetainedBytes += mesh.GetCPUMemoryUsage();
+        meshMemory.collisionBytes += mesh.GetCollision().GetMemoryUsage();
+        if (mesh.GetVertexFormat() == VertexFormat::Float) meshMemory.floatMeshes++;
+    }
+
+    void World::LogMeshMemory() const {
+        const MeshMemoryStats& m = meshMemory;
+        if (m.meshes == 0) return;
+
+        // Reference: float vertices and 32-bit indices, CPU copy kept next to the GPU copy
+        size_t floatVertexBytes = m.vertices * sizeof(Vertex);
+        size_t wideIndexBytes = m.indices * sizeof(unsigned int);
+        LOG_INFO("World mesh memory (" + std::to_string(m.meshes) + " meshes, " +
+                 std::to_string(m.vertices) + " vertices, " + std::to_string(m.indices) + " indices):");
+        LOG_INFO("  GPU vertices: " + FormatKB(m.gpuVertexBytes) + " (" + FormatKB(floatVertexBytes) + " as float, " +
+                 std::to_string(m.floatMeshes) + " meshes kept float)");
+        LOG_INFO("  GPU indices:  " + FormatKB(m.gpuIndexBytes) + " (" + FormatKB(wideIndexBytes) + " as 32-bit)");
+        LOG_INFO("  CPU retained: " + FormatKB(m.cpuRetainedBytes) + " of " + FormatKB(m.cpuSourceBytes) +
+                 " converted (collision " + FormatKB(m.collisionBytes) + ")");
+    }
+
+    void World::ConvertToEngineSpace() {
+        // Rotate every plane and entity origin into engine space. Brush vertices and
+        // normals are derived from the planes, so BrushConverter then emits engine-space
+        // meshes and neither rendering nor collision needs a per-frame conversion.
+        for (auto& entity : map.entities) {
+            for (auto& brush : entity.brushes) {
+                for (auto& plane : brush.planes) {
+                    plane.p1 = CoordinateSpace::QuakeToEngine(plane.p1);
+                    plane.p2 = CoordinateSpace::QuakeToEngine(plane.p2);
+                    plane.p3 = CoordinateSpace::QuakeToEngine(plane.p3);
+                    plane.normal = CoordinateSpace::QuakeToEngine(plane.normal);
+                    // distance is invariant under rotation
+                }
+            }
+
+            if (entity.properties.count("origin")) {
+                entity.SetOrigin(CoordinateSpace::QuakeToEngine(entity.GetOrigin()));
+            }
+        }
+
+        map.worldspawn = map.entities[0];
+    }
+
     void World::Unload() {
+        // Material callbacks refer to this level's layers, drop them before clearing the packer.
+        // Textures themselves stay cached in the manager for the next map.
+        textureLoader.CancelAll();
+        textureManager.ResetPendingLoads();
+        reportTextureLoad = false;
+
+        // In-flight region conversions read the streamer's brushes
+        streamer.Clear();
+        regionObjects.clear();
+        streamingActive = false;
+
+        loadedMapPath.clear();
         levelGeometry.clear();
-        textureCache.clear();
+        levelKeys.clear();
+        brushCache.Clear();
+        brushEntities.clear();
+        colliders.Clear();
+        hasActivator = false;
+        meshMemory = MeshMemoryStats();
+        levelTextures.clear();
+        cullBounds.Clear();
+        visibleObjects.clear();
+        cullingStats = CullingStats();
+        visibility.Clear();
+        leafObjects.clear();
+        objectVisibleFrame.clear();
+        occlusion.Clear();
+        clusterObjects.clear();
+        for (EntityBatch& batch : entityBatches) {
+            batch.instances.clear();
+            batch.bounds.clear();
+        }
+        entityStats = EntityRenderStats();
+        materialPacker.Clear();
+        textureManager.SetExternalBytes(0);
+        materialsActive = false;
         map.entities.clear();
     }
 
-    void World::Render(Shader& shader) {
-        // Set model matrix to identity (level geometry is in world space)
-        glm::mat4 model = glm::mat4(1.0f);
-        shader.SetMat4("model", model);
+    void World::Render(Shader& shader, const Camera& camera, RenderQueue& queue) {
+        // Collect visible objects (cullBounds is parallel to levelGeometry)
+        auto cullStart = std::chrono::steady_clock::now();
+        if (frustumCulling) {
+            Frustum frustum = Frustum::FromMatrices(camera.GetViewMatrix(), camera.GetProjectionMatrix());
+            cullBounds.Cull(frustum, visibleObjects);
+        } else {
+            visibleObjects.resize(levelGeometry.size());
+            for (size_t i = 0; i < visibleObjects.size(); i++) {
+                visibleObjects[i] = static_cast<uint32_t>(i);
+            }
+        }
+        cullingStats.tested = static_cast<int>(levelGeometry.size());
+        cullingStats.culled = cullingStats.tested - static_cast<int>(visibleObjects.size());
+        ApplyVisibility(camera.GetPosition());
+        cullingStats.visible = static_cast<int>(visibleObjects.size());
+        cullingStats.occlusionCulled = 0;
+        cullingStats.cullMs = ElapsedMs(cullStart);
+
+        // Packets use an identity model matrix (level geometry is baked into engine space at load)
+        // and, in array mode, share the material arrays: the first goes through the packets on
+        // unit 1, the size classes after it stay bound on the following units for the frame
+        materialTexture = materialsActive ? materialPacker.GetTextureID() : 0;
+        if (materialsActive) {
+            materialPacker.Bind(1);
+            queue.InvalidateState();
+            const std::vector<int>& slots = materialPacker.GetLayerSlots();
+            if (!slots.empty()) {
+                shader.SetIntArray("uLayerSlots", slots.data(), static_cast<int>(slots.size()));
+            }
+        }
+
+        // Point entity markers and brush entities go through the queue in both paths
+        RenderEntities(shader, camera, queue);
+        RenderBrushEntities(shader, camera, queue);
+
+        if (streamingActive) {
+            RenderStreamedRegions(shader, camera, queue);
+            return;
+        }
+
+        if (occlusionCulling && occlusion.IsBuilt()) {
+            DrawWithOcclusion(shader, camera.GetPosition(), queue);
+            return;
+        }
+
+        for (uint32_t index : visibleObjects) {
+            float distance = glm::length(levelGeometry[index].bounds.GetCenter() - camera.GetPosition());
+            queue.Submit(MakeDrawPacket(shader, levelGeometry[index]), distance);
+        }
+    }
+
+    DrawPacket World::MakeDrawPacket(const Shader& shader, const RenderObject& obj) {
+        DrawPacket packet;
+        packet.shader = &shader;
+        packet.vertexArray = obj.mesh.GetVAO();
+        packet.indexCount = obj.mesh.GetIndexCount();
+        packet.indexType = obj.mesh.GetIndexType();
+
+        if (materialsActive) {
+            // Each vertex selects its layer
+            packet.texture = materialTexture;
+            packet.textureTarget = GL_TEXTURE_2D_ARRAY;
+            packet.textureUnit = 1;
+            packet.useTextureArray = true;
+        } else if (Texture* texture = obj.texture.Get()) {
+            // Shared fallback while loading
+            packet.texture = texture->GetID();
+        }
+        return packet;
+    }
+
+    void World::DrawWithOcclusion(Shader& shader, const glm::vec3& cameraPosition, RenderQueue& queue) {
+        // Clusters are drawn right away (inside their queries), bypassing the queue's sort
+        queue.InvalidateState();
+        occlusion.BeginFrame(cameraPosition);
+
+        // Bucket visible objects by cluster
+        drawClusters.clear();
+        for (uint32_t index : visibleObjects) {
+            int cluster = occlusion.GetObjectCluster(index);
+            if (clusterObjects[cluster].empty()) {
+                drawClusters.push_back(cluster);
+            }
+            clusterObjects[cluster].push_back(index);
+        }
+
+        // Front to back, so nearby clusters are in the depth buffer when farther ones are queried
+        std::sort(drawClusters.begin(), drawClusters.end(), [&](int a, int b) {
+            glm::vec3 toA = occlusion.GetClusterBounds(a).GetCenter() - cameraPosition;
+            glm::vec3 toB = occlusion.GetClusterBounds(b).GetCenter() - cameraPosition;
+            return glm::dot(toA, toA) < glm::dot(toB, toB);
+        });
+
+        for (int cluster : drawClusters) {
+            std::vector<uint32_t>& objects = clusterObjects[cluster];
+            if (occlusion.ShouldDraw(cluster, static_cast<int>(objects.size()))) {
+                occlusion.BeginQuery(cluster);
+                for (uint32_t index : objects) {
+                    queue.DrawImmediate(MakeDrawPacket(shader, levelGeometry[index]));
+                }
+                occlusion.EndQuery(cluster);
+            }
+            objects.clear();
+        }
+
+        // Re-test skipped clusters against this frame's depth; results are read next frame
+        occlusion.QueryHidden(shader);
+        queue.InvalidateState();
+
+        const OcclusionStats& occlusionStats = occlusion.GetStats();
+        cullingStats.occlusionCulled = occlusionStats.objectsCulled;
+        cullingStats.visible -= occlusionStats.objectsCulled;
+        cullingStats.culled += occlusionStats.objectsCulled;
+    }
+
+    void World::LoadVisibility(const std::string& mapPath, bool allowBuild) {
+        std::string pvsPath = Visibility::GetPVSPath(mapPath);
+        VisibilitySettings settings;
+        uint64_t mapHash = Visibility::GetCacheKey(mapPath, settings);
+
+        if (!visibility.Load(pvsPath, mapHash)) {
+            if (!allowBuild) {
+                LOG_INFO("PVS culling is off until " + mapPath + " is fully reloaded");
+                leafObjects.clear();
+                return;
+            }
+            if (!visibility.Build(worldspawn.brushes, settings)) {
+                return;
+            }
+            if (!visibility.Save(pvsPath, mapHash)) {
+                LOG_WARNING("Could not cache PVS to " + pvsPath + ", it will be rebuilt on next load");
+            }
+        }
+
+        // Register each object in every leaf it touches (slightly enlarged so faces
+        // lying on a leaf boundary belong to both sides)
+        leafObjects.assign(visibility.GetLeafCount(), std::vector<uint32_t>());
+        objectVisibleFrame.assign(levelGeometry.size(), 0);
+        visibilityFrame = 0;
+
+        std::vector<int> leaves;
+        for (uint32_t index = 0; index < levelGeometry.size(); index++) {
+            AABB bounds = levelGeometry[index].bounds;
+            bounds.min -= glm::vec3(1.0f);
+            bounds.max += glm::vec3(1.0f);
+            visibility.GetLeavesOverlapping(bounds, leaves);
+            for (int leaf : leaves) {
+                leafObjects[leaf].push_back(index);
+            }
+        }
+    }
+
+    void World::ApplyVisibility(const glm::vec3& cameraPosition) {
+        cullingStats.pvsCulled = 0;
+        if (!visibilityCulling || !visibility.IsValid()) return;
 
-        // Render all level geometry
-        for (auto& obj : levelGeometry) {
-            // Bind texture
-            if (obj.texture) {
-                obj.texture->Bind(0);
+        // Outside the level or inside a solid leaf (noclip): frustum culling only
+        int cameraLeaf = visibility.FindLeaf(cameraPosition);
+        if (cameraLeaf < 0 || visibility.IsLeafSolid(cameraLeaf)) return;
+
+        visibilityFrame++;
+        for (int leaf = 0; leaf < visibility.GetLeafCount(); leaf++) {
+            if (!visibility.IsLeafVisible(cameraLeaf, leaf)) continue;
+            for (uint32_t index : leafObjects[leaf]) {
+                objectVisibleFrame[index] = visibilityFrame;
             }
-            
-            // Draw mesh
-            obj.mesh.Draw(shader);
         }
+
+        size_t before = visibleObjects.size();
+        visibleObjects.erase(std::remove_if(visibleObjects.begin(), visibleObjects.end(),
+                                            [this](uint32_t index) {
+                                                return objectVisibleFrame[index] != visibilityFrame;
+                                            }),
+                             visibleObjects.end());
+        cullingStats.pvsCulled = static_cast<int>(before - visibleObjects.size());
+        cullingStats.culled += cullingStats.pvsCulled;
     }
 
     void World::Update(float deltaTime) {
-        // Future: update dynamic entities, doors, etc.
+        // Stream in async textures, bounded per frame to avoid hitches
+        if (!textureLoader.IsIdle()) {
+            textureLoader.ProcessUploads(MAX_TEXTURE_UPLOADS_PER_FRAME);
+        }
+        if (materialsActive && !materialPacker.IsBuilt() && textureLoader.IsIdle()) {
+            BuildMaterials();
+        }
+        if (reportTextureLoad && textureLoader.IsIdle()) {
+            FinishTextureLoadReport();
+        }
+
+        UpdateBrushEntities(deltaTime);
+
+        // Region conversion runs on workers; finished regions are uploaded here, a bounded number per frame
+        if (streamingActive && hasActivator) {
+            streamer.Update(activator,
+                            [this](uint32_t region, std::vector<BrushGeometry>& geometry) {
+                                LoadStreamedRegion(region, geometry);
+                            },
+                            [this](uint32_t region) { UnloadStreamedRegion(region); });
+        }
+    }
+
+    void World::LoadStreamedRegion(uint32_t region, std::vector<BrushGeometry>& geometry) {
+        StreamedRegion& resident = regionObjects[region];
+        const std::vector<uint32_t>& brushes = streamer.GetRegionBrushes(region);
+        for (size_t i = 0; i < geometry.size(); i++) {
+            if (geometry[i].vertices.empty()) continue;
+
+            RenderObject obj = UploadBrush(geometry[i], streamer.GetBrush(brushes[i]));
+            resident.proxies.push_back(colliders.Insert(obj.bounds, region | STREAMED_REGION_PROXY));
+            resident.objects.push_back(std::move(obj));
+        }
+        LOG_CAT_DEBUG(Map, "Streamed in region {} ({} objects)", region, resident.objects.size());
+    }
+
+    void World::UnloadStreamedRegion(uint32_t region) {
+        StreamedRegion& resident = regionObjects[region];
+        for (uint32_t proxy : resident.proxies) {
+            colliders.Remove(proxy);
+        }
+
+        // Frees the GL buffers and drops the texture references (the manager evicts over budget)
+        resident = StreamedRegion();
+        LOG_CAT_DEBUG(Map, "Streamed out region {}", region);
+    }
+
+    void World::UpdateBrushEntities(float deltaTime) {
+        for (size_t i = 0; i < brushEntities.size(); i++) {
+            BrushEntity& entity = brushEntities[i];
+            if (entity.motion == BrushMotion::None) continue;
+
+            // Leave the rest position (closed, or open for "Starts Open") while the activator
+            // is near; once there, go back after wait seconds alone (-1 never goes back)
+            float activated = entity.startsOpen ? 0.0f : 1.0f;
+            float toActivated = entity.startsOpen ? -1.0f : 1.0f;
+            if (hasActivator && entity.activationBounds.Contains(activator)) {
+                if (entity.position != activated) entity.direction = toActivated;
+                entity.waitTimer = entity.wait;
+            } else if (entity.position == activated && entity.wait >= 0.0f) {
+                entity.waitTimer -= deltaTime;
+                if (entity.waitTimer <= 0.0f) entity.direction = -toActivated;
+            }
+            if (entity.direction == 0.0f) continue;
+
+            entity.position = std::clamp(entity.position + entity.direction * deltaTime / entity.travelTime, 0.0f, 1.0f);
+            if (entity.position == 0.0f || entity.position == 1.0f) {
+                entity.direction = 0.0f;
+            }
+
+            // Meshes stay untouched; the grid only re-bins when the cells covered change
+            entity.transform = GetBrushEntityTransform(entity);
+            entity.bounds = TransformBounds(entity.localBounds, entity.transform);
+            if (entity.solid) {
+                colliders.Update(entity.proxy, entity.bounds);
+            }
+        }
     }
 
     glm::vec3 World::GetPlayerSpawnPosition() const {
@@ -118,9 +984,9 @@ namespace VibeReaper {
             }
         }
 
-        // Default spawn if not found
+        // Default spawn if not found (32 units above the origin)
         LOG_WARNING("No info_player_start found, using default spawn");
-        return glm::vec3(0.0f, 0.0f, 32.0f);
+        return glm::vec3(0.0f, 32.0f, 0.0f);
     }
 
     float World::GetPlayerSpawnAngle() const {
@@ -145,7 +1011,6 @@ namespace VibeReaper {
     }
 
     void World::SpawnEntities() {
-        // Log entities for debugging
         for (const auto& entity : map.entities) {
             if (entity.classname == "worldspawn") {
                 continue; // Already processed
@@ -156,8 +1021,119 @@ namespace VibeReaper {
                      std::to_string(entity.GetOrigin().y) + ", " +
                      std::to_string(entity.GetOrigin().z));
 
-            // Future phases will spawn actual game objects here
-            // For now, just log them
+            // Brush entities and the player start aren't drawn as markers
+            if (!entity.brushes.empty() || entity.classname == "info_player_start") {
+                continue;
+            }
+
+            // Future phases will spawn actual game objects here; for now each
+            // point entity is an instanced marker
+            if (entity.classname == "light") {
+                glm::vec3 color = entity.GetVector3("_color", glm::vec3(1.0f, 0.9f, 0.6f));
+                AddEntityInstance(BATCH_SPHERE, entity.GetOrigin(), 0.25_u, glm::vec4(color, 1.0f));
+            } else {
+                AddEntityInstance(BATCH_CUBE, entity.GetOrigin(), 0.25_u, glm::vec4(0.8f, 0.3f, 0.8f, 1.0f));
+            }
+        }
+    }
+
+    void World::AddEntityInstance(EntityBatchIndex batchIndex, const glm::vec3& position, float size,
+                                  const glm::vec4& color) {
+        EntityBatch& batch = entityBatches[batchIndex];
+
+        // Meshes and instance buffers are created with the first instance
+        if (!batch.mesh.IsSetup()) {
+            batch.mesh = batchIndex == BATCH_SPHERE ? Mesh::GenerateSphere(1) : Mesh::GenerateCube();
+            batch.mesh.SetupMesh();
+            batch.instanceBuffer.Create();
+            batch.mesh.AttachInstanceBuffer(batch.instanceBuffer);
+        }
+
+        // Unit meshes span [-0.5, 0.5]
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), position);
+        model = glm::scale(model, glm::vec3(size));
+        batch.instances.emplace_back(model, color);
+        batch.bounds.push_back(AABB::FromCenterAndExtents(position, glm::vec3(size * 0.5f)));
+    }
+
+    void World::SpawnDebugMarkers(const glm::vec3& center, int count) {
+        // Square grid of cubes around center, 1m apart
+        int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count))));
+        for (int i = 0; i < count; i++) {
+            glm::vec3 offset((i % side - side * 0.5f) * 1.0_u, 0.5_u, (i / side - side * 0.5f) * 1.0_u);
+            glm::vec4 color(0.3f + 0.7f * (i % 7) / 6.0f, 0.3f + 0.7f * (i % 5) / 4.0f, 0.3f + 0.7f * (i % 3) / 2.0f, 1.0f);
+            AddEntityInstance(BATCH_CUBE, center + offset, 0.25_u, color);
+        }
+        LOG_INFO("Spawned " + std::to_string(count) + " debug markers (" +
+                 std::to_string(entityBatches[BATCH_CUBE].instances.size()) + " cube instances total)");
+    }
+
+    void World::RenderEntities(Shader& shader, const Camera& camera, RenderQueue& queue) {
+        entityStats = EntityRenderStats();
+        Frustum frustum = Frustum::FromMatrices(camera.GetViewMatrix(), camera.GetProjectionMatrix());
+
+        for (EntityBatch& batch : entityBatches) {
+            entityStats.instances += static_cast<int>(batch.instances.size());
+            if (batch.instances.empty()) continue;
+
+            // Cull per instance, then stream the survivors for a single instanced draw
+            batch.visibleInstances.clear();
+            for (size_t i = 0; i < batch.instances.size(); i++) {
+                if (!frustumCulling || frustum.IsBoxVisible(batch.bounds[i])) {
+                    batch.visibleInstances.push_back(batch.instances[i]);
+                }
+            }
+            if (batch.visibleInstances.empty()) continue;
+
+            batch.instanceBuffer.Update(batch.visibleInstances);
+            entityStats.visible += static_cast<int>(batch.visibleInstances.size());
+            entityStats.bytesStreamed += batch.instanceBuffer.GetBytesUploaded();
+            entityStats.drawCalls++;
+
+            DrawPacket packet;
+            packet.shader = &shader;
+            packet.vertexArray = batch.mesh.GetVAO();
+            packet.indexCount = batch.mesh.GetIndexCount();
+            packet.indexType = batch.mesh.GetIndexType();
+            packet.instanceCount = static_cast<GLsizei>(batch.visibleInstances.size());
+            queue.Submit(packet, glm::length(batch.bounds[0].GetCenter() - camera.GetPosition()));
+        }
+    }
+
+    void World::RenderStreamedRegions(Shader& shader, const Camera& camera, RenderQueue& queue) {
+        // Whole regions first, then the objects of regions in view
+        Frustum frustum = Frustum::FromMatrices(camera.GetViewMatrix(), camera.GetProjectionMatrix());
+        cullingStats.tested = 0;
+        cullingStats.visible = 0;
+
+        for (uint32_t region = 0; region < regionObjects.size(); region++) {
+            const StreamedRegion& resident = regionObjects[region];
+            cullingStats.tested += static_cast<int>(resident.objects.size());
+            if (resident.objects.empty()) continue;
+            if (frustumCulling && !frustum.IsBoxVisible(streamer.GetRegionBounds(region))) continue;
+
+            for (const RenderObject& obj : resident.objects) {
+                if (frustumCulling && !frustum.IsBoxVisible(obj.bounds)) continue;
+                cullingStats.visible++;
+                queue.Submit(MakeDrawPacket(shader, obj), glm::length(obj.bounds.GetCenter() - camera.GetPosition()));
+            }
+        }
+        cullingStats.culled = cullingStats.tested - cullingStats.visible;
+    }
+
+    void World::RenderBrushEntities(Shader& shader, const Camera& camera, RenderQueue& queue) {
+        Frustum frustum = Frustum::FromMatrices(camera.GetViewMatrix(), camera.GetProjectionMatrix());
+
+        for (const BrushEntity& entity : brushEntities) {
+            if (entity.parts.empty()) continue;
+            if (frustumCulling && !frustum.IsBoxVisible(entity.bounds)) continue;
+
+            float distance = glm::length(entity.bounds.GetCenter() - camera.GetPosition());
+            for (const RenderObject& part : entity.parts) {
+                DrawPacket packet = MakeDrawPacket(shader, part);
+                packet.model = entity.transform;
+                queue.Submit(packet, distance);
+            }
         }
     }
 
@@ -4,15 +4,92 @@
 #include "../Engine/BrushConverter.h"
 #include "../Engine/Mesh.h"
 #include "../Engine/Texture.h"
+#include "../Engine/TextureLoader.h"
+#include "../Engine/TextureManager.h"
+#include "../Engine/MaterialPacker.h"
+#include "../Engine/Frustum.h"
+#include "../Engine/Visibility.h"
+#include "../Engine/OcclusionCuller.h"
+#include "../Engine/RenderQueue.h"
+#include "../Engine/InstanceBuffer.h"
+#include "../Engine/Camera.h"
+#include "../Engine/JobSystem.h"
+#include "../Engine/Broadphase.h"
+#include "../Engine/RegionStreamer.h"
+#include "../Engine/BrushCache.h"
 #include <vector>
 #include <string>
 #include <map>
+#include <chrono>
 
 namespace VibeReaper {
 
     struct RenderObject {
         Mesh mesh;
-        Texture* texture;
+        TextureHandle texture;   // Empty when the world is drawn from the material array
+        AABB bounds;             // World-space bounds, computed once at load
+    };
+
+    // How a brush entity moves: func_door slides, func_door_rotating swings about its pivot
+    enum class BrushMotion { None, Slide, Rotate };
+
+    /**
+     * @brief A func_* / trigger_* entity built from its own brushes
+     *
+     * Meshes are converted and uploaded once, relative to pivot; moving the
+     * entity only rewrites transform (drawn as uModel) and its world bounds.
+     */
+    struct BrushEntity {
+        std::string classname;
+        std::vector<RenderObject> parts;        // One per brush, bounds in local space
+        AABB localBounds;
+        glm::vec3 pivot = glm::vec3(0.0f);      // World position of the local origin when closed
+        glm::mat4 transform = glm::mat4(1.0f);
+        AABB bounds;                            // World-space bounds at the current transform
+        uint32_t proxy = UINT32_MAX;            // Collider handle (solid entities only)
+        bool solid = true;                      // Blocks the camera and, later, movement
+        bool visible = true;                    // Triggers have no meshes
+
+        // Mover state; position runs from 0 (closed) to 1 (open)
+        BrushMotion motion = BrushMotion::None;
+        glm::vec3 moveOffset = glm::vec3(0.0f); // Slide: offset when fully open
+        float openAngle = 0.0f;                 // Rotate: degrees about Y when fully open
+        float travelTime = 1.0f;                // Seconds from closed to open
+        float wait = 3.0f;                      // Seconds open before closing, -1 stays open
+        bool startsOpen = false;                // Spawnflag 1: rests open, closes when activated
+        float position = 0.0f;
+        float direction = 0.0f;                 // 1 opening, -1 closing, 0 at rest
+        float waitTimer = 0.0f;
+        AABB activationBounds;                  // The activator inside this opens the door
+    };
+
+    // Identical meshes drawn with one instanced call (point entity markers)
+    struct EntityBatch {
+        Mesh mesh;
+        InstanceBuffer instanceBuffer;
+        std::vector<InstanceData> instances;
+        std::vector<AABB> bounds;                   // Parallel to instances, for culling
+        std::vector<InstanceData> visibleInstances; // Streamed each frame
+    };
+
+    // Level mesh memory after load (CPU bytes include collision copies)
+    struct MeshMemoryStats {
+        size_t meshes = 0;
+        size_t vertices = 0;
+        size_t indices = 0;
+        size_t floatMeshes = 0;         // Meshes that could not use the packed layout
+        size_t gpuVertexBytes = 0;
+        size_t gpuIndexBytes = 0;
+        size_t cpuSourceBytes = 0;      // Converted vertices/indices before upload
+        size_t cpuRetainedBytes = 0;    // Still resident after SetupMesh()
+        size_t collisionBytes = 0;
+    };
+
+    struct EntityRenderStats {
+        int instances = 0;
+        int visible = 0;
+        int drawCalls = 0;
+        size_t bytesStreamed = 0;
     };
 
     // World manager for level geometry and entities
@@ -21,32 +98,198 @@ namespace VibeReaper {
         World();
         ~World();
 
-        // Map loading
+        // Map loading. Loading the current map again keeps the meshes of unchanged brushes;
+        // other brushes come from the .brushes cache next to the map when it has them.
         bool LoadMap(const std::string& mapPath);
         void Unload();
+        const std::string& GetMapPath() const { return loadedMapPath; }
+
+        // Hot reload: re-parse the current map and re-convert only worldspawn brushes
+        // whose planes changed, keeping the other meshes. Streamed levels and edits that
+        // add texture array layers fall back to a full LoadMap(); a file that does not
+        // parse (e.g. saved halfway) keeps the current level.
+        bool ReloadMap();
+
+        // Hot reload of a texture file: per-brush textures are re-uploaded, array layers
+        // updated in place. False if the level does not use it.
+        bool ReloadTexture(const std::string& path);
+
+        // Texture loading mode (async decodes on worker threads while brushes convert)
+        void SetAsyncTextureLoading(bool enabled) { asyncTextureLoading = enabled; }
+        bool IsLoadingTextures() const { return !textureLoader.IsIdle(); }
+
+        // Draw the static world from one texture array (layer per face) instead of
+        // binding a texture per brush. Takes effect on the next LoadMap().
+        void SetUseTextureArrays(bool enabled) { useTextureArrays = enabled; }
+        const MaterialPacker& GetMaterials() const { return materialPacker; }
+
+        // Upload brush meshes with the compact PackedVertex layout (24 instead of
+        // 36 bytes per vertex). Takes effect on the next LoadMap().
+        void SetPackedVertices(bool enabled) { packedVertices = enabled; }
+
+        // What brush meshes keep in RAM after upload (default: nothing). Camera and
+        // broadphase collision only use bounds, so KeepCollision is for code that
+        // needs the welded triangles. Takes effect on the next LoadMap().
+        void SetMeshRetention(MeshRetention policy) { meshRetention = policy; }
+        const MeshMemoryStats& GetMeshMemoryStats() const { return meshMemory; }
 
-        // Rendering
-        void Render(Shader& shader);
+        // Stream worldspawn in grid regions around the activator instead of building it
+        // all in LoadMap(). Streamed levels use per-brush textures (no texture array) and
+        // skip the PVS and occlusion clusters. Takes effect on the next LoadMap().
+        void SetStreaming(bool enabled, const StreamingSettings& settings = StreamingSettings()) {
+            streaming = enabled;
+            streamingSettings = settings;
+        }
+        bool IsStreaming() const { return streamingActive; }
+        const StreamingStats& GetStreamingStats() const { return streamer.GetStats(); }
+
+        // Textures stay cached across map loads within this budget (LRU eviction)
+        void SetTextureBudget(size_t bytes) { textureManager.SetBudget(bytes); }
+        const TextureManager& GetTextureManager() const { return textureManager; }
+
+        // Rendering: submits visible objects to the queue (objects outside the camera
+        // frustum or the camera leaf's PVS are skipped)
+        void Render(Shader& shader, const Camera& camera, RenderQueue& queue);
+        void SetFrustumCulling(bool enabled) { frustumCulling = enabled; }
+        void SetVisibilityCulling(bool enabled) { visibilityCulling = enabled; }
+
+        // Optional GPU occlusion queries per object cluster, for open areas the PVS can't cull
+        void SetOcclusionCulling(bool enabled) { occlusionCulling = enabled; }
+        bool IsOcclusionCulling() const { return occlusionCulling; }
+        const OcclusionStats& GetOcclusionStats() const { return occlusion.GetStats(); }
+
+        // Point entity markers (instanced, one draw call per marker mesh)
+        void SpawnDebugMarkers(const glm::vec3& center, int count);
+        const EntityRenderStats& GetEntityRenderStats() const { return entityStats; }
+        const Visibility& GetVisibility() const { return visibility; }
+        const CullingStats& GetCullingStats() const { return cullingStats; }
         void Update(float deltaTime);
 
-        // Entity queries
+        // Entity queries (positions are in engine Y-up space)
         glm::vec3 GetPlayerSpawnPosition() const;
         float GetPlayerSpawnAngle() const;
         std::vector<const Entity*> GetEntitiesByClass(const std::string& classname) const;
         const Entity* GetWorldspawn() const { return &worldspawn; }
 
+        // Brush entities (doors, walls, triggers); movers open when the activator
+        // (the player, set each frame before Update) comes near, and streamed
+        // regions load around it
+        const std::vector<BrushEntity>& GetBrushEntities() const { return brushEntities; }
+        void SetActivator(const glm::vec3& position) { activator = position; hasActivator = true; }
+
         // Collision queries
         const std::vector<RenderObject>& GetLevelGeometry() const { return levelGeometry; }
 
+        // Solid static geometry and brush entities at their current position; user data
+        // is a levelGeometry index, a brushEntities index | BRUSH_ENTITY_PROXY or a
+        // streamed region index | STREAMED_REGION_PROXY
+        const Broadphase& GetColliders() const { return colliders; }
+        static constexpr uint32_t BRUSH_ENTITY_PROXY = 0x80000000u;
+        static constexpr uint32_t STREAMED_REGION_PROXY = 0x40000000u;
+
     private:
-        // Level data
+        // Workers for load-time brush conversion
+        JobSystem jobs;
+
+        // Texture streaming (declared first: must outlive the handles below)
+        TextureLoader textureLoader;
+        TextureManager textureManager;
+
+        // Level data (levelKeys[i] is the BrushCache key levelGeometry[i] was built from,
+        // levelMeshFormat the GetMeshFormat() it was uploaded with)
+        std::string loadedMapPath;
         std::vector<RenderObject> levelGeometry;
-        std::map<std::string, Texture> textureCache;
+        std::vector<uint64_t> levelKeys;
+        uint32_t levelMeshFormat;
+        BrushCache brushCache;      // Only filled while a level loads
+        std::map<std::string, TextureHandle> levelTextures;    // Keeps this level's textures referenced
+
+        // Brush entities and the collision grid they share with levelGeometry
+        std::vector<BrushEntity> brushEntities;
+        Broadphase colliders;
+        glm::vec3 activator;
+        bool hasActivator;
+
+        // Streaming (regionObjects[region] holds a resident region's meshes and colliders)
+        struct StreamedRegion {
+            std::vector<RenderObject> objects;
+            std::vector<uint32_t> proxies;
+        };
+        RegionStreamer streamer;
+        StreamingSettings streamingSettings;
+        std::vector<StreamedRegion> regionObjects;
+        bool streaming;
+        bool streamingActive;   // Level was loaded with streaming
+
+        // Frustum culling (cullBounds index == levelGeometry index)
+        CullingBounds cullBounds;
+        std::vector<uint32_t> visibleObjects;
+        CullingStats cullingStats;
+        bool frustumCulling;
+
+        // Potentially visible set (leafObjects[leaf] lists levelGeometry indices)
+        Visibility visibility;
+        std::vector<std::vector<uint32_t>> leafObjects;
+        std::vector<uint32_t> objectVisibleFrame;   // Last frame each object was in the PVS
+        uint32_t visibilityFrame;
+        bool visibilityCulling;
+
+        // Occlusion queries (clusterObjects/drawClusters are per-frame scratch)
+        OcclusionCuller occlusion;
+        std::vector<std::vector<uint32_t>> clusterObjects;
+        std::vector<int> drawClusters;
+        bool occlusionCulling;
+        bool asyncTextureLoading;
+        MaterialPacker materialPacker;
+        bool useTextureArrays;
+        bool packedVertices;
+        MeshRetention meshRetention;
+        MeshMemoryStats meshMemory;
+        bool materialsActive;   // Level was built with texture array layers
+        unsigned int materialTexture;   // Array bound by this frame's packets
         Map map;
         Entity worldspawn;
 
-        // Spawning (stubs for now, will implement in later phases)
+        // Entity markers: cubes for generic point entities, spheres for lights
+        enum EntityBatchIndex { BATCH_CUBE = 0, BATCH_SPHERE, BATCH_COUNT };
+        EntityBatch entityBatches[BATCH_COUNT];
+        EntityRenderStats entityStats;
+
+        // Load timing (map load is only complete once async textures are resident)
+        std::chrono::steady_clock::time_point loadStartTime;
+        bool reportTextureLoad;
+
+        // Load stages
+        void ConvertToEngineSpace();
+        void RequestTextures();
+        void RequestMaterials();
+        void BuildMaterials();
+        TextureHandle AcquireTexture(const std::string& textureName);
+        RenderObject UploadBrush(BrushGeometry& geometry, const Brush& brush);
+        void LoadBrushEntities();
+        size_t BuildLevelGeometry(std::vector<RenderObject>& previous, const std::vector<uint64_t>& previousKeys);
+        void IndexLevelGeometry();
+        void BuildStaticCulling(const std::string& mapPath, bool buildVisibility = true);
+        std::vector<uint64_t> MakeBrushKeys(const std::vector<Brush>& brushes);
+        void SaveBrushCache(const std::string& mapPath);
+        uint32_t GetMeshFormat() const { return (packedVertices ? 1u : 0u) | (static_cast<uint32_t>(meshRetention) << 1); }
+        void FinishTextureLoadReport();
+        void LoadVisibility(const std::string& mapPath, bool allowBuild);
+        void ApplyVisibility(const glm::vec3& cameraPosition);
+        DrawPacket MakeDrawPacket(const Shader& shader, const RenderObject& obj);
+        void DrawWithOcclusion(Shader& shader, const glm::vec3& cameraPosition, RenderQueue& queue);
+        void AccumulateMeshMemory(const Mesh& mesh, size_t sourceBytes);
+        void LogMeshMemory() const;
+
+        // Spawning (point entities become instanced markers for now)
         void SpawnEntities();
+        void AddEntityInstance(EntityBatchIndex batch, const glm::vec3& position, float size, const glm::vec4& color);
+        void RenderEntities(Shader& shader, const Camera& camera, RenderQueue& queue);
+        void RenderBrushEntities(Shader& shader, const Camera& camera, RenderQueue& queue);
+        void UpdateBrushEntities(float deltaTime);
+        void LoadStreamedRegion(uint32_t region, std::vector<BrushGeometry>& geometry);
+        void UnloadStreamedRegion(uint32_t region);
+        void RenderStreamedRegions(Shader& shader, const Camera& camera, RenderQueue& queue);
     };
 
 } // namespace VibeReaper
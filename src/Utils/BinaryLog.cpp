@@ -0,0 +1,464 @@
+#include "BinaryLog.h"
+#include "LogFormat.h"
+#include "Logger.h"
+#include <ctime>
+
+namespace VibeReaper {
+
+namespace {
+    const char MAGIC[4] = { 'V', 'R', 'B', 'L' };
+    // Recycled thread buffers kept around for the next Submit()
+    const size_t MAX_FREE_BUFFERS = 16;
+
+    template <typename T>
+    void Put(std::vector<uint8_t>& out, T value) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    void PutString(std::vector<uint8_t>& out, const std::string& value) {
+        uint16_t length = static_cast<uint16_t>(std::min<size_t>(value.size(), 0xFFFF));
+        Put(out, length);
+        out.insert(out.end(), value.begin(), value.begin() + length);
+    }
+
+    // Bounds-checked reads for the decoder
+    struct Cursor {
+        const uint8_t* data;
+        size_t size;
+        size_t offset;
+
+        template <typename T>
+        bool Read(T& value) {
+            if (size - offset < sizeof(T)) return false;
+            std::memcpy(&value, data + offset, sizeof(T));
+            offset += sizeof(T);
+            return true;
+        }
+
+        bool ReadString(std::string& value) {
+            uint16_t length;
+            if (!Read(length) || size - offset < length) return false;
+            value.assign(reinterpret_cast<const char*>(data + offset), length);
+            offset += length;
+            return true;
+        }
+    };
+
+    bool DecodeArg(Cursor& cursor, BinaryArgType type, std::string& out) {
+        switch (type) {
+            case BinaryArgType::Int32:  { int32_t v;  if (!cursor.Read(v)) return false; LogFormat::AppendArg(out, v); return true; }
+            case BinaryArgType::UInt32: { uint32_t v; if (!cursor.Read(v)) return false; LogFormat::AppendArg(out, v); return true; }
+            case BinaryArgType::Int64:  { int64_t v;  if (!cursor.Read(v)) return false; LogFormat::AppendArg(out, v); return true; }
+            case BinaryArgType::UInt64: { uint64_t v; if (!cursor.Read(v)) return false; LogFormat::AppendArg(out, v); return true; }
+            case BinaryArgType::Float:  { float v;    if (!cursor.Read(v)) return false; LogFormat::AppendArg(out, v); return true; }
+            case BinaryArgType::Double: { double v;   if (!cursor.Read(v)) return false; LogFormat::AppendArg(out, v); return true; }
+            case BinaryArgType::Bool:   { uint8_t v;  if (!cursor.Read(v)) return false; LogFormat::AppendArg(out, v != 0); return true; }
+            case BinaryArgType::Vec3: {
+                glm::vec3 v;
+                if (!cursor.Read(v.x) || !cursor.Read(v.y) || !cursor.Read(v.z)) return false;
+                LogFormat::AppendArg(out, v);
+                return true;
+            }
+            case BinaryArgType::String: {
+                std::string v;
+                if (!cursor.ReadString(v)) return false;
+                out += v;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Same rules as FormatLog(): "{}" takes the next argument, "{{"/"}}" are braces,
+    // leftover arguments are appended
+    std::string Substitute(const std::string& format, const std::vector<std::string>& args) {
+        std::string out;
+        size_t next = 0;
+        for (size_t i = 0; i < format.size(); i++) {
+            char c = format[i];
+            char following = i + 1 < format.size() ? format[i + 1] : '\0';
+            if ((c == '{' && following == '{') || (c == '}' && following == '}')) {
+                out += c;
+                i++;
+            } else if (c == '{' && following == '}' && next < args.size()) {
+                out += args[next++];
+                i++;
+            } else {
+                out += c;
+            }
+        }
+        for (; next < args.size(); next++) {
+            out += " [" + args[next] + "]";
+        }
+        return out;
+    }
+}
+
+BinaryLog& BinaryLog::GetInstance() {
+    static BinaryLog instance;
+    return instance;
+}
+
+BinaryLog::BinaryLog()
+    : m_open(false), m_generation(0), m_nextThreadIndex(0), m_formatsWritten(0),
+      m_submitted(0), m_written(0), m_stopping(false),
+      m_dropped(0), m_records(0), m_bytes(0), m_blocks(0) {
+}
+
+BinaryLog::~BinaryLog() {
+    // Thread buffers are gone by now (thread_local objects, including the main
+    // thread's, are destroyed before statics and submit their leftovers)
+    CloseFile();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeCondition.notify_one();
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+}
+
+bool BinaryLog::Open(const std::string& path) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_open) return true;
+
+    m_file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open()) {
+        LOG_ERROR("BinaryLog: could not open " + path);
+        return false;
+    }
+
+    std::vector<uint8_t> header(MAGIC, MAGIC + 4);
+    Put(header, VERSION);
+    Put(header, static_cast<int64_t>(std::chrono::steady_clock::now().time_since_epoch().count()));
+    Put(header, static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count()));
+    Put(header, static_cast<uint32_t>(std::chrono::steady_clock::period::num));
+    Put(header, static_cast<uint32_t>(std::chrono::steady_clock::period::den));
+    m_file.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+
+    // Format IDs stay valid across files; the table is written again into each one
+    m_formatsWritten = 0;
+    m_generation.fetch_add(1, std::memory_order_relaxed);
+    m_open = true;
+    if (!m_writer.joinable()) {
+        m_writer = std::thread(&BinaryLog::WriterLoop, this);
+    }
+
+    LOG_INFO("Binary log opened: " + path);
+    return true;
+}
+
+void BinaryLog::Close() {
+    if (!m_open) return;
+    Flush();
+    CloseFile();
+}
+
+void BinaryLog::CloseFile() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_open) return;
+    m_open = false;
+    // Other threads' unsubmitted buffers belong to this file; bumping the
+    // generation makes them start over instead of landing in the next one
+    m_generation.fetch_add(1, std::memory_order_relaxed);
+    m_writtenCondition.wait(lock, [this]() { return m_written >= m_submitted || m_stopping; });
+    m_file.close();
+}
+
+void BinaryLog::Flush() {
+    if (!m_open) return;
+
+    ThreadBuffer& buffer = GetThreadBuffer();
+    if (buffer.used > 0) {
+        Submit(buffer);
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    size_t target = m_submitted;
+    m_writtenCondition.wait(lock, [this, target]() { return m_written >= target || m_stopping; });
+}
+
+BinaryLogStats BinaryLog::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    BinaryLogStats stats;
+    stats.records = m_records;
+    stats.bytes = m_bytes;
+    stats.blocks = m_blocks;
+    stats.formats = m_formats.size();
+    stats.dropped = m_dropped.load();
+    return stats;
+}
+
+uint16_t BinaryLog::Register(BinaryFormatSite& site, const char* format, const BinaryArgType* types, size_t count) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint16_t id = site.id.load(std::memory_order_relaxed);
+    if (id != 0) return id;     // Another thread got here first
+    if (m_formats.size() >= 0xFFFF || count > 0xFF) return 0;
+
+    Format entry;
+    entry.id = static_cast<uint16_t>(m_formats.size() + 1);
+    entry.types.assign(types, types + count);
+    entry.line = site.line;
+    entry.file = site.file;
+    entry.format = format;
+    m_formats.push_back(std::move(entry));
+
+    site.id.store(m_formats.back().id, std::memory_order_release);
+    return m_formats.back().id;
+}
+
+BinaryLog::ThreadBuffer& BinaryLog::GetThreadBuffer() {
+    static thread_local ThreadBuffer buffer;
+
+    uint32_t generation = m_generation.load(std::memory_order_relaxed);
+    if (buffer.generation != generation) {
+        // First record on this thread, or leftovers from a closed file
+        if (buffer.threadIndex == 0) {
+            buffer.threadIndex = m_nextThreadIndex.fetch_add(1) + 1;
+        }
+        buffer.data.resize(THREAD_BUFFER_SIZE);
+        buffer.used = 0;
+        buffer.records = 0;
+        buffer.generation = generation;
+    }
+    return buffer;
+}
+
+BinaryLog::ThreadBuffer::~ThreadBuffer() {
+    // Thread exit: whatever is left goes to the file
+    if (used > 0) {
+        BinaryLog::GetInstance().Submit(*this, false);
+    }
+}
+
+void BinaryLog::Submit(ThreadBuffer& buffer, bool keepWriting) {
+    std::vector<uint8_t> fresh;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_open && buffer.generation == m_generation.load(std::memory_order_relaxed) && buffer.used > 0) {
+            Block block;
+            block.threadIndex = buffer.threadIndex;
+            block.records = buffer.records;
+            buffer.data.resize(buffer.used);
+            block.data = std::move(buffer.data);
+            m_pending.push_back(std::move(block));
+            m_submitted++;
+
+            if (keepWriting && !m_freeBuffers.empty()) {
+                fresh = std::move(m_freeBuffers.back());
+                m_freeBuffers.pop_back();
+            }
+        } else {
+            // Closed or stale: drop the records, keep the memory
+            fresh = std::move(buffer.data);
+        }
+    }
+    m_wakeCondition.notify_one();
+
+    if (keepWriting) {
+        fresh.resize(THREAD_BUFFER_SIZE);
+    }
+    buffer.data = std::move(fresh);
+    buffer.used = 0;
+    buffer.records = 0;
+}
+
+void BinaryLog::WriterLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_wakeCondition.wait(lock, [this]() { return m_stopping || !m_pending.empty(); });
+        if (m_pending.empty()) break;   // Stopping
+
+        std::vector<Block> blocks;
+        blocks.swap(m_pending);
+
+        // Formats go ahead of the first block that can use them
+        std::vector<uint8_t> chunks;
+        for (; m_formatsWritten < m_formats.size(); m_formatsWritten++) {
+            const Format& format = m_formats[m_formatsWritten];
+            Put(chunks, CHUNK_FORMAT);
+            Put(chunks, format.id);
+            Put(chunks, static_cast<uint8_t>(format.types.size()));
+            for (BinaryArgType type : format.types) {
+                Put(chunks, static_cast<uint8_t>(type));
+            }
+            Put(chunks, static_cast<uint32_t>(format.line));
+            PutString(chunks, format.file);
+            PutString(chunks, format.format);
+        }
+        lock.unlock();
+
+        size_t records = 0, bytes = 0;
+        m_file.write(reinterpret_cast<const char*>(chunks.data()), static_cast<std::streamsize>(chunks.size()));
+        for (const Block& block : blocks) {
+            std::vector<uint8_t> header;
+            Put(header, CHUNK_BLOCK);
+            Put(header, block.threadIndex);
+            Put(header, static_cast<uint32_t>(block.data.size()));
+            m_file.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+            m_file.write(reinterpret_cast<const char*>(block.data.data()), static_cast<std::streamsize>(block.data.size()));
+            records += block.records;
+            bytes += block.data.size();
+        }
+        m_file.flush();
+
+        lock.lock();
+        m_records += records;
+        m_bytes += bytes;
+        m_blocks += blocks.size();
+        m_written += blocks.size();
+        for (Block& block : blocks) {
+            if (m_freeBuffers.size() < MAX_FREE_BUFFERS) {
+                m_freeBuffers.push_back(std::move(block.data));
+            }
+        }
+        m_writtenCondition.notify_all();
+    }
+    m_writtenCondition.notify_all();
+}
+
+size_t BinaryLog::EncodedScalarSize(BinaryArgType type) {
+    switch (type) {
+        case BinaryArgType::Bool:   return 1;
+        case BinaryArgType::Int32:
+        case BinaryArgType::UInt32:
+        case BinaryArgType::Float:  return 4;
+        case BinaryArgType::Vec3:   return 12;
+        default:                    return 8;
+    }
+}
+
+uint8_t* BinaryLog::Encode(uint8_t* out, const glm::vec3& value) {
+    std::memcpy(out, &value.x, 4);
+    std::memcpy(out + 4, &value.y, 4);
+    std::memcpy(out + 8, &value.z, 4);
+    return out + 12;
+}
+
+uint8_t* BinaryLog::EncodeString(uint8_t* out, const char* value, size_t length) {
+    uint16_t stored = static_cast<uint16_t>(std::min(length, MAX_STRING));
+    std::memcpy(out, &stored, 2);
+    std::memcpy(out + 2, value, stored);
+    return out + 2 + stored;
+}
+
+// ---------------------------------------------------------------------------
+
+bool BinaryLogReader::Load(const std::string& path) {
+    entries.clear();
+    error.clear();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        error = "Could not open " + path;
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    Cursor cursor{ data.data(), data.size(), 0 };
+
+    char magic[4];
+    uint32_t version, tickNum, tickDen;
+    int64_t startTicks;
+    if (data.size() < 4 || std::memcmp(data.data(), MAGIC, 4) != 0) {
+        error = "Not a binary log: " + path;
+        return false;
+    }
+    cursor.offset = sizeof(magic);
+    if (!cursor.Read(version) || !cursor.Read(startTicks) || !cursor.Read(startTime) ||
+        !cursor.Read(tickNum) || !cursor.Read(tickDen) || tickDen == 0) {
+        error = "Truncated header";
+        return false;
+    }
+    if (version != BinaryLog::VERSION) {
+        error = "Unsupported version " + std::to_string(version);
+        return false;
+    }
+    double secondsPerTick = static_cast<double>(tickNum) / tickDen;
+
+    struct Format {
+        std::vector<BinaryArgType> types;
+        uint32_t line = 0;
+        std::string file;
+        std::string format;
+    };
+    std::vector<Format> formats(1);     // Index by id, 0 unused
+
+    uint8_t kind;
+    while (cursor.offset < cursor.size) {
+        size_t chunkStart = cursor.offset;
+        bool ok = cursor.Read(kind);
+
+        if (ok && kind == BinaryLog::CHUNK_FORMAT) {
+            uint16_t id;
+            uint8_t count;
+            Format format;
+            ok = cursor.Read(id) && cursor.Read(count);
+            for (uint8_t i = 0; ok && i < count; i++) {
+                uint8_t type;
+                ok = cursor.Read(type);
+                if (ok) format.types.push_back(static_cast<BinaryArgType>(type));
+            }
+            ok = ok && cursor.Read(format.line) && cursor.ReadString(format.file) && cursor.ReadString(format.format);
+            if (ok) {
+                if (formats.size() <= id) formats.resize(id + 1);
+                formats[id] = std::move(format);
+            }
+        } else if (ok && kind == BinaryLog::CHUNK_BLOCK) {
+            uint32_t thread, byteCount;
+            ok = cursor.Read(thread) && cursor.Read(byteCount) && cursor.size - cursor.offset >= byteCount;
+            Cursor block{ data.data(), cursor.offset + (ok ? byteCount : 0), cursor.offset };
+            while (ok && block.offset < block.size) {
+                uint16_t id;
+                int64_t ticks;
+                ok = block.Read(id) && block.Read(ticks) && id < formats.size() && !formats[id].format.empty();
+                if (!ok) break;
+
+                const Format& format = formats[id];
+                std::vector<std::string> args(format.types.size());
+                for (size_t i = 0; ok && i < format.types.size(); i++) {
+                    ok = DecodeArg(block, format.types[i], args[i]);
+                }
+                if (!ok) break;
+
+                BinaryLogEntry entry;
+                entry.thread = thread;
+                entry.seconds = (ticks - startTicks) * secondsPerTick;
+                entry.file = format.file;
+                entry.line = static_cast<int>(format.line);
+                entry.text = Substitute(format.format, args);
+                entries.push_back(std::move(entry));
+            }
+            cursor.offset = block.size;
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            // A crash can cut the last chunk short; keep everything before it
+            error = "Corrupt or truncated data at offset " + std::to_string(chunkStart);
+            break;
+        }
+    }
+
+    std::stable_sort(entries.begin(), entries.end(), [](const BinaryLogEntry& a, const BinaryLogEntry& b) {
+        return a.seconds < b.seconds;
+    });
+    return true;
+}
+
+std::string BinaryLogReader::FormatEntry(const BinaryLogEntry& entry, int64_t startTime) {
+    int64_t micros = startTime + static_cast<int64_t>(entry.seconds * 1e6);
+    std::time_t seconds = static_cast<std::time_t>(micros / 1000000);
+    char timestamp[32];
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", std::localtime(&seconds));
+
+    char prefix[80];
+    std::snprintf(prefix, sizeof(prefix), "[%s.%03d] [thread %u] ", timestamp,
+                  static_cast<int>((micros / 1000) % 1000), entry.thread);
+    return prefix + entry.text;
+}
+
+} // namespace VibeReaper
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace VibeReaper {
+
+// Argument encodings in a binary record (also written into the format table)
+enum class BinaryArgType : uint8_t {
+    Int32 = 1,
+    UInt32,
+    Int64,
+    UInt64,
+    Float,
+    Double,
+    Bool,
+    Vec3,
+    String      // uint16 length + bytes, capped at MAX_STRING
+};
+
+// One LOG_BINARY call site; registered the first time it is hit
+struct BinaryFormatSite {
+    BinaryFormatSite(const char* file, int line) : file(file), line(line), id(0) {}
+
+    const char* file;
+    int line;
+    std::atomic<uint16_t> id;   // 0 = not registered yet
+};
+
+struct BinaryLogStats {
+    size_t records = 0;
+    size_t bytes = 0;           // Record bytes written to the file
+    size_t blocks = 0;
+    size_t formats = 0;
+    size_t dropped = 0;         // Record bigger than a thread buffer
+};
+
+/**
+ * @brief Binary telemetry log for hot paths
+ *
+ * A LOG_BINARY call appends a format ID, a timestamp and its raw argument
+ * bytes to a buffer owned by the calling thread: no formatting, no locks, no
+ * allocation. Full buffers are handed to a background thread that writes
+ * them to the .bin file together with the format table; tools/LogDecoder
+ * turns the file back into text.
+ *
+ * A thread's records reach the file when its buffer fills, when it calls
+ * Flush(), or when it exits. Close() only flushes the calling thread.
+ *
+ * File layout (little-endian):
+ *   header  "VRBL", u32 version, i64 start ticks, i64 start time (us since epoch), u32 tick num, u32 tick den
+ *   chunks  u8 kind, then
+ *           FORMAT: u16 id, u8 argCount, u8 types[argCount], u32 line, u16 len + file, u16 len + format
+ *           BLOCK:  u32 thread, u32 byteCount, records
+ *   record  u16 format id, i64 ticks, arguments
+ */
+class BinaryLog {
+public:
+    static BinaryLog& GetInstance();
+
+    bool Open(const std::string& path = "VibeReaper.log.bin");
+    void Close();
+    bool IsOpen() const { return m_open.load(std::memory_order_relaxed); }
+
+    // Hand this thread's buffer to the writer and wait until everything handed over is on disk
+    void Flush();
+
+    BinaryLogStats GetStats() const;
+
+    template <typename... Args>
+    void Write(BinaryFormatSite& site, const char* format, const Args&... args);
+
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t THREAD_BUFFER_SIZE = 64 * 1024;
+    static constexpr size_t MAX_STRING = 1024;
+    static constexpr uint8_t CHUNK_FORMAT = 1;
+    static constexpr uint8_t CHUNK_BLOCK = 2;
+
+    // Encoding of each supported argument type
+    template <typename T>
+    static constexpr BinaryArgType ArgType();
+
+private:
+    BinaryLog();
+    ~BinaryLog();
+
+    BinaryLog(const BinaryLog&) = delete;
+    BinaryLog& operator=(const BinaryLog&) = delete;
+
+    struct ThreadBuffer {
+        std::vector<uint8_t> data;
+        size_t used = 0;
+        size_t records = 0;
+        uint32_t threadIndex = 0;
+        uint32_t generation = 0;    // Open() count the buffer belongs to
+        ~ThreadBuffer();
+    };
+
+    struct Format {
+        uint16_t id;
+        std::vector<BinaryArgType> types;
+        int line;
+        std::string file;
+        std::string format;
+    };
+
+    struct Block {
+        uint32_t threadIndex;
+        size_t records;
+        std::vector<uint8_t> data;
+    };
+
+    uint16_t Register(BinaryFormatSite& site, const char* format, const BinaryArgType* types, size_t count);
+    ThreadBuffer& GetThreadBuffer();
+    void Submit(ThreadBuffer& buffer, bool keepWriting = true);
+    void WriterLoop();
+    void CloseFile();
+
+    static size_t ArgSize(const std::string& value) { return 2 + std::min(value.size(), MAX_STRING); }
+    static size_t ArgSize(const char* value) { return 2 + std::min(std::strlen(value), MAX_STRING); }
+    template <typename T>
+    static size_t ArgSize(const T&) { return ArgType<T>() == BinaryArgType::Vec3 ? 12 : EncodedScalarSize(ArgType<T>()); }
+    static size_t EncodedScalarSize(BinaryArgType type);
+
+    static uint8_t* Encode(uint8_t* out, const std::string& value) { return EncodeString(out, value.data(), value.size()); }
+    static uint8_t* Encode(uint8_t* out, const char* value) { return EncodeString(out, value, std::strlen(value)); }
+    static uint8_t* Encode(uint8_t* out, const glm::vec3& value);
+    template <typename T>
+    static uint8_t* Encode(uint8_t* out, const T& value);
+    static uint8_t* EncodeString(uint8_t* out, const char* value, size_t length);
+
+    std::atomic<bool> m_open;
+    std::atomic<uint32_t> m_generation;
+    std::atomic<uint32_t> m_nextThreadIndex;
+    std::ofstream m_file;
+
+    mutable std::mutex m_mutex;     // Formats, pending blocks, file
+    std::condition_variable m_wakeCondition;
+    std::condition_variable m_writtenCondition;
+    std::vector<Format> m_formats;
+    size_t m_formatsWritten;    // Into the current file; every Open() writes the table again
+    std::vector<Block> m_pending;
+    std::vector<std::vector<uint8_t>> m_freeBuffers;
+    size_t m_submitted;
+    size_t m_written;
+    bool m_stopping;
+    std::thread m_writer;
+
+    std::atomic<size_t> m_dropped;
+    size_t m_records;
+    size_t m_bytes;
+    size_t m_blocks;
+};
+
+// One decoded record
+struct BinaryLogEntry {
+    uint32_t thread = 0;
+    double seconds = 0.0;           // Since the log was opened
+    std::string file;
+    int line = 0;
+    std::string text;
+};
+
+/**
+ * @brief Reads a BinaryLog file back (used by tools/LogDecoder and tests)
+ */
+class BinaryLogReader {
+public:
+    // Reads the whole file; entries are sorted by time (stable, so each thread keeps its order)
+    bool Load(const std::string& path);
+
+    const std::vector<BinaryLogEntry>& GetEntries() const { return entries; }
+    const std::string& GetError() const { return error; }
+    // Wall-clock time of Open() in microseconds since the epoch
+    int64_t GetStartTime() const { return startTime; }
+
+    static std::string FormatEntry(const BinaryLogEntry& entry, int64_t startTime);
+
+private:
+    std::vector<BinaryLogEntry> entries;
+    std::string error;
+    int64_t startTime = 0;
+};
+
+// ---------------------------------------------------------------------------
+
+template <typename T>
+constexpr BinaryArgType BinaryLog::ArgType() {
+    using D = typename std::decay<T>::type;
+    if constexpr (std::is_same<D, bool>::value) return BinaryArgType::Bool;
+    else if constexpr (std::is_same<D, float>::value) return BinaryArgType::Float;
+    else if constexpr (std::is_same<D, double>::value) return BinaryArgType::Double;
+    else if constexpr (std::is_same<D, glm::vec3>::value) return BinaryArgType::Vec3;
+    else if constexpr (std::is_same<D, std::string>::value || std::is_same<D, const char*>::value ||
+                       std::is_same<D, char*>::value) return BinaryArgType::String;
+    else if constexpr (std::is_enum<D>::value) return ArgType<typename std::underlying_type<D>::type>();
+    else if constexpr (std::is_integral<D>::value) {
+        if constexpr (std::is_signed<D>::value) return sizeof(D) <= 4 ? BinaryArgType::Int32 : BinaryArgType::Int64;
+        else return sizeof(D) <= 4 ? BinaryArgType::UInt32 : BinaryArgType::UInt64;
+    } else {
+        static_assert(sizeof(D) == 0, "LOG_BINARY: unsupported argument type");
+        return BinaryArgType::Int32;
+    }
+}
+
+template <typename T>
+uint8_t* BinaryLog::Encode(uint8_t* out, const T& value) {
+    constexpr BinaryArgType type = ArgType<T>();
+    using D = typename std::decay<T>::type;
+    if constexpr (std::is_enum<D>::value) {
+        return Encode(out, static_cast<typename std::underlying_type<D>::type>(value));
+    } else if constexpr (type == BinaryArgType::Bool) {
+        *out = value ? 1 : 0;
+        return out + 1;
+    } else {
+        using Stored = typename std::conditional<type == BinaryArgType::Int32, int32_t,
+                       typename std::conditional<type == BinaryArgType::UInt32, uint32_t,
+                       typename std::conditional<type == BinaryArgType::Int64, int64_t,
+                       typename std::conditional<type == BinaryArgType::UInt64, uint64_t,
+                       typename std::conditional<type == BinaryArgType::Float, float, double>::type>::type>::type>::type>::type;
+        Stored stored = static_cast<Stored>(value);
+        std::memcpy(out, &stored, sizeof(Stored));
+        return out + sizeof(Stored);
+    }
+}
+
+template <typename... Args>
+void BinaryLog::Write(BinaryFormatSite& site, const char* format, const Args&... args) {
+    uint16_t id = site.id.load(std::memory_order_acquire);
+    if (id == 0) {
+        const BinaryArgType types[] = { ArgType<Args>()..., BinaryArgType::Int32 };
+        id = Register(site, format, types, sizeof...(Args));
+        if (id == 0) return;
+    }
+
+    ThreadBuffer& buffer = GetThreadBuffer();
+    size_t size = 2 + 8;
+    ((size += ArgSize(args)), ...);
+    if (size > THREAD_BUFFER_SIZE) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (buffer.used + size > buffer.data.size()) {
+        Submit(buffer);
+    }
+
+    uint8_t* out = buffer.data.data() + buffer.used;
+    int64_t ticks = std::chrono::steady_clock::now().time_since_epoch().count();
+    std::memcpy(out, &id, 2);
+    std::memcpy(out + 2, &ticks, 8);
+    out += 10;
+    ((out = Encode(out, args)), ...);
+    buffer.used = static_cast<size_t>(out - buffer.data.data());
+    buffer.records++;
+}
+
+} // namespace VibeReaper
+
+// Hot-path telemetry: LOG_BINARY("Frame {} took {} ms", frame, ms). Same "{}"
+// placeholders as LOG_*; arguments are stored raw and formatted by LogDecoder.
+// Costs one relaxed load when the binary log isn't open.
+#define LOG_BINARY(...) \
+    do { \
+        VibeReaper::BinaryLog& vibereaperBinaryLog = VibeReaper::BinaryLog::GetInstance(); \
+        if (vibereaperBinaryLog.IsOpen()) { \
+            static VibeReaper::BinaryFormatSite vibereaperSite(__FILE__, __LINE__); \
+            vibereaperBinaryLog.Write(vibereaperSite, __VA_ARGS__); \
+        } \
+    } while (0)
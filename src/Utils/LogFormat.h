@@ -0,0 +1,96 @@
+#pragma once
+
+#include <string>
+#include <cstring>
+#include <cstdio>
+#include <type_traits>
+#include <glm/glm.hpp>
+
+namespace VibeReaper {
+
+// Minimal "{}" formatting for log messages. Each "{}" is replaced by the next
+// argument; "{{" and "}}" are literal braces. Only called once a message is
+// known to pass the level filter, so filtered messages never format anything.
+namespace LogFormat {
+
+    inline void AppendArg(std::string& out, const std::string& value) { out += value; }
+    inline void AppendArg(std::string& out, const char* value) { out += value ? value : "(null)"; }
+    inline void AppendArg(std::string& out, char value) { out += value; }
+    inline void AppendArg(std::string& out, bool value) { out += value ? "true" : "false"; }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value>::type AppendArg(std::string& out, T value) {
+        out += std::to_string(value);
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value>::type AppendArg(std::string& out, T value) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%g", static_cast<double>(value));
+        out += buffer;
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_enum<T>::value>::type AppendArg(std::string& out, T value) {
+        AppendArg(out, static_cast<typename std::underlying_type<T>::type>(value));
+    }
+
+    inline void AppendArg(std::string& out, const glm::vec2& value) {
+        out += '(';
+        AppendArg(out, value.x);
+        out += ", ";
+        AppendArg(out, value.y);
+        out += ')';
+    }
+
+    inline void AppendArg(std::string& out, const glm::vec3& value) {
+        out += '(';
+        AppendArg(out, value.x);
+        out += ", ";
+        AppendArg(out, value.y);
+        out += ", ";
+        AppendArg(out, value.z);
+        out += ')';
+    }
+
+    // No arguments left: copy the rest, unescaping braces
+    inline void FormatInto(std::string& out, const char* format) {
+        for (; *format; ++format) {
+            if ((format[0] == '{' && format[1] == '{') || (format[0] == '}' && format[1] == '}')) ++format;
+            out += *format;
+        }
+    }
+
+    template <typename T, typename... Rest>
+    void FormatInto(std::string& out, const char* format, const T& first, const Rest&... rest) {
+        for (; *format; ++format) {
+            if ((format[0] == '{' && format[1] == '{') || (format[0] == '}' && format[1] == '}')) {
+                out += *format++;
+                continue;
+            }
+            if (format[0] == '{' && format[1] == '}') {
+                AppendArg(out, first);
+                FormatInto(out, format + 2, rest...);
+                return;
+            }
+            out += *format;
+        }
+
+        // More arguments than placeholders: append them rather than lose them
+        out += " [";
+        AppendArg(out, first);
+        out += ']';
+        FormatInto(out, "", rest...);
+    }
+
+} // namespace LogFormat
+
+template <typename... Args>
+std::string FormatLog(const char* format, const Args&... args) {
+    std::string out;
+    out.reserve(std::strlen(format) + 16 * sizeof...(Args));
+    LogFormat::FormatInto(out, format, args...);
+    return out;
+}
+
+} // namespace VibeReaper
@@ -1,79 +1,484 @@
 #include "Logger.h"
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <algorithm>
+#include <cctype>
+#include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 namespace VibeReaper {
 
+namespace {
+    // Idle writer wakes this often; producers only signal when it matters
+    const std::chrono::milliseconds WRITER_INTERVAL(5);
+    // How long a WARNING/ERROR waits for queue space before it is dropped too
+    const std::chrono::milliseconds OVERLOAD_WAIT(100);
+
+#ifdef _WIN32
+    const int STDERR_FD = 2;
+    int OpenForAppend(const char* path) { return _open(path, _O_WRONLY | _O_APPEND); }
+    void CloseRaw(int fd) { _close(fd); }
+    void WriteRaw(int fd, const char* text, size_t length) { _write(fd, text, static_cast<unsigned int>(length)); }
+#else
+    const int STDERR_FD = STDERR_FILENO;
+    int OpenForAppend(const char* path) { return open(path, O_WRONLY | O_APPEND); }
+    void CloseRaw(int fd) { close(fd); }
+    void WriteRaw(int fd, const char* text, size_t length) {
+        while (length > 0) {
+            ssize_t written = write(fd, text, length);
+            if (written <= 0) return;
+            text += written;
+            length -= static_cast<size_t>(written);
+        }
+    }
+#endif
+
+    void WriteRaw(int fd, const char* text) {
+        WriteRaw(fd, text, std::strlen(text));
+    }
+
+    // Set before the handlers are installed; the handler must not construct the logger
+    Logger* g_crashLogger = nullptr;
+
+    void OnFatalSignal(int signal) {
+        const char* name = "fatal signal";
+        switch (signal) {
+            case SIGSEGV: name = "SIGSEGV"; break;
+            case SIGABRT: name = "SIGABRT"; break;
+            case SIGFPE:  name = "SIGFPE"; break;
+            case SIGILL:  name = "SIGILL"; break;
+        }
+        if (g_crashLogger) {
+            g_crashLogger->WriteQueuedRaw(name);
+        }
+
+        // Let the default handler terminate the process (and write a core dump)
+        std::signal(signal, SIG_DFL);
+        std::raise(signal);
+    }
+
+    void OnTerminate() {
+        Logger::GetInstance().EmergencyFlush("std::terminate");
+        std::abort();
+    }
+}
+
 Logger& Logger::GetInstance() {
     static Logger instance;
     return instance;
 }
 
-Logger::Logger() : m_consoleOutput(true) {
+Logger::Logger()
+    : m_consoleOutput(true), m_async(true), m_queue(QUEUE_CAPACITY),
+      m_running(false), m_stopping(false), m_crashed(false), m_crashFd(-1), m_outputBusy(false),
+      m_cachedSecond(-1), m_reportedDrops(0),
+      m_submitted(0), m_written(0), m_dropped(0), m_batches(0) {
+    SetLevel(LogLevel::INFO);
+
     // Constructor - logger starts with console output enabled
     // Open log file for writing
     m_logFile.open("VibeReaper.log", std::ios::out | std::ios::trunc);
     if (m_logFile.is_open()) {
         m_logFile << "=== VibeReaper Log Started ===" << std::endl;
     }
+
+    m_writer = std::thread(&Logger::WriterLoop, this);
+    m_running = true;
+}
+
+void Logger::InstallCrashHandlers() {
+    Logger& logger = GetInstance();
+    if (g_crashLogger) return;
+
+    // Opened now: open() is not something to attempt from a crashing process
+    if (logger.m_logFile.is_open()) {
+        logger.m_crashFd = OpenForAppend("VibeReaper.log");
+    }
+    g_crashLogger = &logger;
+
+    // Queued messages are usually the ones explaining a crash, so write them out first
+    std::signal(SIGSEGV, OnFatalSignal);
+    std::signal(SIGABRT, OnFatalSignal);
+    std::signal(SIGFPE, OnFatalSignal);
+    std::signal(SIGILL, OnFatalSignal);
+    std::set_terminate(OnTerminate);
 }
 
 Logger::~Logger() {
-    // Destructor
+    // Destructor - drain the queue and stop the writer
+    if (m_running) {
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_stopping = true;
+        }
+        m_wakeCondition.notify_one();
+        m_writer.join();
+        m_running = false;
+    }
+
     if (m_logFile.is_open()) {
         m_logFile << "=== VibeReaper Log Ended ===" << std::endl;
         m_logFile.close();
     }
+    if (g_crashLogger == this) {
+        g_crashLogger = nullptr;
+    }
+    if (m_crashFd >= 0) {
+        CloseRaw(m_crashFd);
+        m_crashFd = -1;
+    }
 }
 
-void Logger::Log(LogLevel level, const std::string& message) {
-    std::string timestamp = GetTimestamp();
-    std::string levelStr = LevelToString(level);
-    std::string colorCode = GetColorCode(level);
+void Logger::Log(LogLevel level, std::string message, LogCategory category) {
+    if (!IsEnabled(level, category)) return;
 
-    // Format: [TIMESTAMP] [LEVEL] Message
-    std::string formattedMessage = "[" + timestamp + "] [" + levelStr + "] " + message;
+    LogRecord record;
+    record.level = level;
+    record.category = category;
+    record.console = m_consoleOutput.load(std::memory_order_relaxed);
+    record.time = std::chrono::system_clock::now();
+    record.message = std::move(message);
 
-    if (m_consoleOutput) {
-        // Output to console with color (Windows console supports ANSI colors in Win10+)
-        std::cout << colorCode << formattedMessage << "\033[0m" << std::endl;
+    if (!m_async.load(std::memory_order_relaxed) || !m_running.load(std::memory_order_acquire)) {
+        WriteSync(record);
+        return;
     }
 
-    // Always write to log file
-    if (m_logFile.is_open()) {
-        m_logFile << formattedMessage << std::endl;
-        m_logFile.flush(); // Flush immediately so logs are written even if crash occurs
+    if (!m_queue.TryPush(std::move(record))) {
+        WakeWriter();
+        if (level < LogLevel::WARNING) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // Warnings and errors wait for the writer to make room rather than vanish
+        auto deadline = std::chrono::steady_clock::now() + OVERLOAD_WAIT;
+        while (!m_queue.TryPush(std::move(record))) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            std::this_thread::yield();
+        }
+    }
+    m_submitted.fetch_add(1, std::memory_order_release);
+
+    if (level == LogLevel::ERR) {
+        // Errors are on disk before the caller carries on (or crashes)
+        Flush();
+    } else if (m_queue.Size() >= m_queue.Capacity() / 2) {
+        WakeWriter();
     }
 }
 
-void Logger::Debug(const std::string& message) {
-    Log(LogLevel::DEBUG, message);
+void Logger::Debug(std::string message) {
+    Log(LogLevel::DEBUG, std::move(message));
 }
 
-void Logger::Info(const std::string& message) {
-    Log(LogLevel::INFO, message);
+void Logger::Info(std::string message) {
+    Log(LogLevel::INFO, std::move(message));
 }
 
-void Logger::Warning(const std::string& message) {
-    Log(LogLevel::WARNING, message);
+void Logger::Warning(std::string message) {
+    Log(LogLevel::WARNING, std::move(message));
 }
 
-void Logger::LogError(const std::string& message) {
-    Log(LogLevel::ERR, message);
+void Logger::LogError(std::string message) {
+    Log(LogLevel::ERR, std::move(message));
 }
 
 void Logger::SetConsoleOutput(bool enabled) {
     m_consoleOutput = enabled;
 }
 
-std::string Logger::GetTimestamp() const {
-    auto now = std::time(nullptr);
-    auto tm = *std::localtime(&now);
-    
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
-    return oss.str();
+void Logger::SetLevel(LogCategory category, LogLevel level) {
+    m_levels[static_cast<size_t>(category)].store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+void Logger::SetLevel(LogLevel level) {
+    for (auto& categoryLevel : m_levels) {
+        categoryLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+    }
+}
+
+LogLevel Logger::GetLevel(LogCategory category) const {
+    return static_cast<LogLevel>(m_levels[static_cast<size_t>(category)].load(std::memory_order_relaxed));
+}
+
+bool Logger::ConfigureLevels(const std::string& spec) {
+    auto parseLevel = [](const std::string& name, LogLevel& level) {
+        if (name == "debug") level = LogLevel::DEBUG;
+        else if (name == "info") level = LogLevel::INFO;
+        else if (name == "warning") level = LogLevel::WARNING;
+        else if (name == "error") level = LogLevel::ERR;
+        else return false;
+        return true;
+    };
+
+    // Parse everything first so a typo doesn't leave half the levels applied
+    int levels[static_cast<size_t>(LogCategory::Count)];
+    for (size_t i = 0; i < static_cast<size_t>(LogCategory::Count); i++) {
+        levels[i] = m_levels[i].load(std::memory_order_relaxed);
+    }
+
+    std::stringstream entries(spec);
+    std::string entry;
+    while (std::getline(entries, entry, ',')) {
+        entry.erase(std::remove_if(entry.begin(), entry.end(), [](unsigned char c) { return std::isspace(c); }), entry.end());
+        std::transform(entry.begin(), entry.end(), entry.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (entry.empty()) continue;
+
+        LogLevel level;
+        size_t equals = entry.find('=');
+        if (equals == std::string::npos) {
+            if (!parseLevel(entry, level)) return false;
+            std::fill(std::begin(levels), std::end(levels), static_cast<int>(level));
+            continue;
+        }
+
+        if (!parseLevel(entry.substr(equals + 1), level)) return false;
+        std::string categoryName = entry.substr(0, equals);
+        size_t category = 0;
+        while (category < static_cast<size_t>(LogCategory::Count) &&
+               categoryName != CategoryToString(static_cast<LogCategory>(category))) {
+            category++;
+        }
+        if (category == static_cast<size_t>(LogCategory::Count)) return false;
+        levels[category] = static_cast<int>(level);
+    }
+
+    for (size_t i = 0; i < static_cast<size_t>(LogCategory::Count); i++) {
+        m_levels[i].store(levels[i], std::memory_order_relaxed);
+    }
+    return true;
+}
+
+const char* Logger::CategoryToString(LogCategory category) {
+    switch (category) {
+        case LogCategory::General: return "general";
+        case LogCategory::Render:  return "render";
+        case LogCategory::Map:     return "map";
+        case LogCategory::Assets:  return "assets";
+        case LogCategory::Input:   return "input";
+        case LogCategory::Game:    return "game";
+        default:                   return "unknown";
+    }
+}
+
+void Logger::SetAsync(bool enabled) {
+    if (!enabled) {
+        // Keep ordering: everything queued goes out before the first direct write
+        Flush();
+    }
+    m_async = enabled;
+}
+
+void Logger::Flush() {
+    if (!m_running.load(std::memory_order_acquire) || std::this_thread::get_id() == m_writer.get_id()) return;
+
+    size_t target = m_submitted.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    m_wakeCondition.notify_one();
+    m_flushedCondition.wait(lock, [this, target]() {
+        return m_written.load(std::memory_order_acquire) >= target || m_stopping.load();
+    });
+}
+
+void Logger::EmergencyFlush(const char* reason) {
+    if (m_crashed.exchange(true)) return;
+
+    // If the crashing thread (or the writer) holds the output, it never comes
+    // back; give up after a short wait and flush what the streams already have
+    if (AcquireOutput(std::chrono::milliseconds(200))) {
+        while (DrainQueue() > 0) {}
+
+        LogRecord notice;
+        notice.level = LogLevel::ERR;
+        notice.time = std::chrono::system_clock::now();
+        notice.message = std::string("Fatal error (") + reason + "), log flushed";
+        AppendRecord(notice);
+        WriteBatch();
+        ReleaseOutput();
+    }
+    m_logFile.flush();
+    std::cout.flush();
+}
+
+void Logger::WriteQueuedRaw(const char* reason) {
+    if (m_crashed.exchange(true)) return;
+
+    // Unformatted: level and message only, the timestamps would need strftime
+    WriteRaw(STDERR_FD, "Fatal error (");
+    WriteRaw(STDERR_FD, reason);
+    WriteRaw(STDERR_FD, "), unwritten log messages follow\n");
+    if (m_crashFd >= 0) {
+        WriteRaw(m_crashFd, "=== Fatal error (");
+        WriteRaw(m_crashFd, reason);
+        WriteRaw(m_crashFd, "), unwritten log messages follow ===\n");
+    }
+
+    m_queue.PeekUnsafe([this](const LogRecord& record) {
+        const char* level = LevelToString(record.level);
+        if (m_crashFd >= 0) {
+            WriteRaw(m_crashFd, "[");
+            WriteRaw(m_crashFd, level);
+            WriteRaw(m_crashFd, "] ");
+            WriteRaw(m_crashFd, record.message.data(), record.message.size());
+            WriteRaw(m_crashFd, "\n");
+        }
+        if (record.console) {
+            WriteRaw(STDERR_FD, "[");
+            WriteRaw(STDERR_FD, level);
+            WriteRaw(STDERR_FD, "] ");
+            WriteRaw(STDERR_FD, record.message.data(), record.message.size());
+            WriteRaw(STDERR_FD, "\n");
+        }
+    });
+}
+
+LoggerStats Logger::GetStats() const {
+    LoggerStats stats;
+    stats.submitted = m_submitted.load();
+    stats.written = m_written.load();
+    stats.dropped = m_dropped.load();
+    stats.batches = m_batches.load();
+    return stats;
+}
+
+void Logger::WriterLoop() {
+    while (true) {
+        if (AcquireOutput(std::chrono::milliseconds(1000))) {
+            while (DrainQueue() > 0) {}
+            ReleaseOutput();
+        }
+
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_flushedCondition.notify_all();
+        if (m_stopping && m_queue.Size() == 0) break;
+        if (m_queue.Size() == 0) {
+            m_wakeCondition.wait_for(lock, WRITER_INTERVAL);
+        }
+    }
+    m_flushedCondition.notify_all();
+}
+
+void Logger::WriteSync(LogRecord& record) {
+    while (!AcquireOutput(std::chrono::milliseconds(1000))) {}
+    AppendRecord(record);
+    WriteBatch();
+    ReleaseOutput();
+
+    m_submitted.fetch_add(1, std::memory_order_relaxed);
+    m_written.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t Logger::DrainQueue() {
+    LogRecord record;
+    size_t count = 0;
+    while (count < MAX_BATCH && m_queue.TryPop(record)) {
+        AppendRecord(record);
+        count++;
+    }
+
+    size_t dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped != m_reportedDrops) {
+        LogRecord notice;
+        notice.level = LogLevel::WARNING;
+        notice.console = m_consoleOutput.load(std::memory_order_relaxed);
+        notice.time = std::chrono::system_clock::now();
+        notice.message = "Logger queue full, dropped " + std::to_string(dropped - m_reportedDrops) + " messages";
+        AppendRecord(notice);
+        m_reportedDrops = dropped;
+    }
+
+    WriteBatch();
+    m_written.fetch_add(count, std::memory_order_release);
+    return count;
+}
+
+void Logger::AppendRecord(const LogRecord& record) {
+    const std::string& timestamp = GetTimestamp(record.time);
+    const char* levelStr = LevelToString(record.level);
+
+    // Format: [TIMESTAMP] [LEVEL] Message, or [TIMESTAMP] [LEVEL] [category] Message
+    size_t lineStart = m_fileBatch.size();
+    m_fileBatch += '[';
+    m_fileBatch += timestamp;
+    m_fileBatch += "] [";
+    m_fileBatch += levelStr;
+    m_fileBatch += "] ";
+    if (record.category != LogCategory::General) {
+        m_fileBatch += '[';
+        m_fileBatch += CategoryToString(record.category);
+        m_fileBatch += "] ";
+    }
+    m_fileBatch += record.message;
+
+    if (record.console) {
+        // Output to console with color (Windows console supports ANSI colors in Win10+)
+        m_consoleBatch += GetColorCode(record.level);
+        m_consoleBatch.append(m_fileBatch, lineStart, std::string::npos);
+        m_consoleBatch += "\033[0m\n";
+    }
+    m_fileBatch += '\n';
+}
+
+void Logger::WriteBatch() {
+    if (!m_consoleBatch.empty()) {
+        std::cout.write(m_consoleBatch.data(), static_cast<std::streamsize>(m_consoleBatch.size()));
+        std::cout.flush();
+        m_consoleBatch.clear();
+    }
+
+    // Always write to log file, flushed once per batch instead of per message
+    if (!m_fileBatch.empty()) {
+        if (m_logFile.is_open()) {
+            m_logFile.write(m_fileBatch.data(), static_cast<std::streamsize>(m_fileBatch.size()));
+            m_logFile.flush();
+        }
+        m_fileBatch.clear();
+        m_batches.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Logger::WakeWriter() {
+    // Taking the lock orders this with the writer's check-then-sleep
+    { std::lock_guard<std::mutex> lock(m_wakeMutex); }
+    m_wakeCondition.notify_one();
+}
+
+bool Logger::AcquireOutput(std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (m_outputBusy.exchange(true, std::memory_order_acquire)) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+void Logger::ReleaseOutput() {
+    m_outputBusy.store(false, std::memory_order_release);
+}
+
+const std::string& Logger::GetTimestamp(std::chrono::system_clock::time_point time) {
+    // Only reformat when the second changes; most batches share one
+    std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+    if (seconds != m_cachedSecond) {
+        char buffer[32];
+        std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", std::localtime(&seconds));
+        m_cachedTimestamp = buffer;
+        m_cachedSecond = seconds;
+    }
+    return m_cachedTimestamp;
 }
 
-std::string Logger::LevelToString(LogLevel level) const {
+const char* Logger::LevelToString(LogLevel level) const {
     switch (level) {
         case LogLevel::DEBUG:   return "DEBUG";
         case LogLevel::INFO:    return "INFO";
@@ -83,7 +488,7 @@ std::string Logger::LevelToString(LogLevel level) const {
     }
 }
 
-std::string Logger::GetColorCode(LogLevel level) const {
+const char* Logger::GetColorCode(LogLevel level) const {
     // ANSI color codes for terminal output
     switch (level) {
         case LogLevel::DEBUG:   return "\033[36m"; // Cyan
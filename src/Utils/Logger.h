@@ -1,11 +1,19 @@
 #pragma once
 
+#include "MpscRingBuffer.h"
+#include "LogFormat.h"
 #include <string>
 #include <fstream>
 #include <iostream>
 #include <ctime>
 #include <iomanip>
 #include <sstream>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 namespace VibeReaper {
 
@@ -17,23 +25,100 @@ enum class LogLevel {
     ERR
 };
 
+// Subsystems with their own runtime level (Logger::SetLevel)
+enum class LogCategory : uint8_t {
+    General,
+    Render,
+    Map,
+    Assets,
+    Input,
+    Game,
+    Count
+};
+
+// One queued message; formatted on the writer thread
+struct LogRecord {
+    LogLevel level = LogLevel::INFO;
+    LogCategory category = LogCategory::General;
+    bool console = true;        // Console output setting when it was logged
+    std::chrono::system_clock::time_point time;
+    std::string message;
+};
+
+struct LoggerStats {
+    size_t submitted = 0;       // Queued (async) or written directly (sync)
+    size_t written = 0;
+    size_t dropped = 0;         // Queue full; DEBUG/INFO only unless a wait timed out
+    size_t batches = 0;         // Writes done by the writer thread
+};
+
 class Logger {
 public:
     // Get singleton instance
     static Logger& GetInstance();
 
     // Main logging function
-    void Log(LogLevel level, const std::string& message);
+    // Async (default): queues the message and returns; a background thread
+    // formats and writes in batches. Errors are flushed before returning.
+    void Log(LogLevel level, std::string message, LogCategory category = LogCategory::General);
+
+    // Used by the LOG_* macros once IsEnabled() passed: either a ready-made
+    // message, or a "{}" format string whose arguments are formatted here
+    void Write(LogLevel level, LogCategory category, std::string message) {
+        Log(level, std::move(message), category);
+    }
+    template <typename... Args>
+    void Write(LogLevel level, LogCategory category, const char* format, const Args&... args) {
+        Log(level, FormatLog(format, args...), category);
+    }
+
+    // Runtime filtering per category (default INFO everywhere)
+    bool IsEnabled(LogLevel level, LogCategory category) const {
+        return static_cast<int>(level) >= m_levels[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+    }
+    void SetLevel(LogCategory category, LogLevel level);
+    void SetLevel(LogLevel level);  // All categories
+    LogLevel GetLevel(LogCategory category) const;
+
+    // Apply a level spec like "warning,map=debug,render=info" (a bare level sets
+    // every category); returns false and changes nothing if any entry is invalid
+    bool ConfigureLevels(const std::string& spec);
+
+    static const char* CategoryToString(LogCategory category);
 
     // Helper methods for specific log levels
-    void Debug(const std::string& message);
-    void Info(const std::string& message);
-    void Warning(const std::string& message);
-    void LogError(const std::string& message);
+    void Debug(std::string message);
+    void Info(std::string message);
+    void Warning(std::string message);
+    void LogError(std::string message);
 
     // Enable/disable console output
     void SetConsoleOutput(bool enabled);
 
+    // Switch between the background writer and writing on the calling thread
+    void SetAsync(bool enabled);
+    bool IsAsync() const { return m_async.load(std::memory_order_relaxed); }
+
+    // Block until everything logged so far has been written
+    void Flush();
+
+    // Write out whatever is queued from std::terminate. Best effort: the process
+    // is already in an undefined state.
+    void EmergencyFlush(const char* reason);
+
+    // Write the messages still queued straight to the log file and stderr with
+    // write(2): no formatting, locks or allocation, so it is async-signal-safe
+    void WriteQueuedRaw(const char* reason);
+
+    // Flush queued messages on SIGSEGV/SIGABRT/SIGFPE/SIGILL and std::terminate.
+    // Process-wide, so only main() calls it; tests and tools keep their handlers.
+    static void InstallCrashHandlers();
+
+    LoggerStats GetStats() const;
+
+    static constexpr size_t QUEUE_CAPACITY = 8192;
+    static constexpr size_t MAX_BATCH = 256;
+
 private:
     Logger();
     ~Logger();
@@ -42,18 +127,103 @@ private:
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
 
-    std::string GetTimestamp() const;
-    std::string LevelToString(LogLevel level) const;
-    std::string GetColorCode(LogLevel level) const;
+    void WriterLoop();
+    void WriteSync(LogRecord& record);
+    size_t DrainQueue();
+    void AppendRecord(const LogRecord& record);
+    void WriteBatch();
+    void WakeWriter();
+    bool AcquireOutput(std::chrono::milliseconds timeout);
+    void ReleaseOutput();
+
+    const std::string& GetTimestamp(std::chrono::system_clock::time_point time);
+    const char* LevelToString(LogLevel level) const;
+    const char* GetColorCode(LogLevel level) const;
 
-    bool m_consoleOutput;
+    std::atomic<bool> m_consoleOutput;
+    std::atomic<bool> m_async;
+    std::atomic<int> m_levels[static_cast<size_t>(LogCategory::Count)];
     std::ofstream m_logFile;
+
+    MpscRingBuffer<LogRecord> m_queue;
+    std::thread m_writer;
+    std::atomic<bool> m_running;
+    std::atomic<bool> m_stopping;
+    std::atomic<bool> m_crashed;
+    int m_crashFd;              // Second descriptor of the log file for WriteQueuedRaw()
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+    std::condition_variable m_flushedCondition;
+
+    // Held by whoever is formatting/writing (writer thread, sync caller or crash
+    // handler); it also makes that thread the queue's single consumer
+    std::atomic<bool> m_outputBusy;
+    std::string m_consoleBatch;
+    std::string m_fileBatch;
+    std::time_t m_cachedSecond;
+    std::string m_cachedTimestamp;
+    size_t m_reportedDrops;
+
+    std::atomic<size_t> m_submitted;
+    std::atomic<size_t> m_written;
+    std::atomic<size_t> m_dropped;
+    std::atomic<size_t> m_batches;
 };
 
 } // namespace VibeReaper
 
-// Convenience macros for easy logging
-#define LOG_DEBUG(msg) VibeReaper::Logger::GetInstance().Debug(msg)
-#define LOG_INFO(msg) VibeReaper::Logger::GetInstance().Info(msg)
-#define LOG_WARNING(msg) VibeReaper::Logger::GetInstance().Warning(msg)
-#define LOG_ERROR(msg) VibeReaper::Logger::GetInstance().LogError(msg)
+// Messages below this level compile to nothing (0 = DEBUG ... 3 = ERROR).
+// Set with -DVIBEREAPER_LOG_MIN_LEVEL=<n>; runtime levels filter the rest.
+#ifndef VIBEREAPER_LOG_MIN_LEVEL
+#define VIBEREAPER_LOG_MIN_LEVEL 0
+#endif
+
+// Arguments are only evaluated (and formatted) when the message is emitted
+#define VIBEREAPER_LOG(level, category, ...) \
+    do { \
+        VibeReaper::Logger& vibereaperLogger = VibeReaper::Logger::GetInstance(); \
+        if (vibereaperLogger.IsEnabled(level, category)) { \
+            vibereaperLogger.Write(level, category, __VA_ARGS__); \
+        } \
+    } while (0)
+
+// Compiled-out level: still type-checked (so variables only logged don't turn
+// into unused warnings), but the branch is constant false and emits no code
+#define VIBEREAPER_LOG_DISABLED(level, category, ...) \
+    do { \
+        if (false) { \
+            VibeReaper::Logger::GetInstance().Write(level, category, __VA_ARGS__); \
+        } \
+    } while (0)
+
+// Convenience macros for easy logging. Take either a message or a format:
+//   LOG_INFO("Loaded " + path);
+//   LOG_INFO("Brush has {} vertices", vertices.size());
+// LOG_CAT_* take a LogCategory name first: LOG_CAT_DEBUG(Map, "...", ...)
+#if VIBEREAPER_LOG_MIN_LEVEL <= 0
+#define LOG_DEBUG(...) VIBEREAPER_LOG(VibeReaper::LogLevel::DEBUG, VibeReaper::LogCategory::General, __VA_ARGS__)
+#define LOG_CAT_DEBUG(category, ...) VIBEREAPER_LOG(VibeReaper::LogLevel::DEBUG, VibeReaper::LogCategory::category, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) VIBEREAPER_LOG_DISABLED(VibeReaper::LogLevel::DEBUG, VibeReaper::LogCategory::General, __VA_ARGS__)
+#define LOG_CAT_DEBUG(category, ...) VIBEREAPER_LOG_DISABLED(VibeReaper::LogLevel::DEBUG, VibeReaper::LogCategory::category, __VA_ARGS__)
+#endif
+
+#if VIBEREAPER_LOG_MIN_LEVEL <= 1
+#define LOG_INFO(...) VIBEREAPER_LOG(VibeReaper::LogLevel::INFO, VibeReaper::LogCategory::General, __VA_ARGS__)
+#define LOG_CAT_INFO(category, ...) VIBEREAPER_LOG(VibeReaper::LogLevel::INFO, VibeReaper::LogCategory::category, __VA_ARGS__)
+#else
+#define LOG_INFO(...) VIBEREAPER_LOG_DISABLED(VibeReaper::LogLevel::INFO, VibeReaper::LogCategory::General, __VA_ARGS__)
+#define LOG_CAT_INFO(category, ...) VIBEREAPER_LOG_DISABLED(VibeReaper::LogLevel::INFO, VibeReaper::LogCategory::category, __VA_ARGS__)
+#endif
+
+#if VIBEREAPER_LOG_MIN_LEVEL <= 2
+#define LOG_WARNING(...) VIBEREAPER_LOG(VibeReaper::LogLevel::WARNING, VibeReaper::LogCategory::General, __VA_ARGS__)
+#define LOG_CAT_WARNING(category, ...) VIBEREAPER_LOG(VibeReaper::LogLevel::WARNING, VibeReaper::LogCategory::category, __VA_ARGS__)
+#else
+#define LOG_WARNING(...) VIBEREAPER_LOG_DISABLED(VibeReaper::LogLevel::WARNING, VibeReaper::LogCategory::General, __VA_ARGS__)
+#define LOG_CAT_WARNING(category, ...) VIBEREAPER_LOG_DISABLED(VibeReaper::LogLevel::WARNING, VibeReaper::LogCategory::category, __VA_ARGS__)
+#endif
+
+// Errors are never compiled out
+#define LOG_ERROR(...) VIBEREAPER_LOG(VibeReaper::LogLevel::ERR, VibeReaper::LogCategory::General, __VA_ARGS__)
+#define LOG_CAT_ERROR(category, ...) VIBEREAPER_LOG(VibeReaper::LogLevel::ERR, VibeReaper::LogCategory::category, __VA_ARGS__)
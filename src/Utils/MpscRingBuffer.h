@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace VibeReaper {
+
+/**
+ * @brief Bounded lock-free multi-producer / single-consumer queue
+ *
+ * Fixed array of cells, each with a sequence number telling whether it is free
+ * for the producer at a given position or holds a value for the consumer
+ * (Vyukov's bounded queue). Producers claim a position with one CAS and never
+ * block each other; TryPush() fails instead of waiting when the queue is full.
+ * TryPop() must only ever be called from one thread at a time.
+ */
+template <typename T>
+class MpscRingBuffer {
+public:
+    // Capacity is rounded up to a power of two
+    explicit MpscRingBuffer(size_t capacity)
+        : m_capacity(RoundUpPowerOfTwo(capacity < 2 ? 2 : capacity)),
+          m_mask(m_capacity - 1),
+          m_cells(new Cell[m_capacity]),
+          m_enqueuePos(0),
+          m_dequeuePos(0) {
+        for (size_t i = 0; i < m_capacity; i++) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+    // Moves value in and returns true, or leaves it untouched and returns false when full
+    bool TryPush(T&& value) {
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &m_cells[pos & m_mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;   // Consumer hasn't freed this cell yet: full
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only
+    bool TryPop(T& out) {
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        Cell& cell = m_cells[pos & m_mask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != pos + 1) return false;   // Empty, or the producer hasn't finished writing
+
+        out = std::move(cell.value);
+        cell.sequence.store(pos + m_capacity, std::memory_order_release);
+        m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Visit the values pushed but not yet popped, oldest first, without removing
+    // them. Takes no locks and allocates nothing, so a signal handler may call it;
+    // values the consumer pops meanwhile may be torn (best effort).
+    template <typename Visitor>
+    void PeekUnsafe(Visitor&& visit) const {
+        size_t end = m_enqueuePos.load(std::memory_order_acquire);
+        for (size_t pos = m_dequeuePos.load(std::memory_order_relaxed); pos < end; pos++) {
+            const Cell& cell = m_cells[pos & m_mask];
+            if (cell.sequence.load(std::memory_order_acquire) != pos + 1) break;
+            visit(cell.value);
+        }
+    }
+
+    // Approximate when producers are active
+    size_t Size() const {
+        size_t enqueued = m_enqueuePos.load(std::memory_order_acquire);
+        size_t dequeued = m_dequeuePos.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    size_t Capacity() const { return m_capacity; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    static size_t RoundUpPowerOfTwo(size_t value) {
+        size_t result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
+
+    const size_t m_capacity;
+    const size_t m_mask;
+    std::unique_ptr<Cell[]> m_cells;
+
+    // Separate cache lines so producers and the consumer don't contend
+    alignas(64) std::atomic<size_t> m_enqueuePos;
+    alignas(64) std::atomic<size_t> m_dequeuePos;     // Only written by the consumer
+};
+
+} // namespace VibeReaper
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <cstdlib>
 #include <glad/glad.h>
 #include <SDL2/SDL.h>
 #include <glm/glm.hpp>
@@ -6,12 +7,16 @@
 #include <glm/gtc/type_ptr.hpp>
 #include "Engine/Renderer.h"
 #include "Engine/Shader.h"
+#include "Engine/DebugDraw.h"
 #include "Engine/Mesh.h"
 #include "Engine/Texture.h"
 #include "Engine/Camera.h"
 #include "Engine/Input.h"
+#include "Engine/InputRecording.h"
 #include "Engine/Constants.h"
+#include "Engine/FileWatcher.h"
 #include "Utils/Logger.h"
+#include "Utils/BinaryLog.h"
 #include "Game/World.h"
 #include "Game/Player.h"
 
@@ -48,9 +53,53 @@ const int SCREEN_WIDTH = 1280;
 const int SCREEN_HEIGHT = 720;
 
 int main(int argc, char* argv[]) {
-    // Initialize Logger
+    // Initialize Logger; queued messages are written out if the game crashes
+    Logger::InstallCrashHandlers();
+
+    // Runtime log levels, e.g. VIBEREAPER_LOG="warning,map=debug"
+    if (const char* logLevels = std::getenv("VIBEREAPER_LOG")) {
+        if (!Logger::GetInstance().ConfigureLevels(logLevels)) {
+            LOG_WARNING("Ignoring invalid VIBEREAPER_LOG: " + std::string(logLevels));
+        }
+    }
     LOG_INFO("Starting VibeReaper...");
 
+    // Repeatable benchmark runs: record a session, then replay it on any build
+    //   VibeReaper --record session.vrin
+    //   VibeReaper --replay session.vrin
+    // Large levels: --stream loads the map in regions around the player
+    std::string recordPath;
+    std::string replayPath;
+    bool streamWorld = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (arg == "--stream") {
+            streamWorld = true;
+        } else {
+            LOG_WARNING("Ignoring unknown argument: " + arg);
+        }
+    }
+
+    InputReplay replay;
+    bool replaying = !replayPath.empty();
+    if (replaying) {
+        if (!replay.Load(replayPath)) {
+            LOG_ERROR("Failed to load input replay " + replayPath + ": " + replay.GetError());
+            return -1;
+        }
+        if (!replay.GetError().empty()) {
+            LOG_WARNING("Input replay " + replayPath + ": " + replay.GetError());
+        }
+        LOG_INFO("Replaying {} frames from {}", replay.GetFrameCount(), replayPath);
+    }
+
+    // Per-frame telemetry goes to VibeReaper.log.bin (tools/LogDecoder prints it)
+    BinaryLog::GetInstance().Open();
+
     // Initialize SDL
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_GAMECONTROLLER) < 0) {
         LOG_ERROR("SDL could not initialize! SDL_Error: " + std::string(SDL_GetError()));
@@ -110,24 +159,32 @@ int main(int argc, char* argv[]) {
         return -1;
     }
 
+    // Debug lines (collision bounds, stress test) stream through a ring buffer
+    DebugDraw debugDraw;
+    if (!debugDraw.Initialize()) {
+        LOG_WARNING("Debug drawing unavailable");
+    }
+    bool showCollision = false;
+    bool debugStress = false;
+
     // Load texture
+    const std::string testTexturePath = "assets/textures/test_texture.png";
     Texture texture;
-    if (!texture.LoadFromFile("assets/textures/test_texture.png")) {
+    if (!texture.LoadFromFile(testTexturePath)) {
         LOG_WARNING("Failed to load test texture, creating fallback white texture");
         texture.CreateWhiteTexture();
     }
 
     // Load world from MAP file
     World world;
+    world.SetStreaming(streamWorld);
     if (!world.LoadMap("assets/maps/debug_test.map")) {
         LOG_ERROR("Failed to load map, exiting");
         return -1;
     }
 
-    // Get player spawn position
-    glm::vec3 playerSpawn = world.GetPlayerSpawnPosition();
-    // Transform spawn position from Z-up to Y-up: (x, y, z) -> (x, z, -y)
-    glm::vec3 engineSpawn(playerSpawn.x, playerSpawn.z, -playerSpawn.y);
+    // Get player spawn position (World converts entity origins to engine space at load)
+    glm::vec3 engineSpawn = world.GetPlayerSpawnPosition();
 
     LOG_INFO("Player spawn (Engine): " + std::to_string(engineSpawn.x) + ", " +
              std::to_string(engineSpawn.y) + ", " + std::to_string(engineSpawn.z));
@@ -140,15 +197,16 @@ int main(int argc, char* argv[]) {
     Input input;
     input.SetMouseCaptured(true); // Capture mouse for camera control
 
+    InputRecorder recorder;
+    if (!recordPath.empty() && !replaying) {
+        recorder.Open(recordPath, input);
+    }
+
     // Get light position from map (assuming first light found)
     glm::vec3 lightPos(0.0f, 500.0f, 0.0f); // Default high above
     std::vector<const Entity*> lights = world.GetEntitiesByClass("light");
     if (!lights.empty()) {
-        glm::vec3 mapLightPos = lights[0]->GetOrigin();
-        // Transform light position from Z-up to Y-up
-        lightPos = glm::vec3(mapLightPos.x, mapLightPos.z, -mapLightPos.y);
-        LOG_INFO("Light spawn (Quake): " + std::to_string(mapLightPos.x) + ", " + 
-                 std::to_string(mapLightPos.y) + ", " + std::to_string(mapLightPos.z));
+        lightPos = lights[0]->GetOrigin();
         LOG_INFO("Light spawn (Engine): " + std::to_string(lightPos.x) + ", " + 
                  std::to_string(lightPos.y) + ", " + std::to_string(lightPos.z));
     } else {
@@ -170,6 +228,14 @@ int main(int argc, char* argv[]) {
     // Lighting parameters
     glm::vec3 lightColor(1.0f, 1.0f, 1.0f);
 
+    // Hot reload: saved shaders, textures and the map apply without a restart
+    // (inotify on Linux, modification time polling elsewhere)
+    FileWatcher assetWatcher;
+    assetWatcher.WatchDirectory("assets/shaders");
+    assetWatcher.WatchDirectory("assets/textures");
+    assetWatcher.WatchDirectory("assets/maps");
+    std::vector<std::string> changedAssets;
+
     // Main loop
     bool quit = false;
     SDL_Event e;
@@ -177,6 +243,7 @@ int main(int argc, char* argv[]) {
     // Time management
     Uint64 lastTime = SDL_GetPerformanceCounter();
     double deltaTime = 0.0;
+    uint64_t frameIndex = 0;
 
     // Game Loop
     while (!quit) {
@@ -194,18 +261,66 @@ int main(int argc, char* argv[]) {
 
         if (fpsTimer >= 1.0f) {
             float fps = frameCount / fpsTimer;
-            LOG_INFO("FPS: " + std::to_string((int)fps));
+            const CullingStats& culling = world.GetCullingStats();
+            LOG_CAT_INFO(Render, "FPS: {} | World objects: {} visible, {} culled ({} by PVS, {} ms)",
+                         (int)fps, culling.visible, culling.culled, culling.pvsCulled, culling.cullMs);
+            const RenderStats& renderStats = renderer.GetRenderQueue().GetStats();
+            LOG_CAT_INFO(Render, "Render queue: {} draws, state changes {} issued / {} requested "
+                         "(programs {}/{}, VAOs {}/{}, textures {}/{}, uniforms {}/{}), sort {} ms",
+                         renderStats.drawCalls, renderStats.issued.Total(), renderStats.requested.Total(),
+                         renderStats.issued.programs, renderStats.requested.programs,
+                         renderStats.issued.vertexArrays, renderStats.requested.vertexArrays,
+                         renderStats.issued.textures, renderStats.requested.textures,
+                         renderStats.issued.uniforms, renderStats.requested.uniforms, renderStats.sortMs);
+            const EntityRenderStats& entityStats = world.GetEntityRenderStats();
+            if (entityStats.instances > 0) {
+                LOG_CAT_INFO(Render, "Entity markers: {}/{} instances in {} draws, {} KB streamed",
+                             entityStats.visible, entityStats.instances, entityStats.drawCalls,
+                             entityStats.bytesStreamed / 1024);
+            }
+            if (world.IsOcclusionCulling()) {
+                const OcclusionStats& occlusion = world.GetOcclusionStats();
+                LOG_CAT_INFO(Render, "Occlusion: {} queries, {}/{} clusters culled ({} objects), latency {} frames",
+                             occlusion.queriesIssued, occlusion.clustersCulled, occlusion.clusters,
+                             culling.occlusionCulled, occlusion.averageLatencyFrames);
+            }
+            if (world.IsStreaming()) {
+                const StreamingStats& streamStats = world.GetStreamingStats();
+                LOG_CAT_INFO(Map, "Streaming: {}/{} regions resident, {} loading, {} KB (peak {} KB), "
+                             "{} loads, {} unloads, max update {} ms",
+                             streamStats.resident, streamStats.regions, streamStats.loading,
+                             streamStats.residentBytes / 1024, streamStats.peakBytes / 1024,
+                             streamStats.loads, streamStats.unloads, streamStats.maxUpdateMs);
+            }
+            if (showCollision || debugStress) {
+                const DebugDrawStats& debugStats = debugDraw.GetStats();
+                const StreamBufferStats& streamStats = debugDraw.GetStreamStats();
+                LOG_CAT_INFO(Render, "Debug draw: {} vertices/frame ({} M/s, {} dropped), upload {} ms, "
+                             "{} fence stalls ({} ms total)",
+                             debugStats.vertices, debugStats.vertices * fps / 1e6f, debugStats.dropped,
+                             debugStats.uploadMs, streamStats.stalls, streamStats.waitMs);
+            }
+            const InputLatencyStats& latency = input.GetLatencyStats();
+            if (latency.frames > 0) {
+                LOG_CAT_INFO(Input, "Input to present: {} ms avg, {} ms max over {} frames, {} events dropped",
+                             latency.averageMs, latency.maxMs, latency.frames, input.GetDroppedEventCount());
+                input.ResetLatencyStats();
+            }
             fpsTimer = 0.0f;
             frameCount = 0;
         }
 
-        // Prepare input state (snapshot previous keyboard state)
+        // Start a new input frame
         input.Prepare();
 
         // Handle Events
         while (SDL_PollEvent(&e) != 0) {
-            // Process input events
-            input.ProcessEvent(e);
+            // Process input events (a replay feeds Input itself; Esc still aborts it)
+            if (!replaying) {
+                input.ProcessEvent(e);
+            } else if (e.type == SDL_KEYDOWN && e.key.keysym.scancode == SDL_SCANCODE_ESCAPE) {
+                quit = true;
+            }
 
             if (e.type == SDL_QUIT) {
                 quit = true;
@@ -218,22 +333,74 @@ int main(int argc, char* argv[]) {
                     camera.SetAspectRatio((float)width / (float)height);
                 }
             }
-            else if (e.type == SDL_KEYDOWN) {
-                if (e.key.keysym.sym == SDLK_ESCAPE) {
+        }
+
+        // Replays override both the input and the delta time, so the simulation
+        // takes the same path every run; recordings store exactly what it sees
+        if (replaying && !replay.NextFrame(input, deltaTime)) {
+            break;
+        }
+        recorder.RecordFrame(input, deltaTime);
+
+        // Consume this frame's input events in order (toggles fire once per press, not on key repeat)
+        InputEvent inputEvent;
+        while (input.PollEvent(inputEvent)) {
+            if (inputEvent.type != InputEventType::KeyDown || inputEvent.repeat) continue;
+
+            switch (inputEvent.code) {
+                case SDL_SCANCODE_ESCAPE:
                     quit = true;
-                }
+                    break;
+                case SDL_SCANCODE_F3:
+                    world.SetOcclusionCulling(!world.IsOcclusionCulling());
+                    LOG_INFO(std::string("Occlusion culling ") + (world.IsOcclusionCulling() ? "enabled" : "disabled"));
+                    break;
+                case SDL_SCANCODE_F4:
+                    // Instancing stress test: 1000 markers around the player, still one draw call
+                    world.SpawnDebugMarkers(player.GetPosition(), 1000);
+                    break;
+                case SDL_SCANCODE_F5:
+                    showCollision = !showCollision;
+                    break;
+                case SDL_SCANCODE_F6:
+                    // Streaming stress test: ~400k random line vertices per frame
+                    debugStress = !debugStress;
+                    LOG_INFO(std::string("Debug draw stress test ") + (debugStress ? "enabled" : "disabled"));
+                    break;
+                default:
+                    break;
             }
         }
 
-        // Update input state
-        input.Update();
-
         // Process player input
         player.ProcessInput(input, camera, deltaTime);
 
         // Update player physics
         player.Update(deltaTime);
 
+        // Reload only what changed on disk (.pvs/.brushes caches and editor autosaves are ignored)
+        changedAssets.clear();
+        assetWatcher.Poll(changedAssets);
+        for (const std::string& path : changedAssets) {
+            if (shader.UsesFile(path)) {
+                if (shader.Reload()) {
+                    renderer.GetRenderQueue().ResetPrograms();
+                }
+            } else if (debugDraw.ReloadShader(path)) {
+                LOG_INFO("Reloaded debug line shader");
+            } else if (path == world.GetMapPath()) {
+                world.ReloadMap();
+            } else if (path == testTexturePath) {
+                texture.LoadFromFile(path);
+            } else if (world.ReloadTexture(path)) {
+                LOG_INFO("Reloading texture " + path);
+            }
+        }
+
+        // Update world (streams in async-loaded textures, moves doors near the player)
+        world.SetActivator(player.GetPosition());
+        world.Update(deltaTime);
+
         // Camera rotation via mouse
         glm::vec2 mouseDelta = input.GetMouseDelta();
         if (glm::length(mouseDelta) > 0.01f) {
@@ -288,27 +455,76 @@ int main(int argc, char* argv[]) {
         shader.SetFloat("uSpecularStrength", 0.5f);
         shader.SetFloat("uShininess", 32.0f);
 
-        // Set texture sampler to use texture unit 0
+        // Set texture sampler to use texture unit 0, world material arrays on units 1 and up
+        // (samplers of different types must not share a unit)
         shader.SetInt("uTexture", 0);
+        for (int i = 0; i < MaterialPacker::MAX_ARRAYS; i++) {
+            shader.SetInt("uTextureArrays[" + std::to_string(i) + "]", 1 + i);
+        }
+        shader.SetInt("uUseTextureArray", 0);
         
         shader.SetVec3("uColor", glm::vec3(1.0f, 1.0f, 1.0f));
 
-        // Render world with rotation (Quake Z-up to Engine Y-up)
-        glm::mat4 worldModel = glm::mat4(1.0f);
-        worldModel = glm::rotate(worldModel, glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
-        shader.SetMat4("uModel", worldModel);
+        // World and player submit draw packets; the queue sorts them and skips redundant state changes
+        RenderQueue& renderQueue = renderer.GetRenderQueue();
+        renderQueue.SetDepthRange(camera.GetNearPlane(), camera.GetFarPlane());
 
-        // World handles texture binding now
-        world.Render(shader);
+        // World handles culling and texture selection per packet
+        world.Render(shader, camera, renderQueue);
 
-        // Render player (no world rotation needed - player is already in engine space)
-        player.Render(shader);
+        // Render player
+        player.Render(shader, renderQueue, camera.GetPosition());
+
+        renderQueue.Flush();
+
+        const CullingStats& frameCulling = world.GetCullingStats();
+        LOG_BINARY("Frame {}: {} ms, {} visible / {} culled, {} draws, player at {}",
+                   frameIndex++, deltaTime * 1000.0, frameCulling.visible, frameCulling.culled,
+                   renderQueue.GetStats().drawCalls, player.GetPosition());
+
+        // Debug lines draw last, over the finished scene
+        if (showCollision) {
+            for (const auto& obj : world.GetLevelGeometry()) {
+                debugDraw.Box(obj.bounds, glm::vec3(0.2f, 1.0f, 0.2f));
+            }
+            for (const auto& entity : world.GetBrushEntities()) {
+                debugDraw.Box(entity.bounds, entity.solid ? glm::vec3(0.2f, 0.6f, 1.0f) : glm::vec3(1.0f, 0.4f, 0.2f));
+            }
+            glm::vec3 playerPos = player.GetPosition();
+            glm::vec3 halfExtents(Player::WIDTH * 0.5f, 0.0f, Player::WIDTH * 0.5f);
+            debugDraw.Box(AABB(playerPos - halfExtents, playerPos + halfExtents + glm::vec3(0.0f, Player::HEIGHT, 0.0f)),
+                          glm::vec3(1.0f, 1.0f, 0.2f));
+        }
+        if (debugStress) {
+            const int stressLines = 200000;
+            for (int i = 0; i < stressLines; i++) {
+                glm::vec3 offset(std::rand() % 1024 - 512, std::rand() % 256, std::rand() % 1024 - 512);
+                glm::vec3 from = player.GetPosition() + offset;
+                debugDraw.Line(from, from + glm::vec3(0.0f, 16.0f, 0.0f), glm::vec3((i & 255) / 255.0f, 0.3f, 1.0f));
+            }
+        }
+        debugDraw.Flush(camera.GetProjectionMatrix() * camera.GetViewMatrix());
+        renderQueue.InvalidateState();
 
         // Swap buffers
         renderer.SwapBuffers(window);
+        Uint64 presentTime = SDL_GetPerformanceCounter();
+        input.MarkPresented(presentTime);
+        if (replaying) {
+            replay.AddFrameTime((presentTime - currentTime) * 1000.0 / (double)SDL_GetPerformanceFrequency());
+        }
+    }
+
+    if (replaying) {
+        FrameTimeSummary frameTimes = replay.GetFrameTimeSummary();
+        LOG_INFO("Replay finished: {}/{} frames, frame time avg {} ms, p50 {} ms, p95 {} ms, p99 {} ms, max {} ms",
+                 replay.GetCurrentFrame(), replay.GetFrameCount(), frameTimes.averageMs, frameTimes.p50Ms,
+                 frameTimes.p95Ms, frameTimes.p99Ms, frameTimes.maxMs);
     }
 
     // Cleanup
+    recorder.Close();
+    BinaryLog::GetInstance().Close();
     SDL_GL_DeleteContext(glContext);
     SDL_DestroyWindow(window);
     SDL_Quit();
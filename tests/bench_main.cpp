@@ -0,0 +1,402 @@
+// Headless benchmarks for VibeReaper (no window or GL context)
+// Measures PVS build/load cost, how many world objects each culling stage submits
+// and the vertex memory/bandwidth of the float vs packed vertex layouts, plus
+// job system spawn/steal overhead and synchronous vs async logging cost
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <thread>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include "../src/Engine/MapLoader.h"
+#include "../src/Engine/BrushConverter.h"
+#include "../src/Engine/Mesh.h"
+#include "../src/Engine/Frustum.h"
+#include "../src/Engine/Visibility.h"
+#include "../src/Engine/JobSystem.h"
+#include "../src/Utils/Logger.h"
+#include "../src/Utils/BinaryLog.h"
+#include "test_brushes.h"
+
+using namespace VibeReaper;
+
+namespace {
+    const float ROOM_SIZE = 256.0f;
+    const float ROOM_HEIGHT = 128.0f;
+    const float WALL = 16.0f;
+    const float DOOR_WIDTH = 64.0f;
+    const float DOOR_HEIGHT = 96.0f;
+
+    double ElapsedMs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Wall segment between two rooms along one axis, with a doorway at a pseudo-random offset
+    void AddWallWithDoor(std::vector<Brush>& brushes, bool alongX, float fixed, float start, float length) {
+        float doorStart = start + WALL + static_cast<float>(std::rand() % static_cast<int>(length - 2 * WALL - DOOR_WIDTH));
+        float doorEnd = doorStart + DOOR_WIDTH;
+
+        auto box = [&](float a0, float a1, float y0, float y1) {
+            if (alongX) {
+                brushes.push_back(makeBoxBrush(glm::vec3(a0, y0, fixed), glm::vec3(a1, y1, fixed + WALL), "bench"));
+            } else {
+                brushes.push_back(makeBoxBrush(glm::vec3(fixed, y0, a0), glm::vec3(fixed + WALL, y1, a1), "bench"));
+            }
+        };
+        box(start, doorStart, 0.0f, ROOM_HEIGHT);
+        box(doorEnd, start + length, 0.0f, ROOM_HEIGHT);
+        box(doorStart, doorEnd, DOOR_HEIGHT, ROOM_HEIGHT);
+    }
+
+    // rooms x rooms grid of rooms on the XZ plane, connected by doorways, with a pillar in each room
+    std::vector<Brush> BuildLevel(int rooms) {
+        std::vector<Brush> brushes;
+        float extent = rooms * ROOM_SIZE;
+
+        brushes.push_back(makeBoxBrush(glm::vec3(-WALL, -WALL, -WALL), glm::vec3(extent + WALL, 0.0f, extent + WALL), "bench"));
+        brushes.push_back(makeBoxBrush(glm::vec3(-WALL, ROOM_HEIGHT, -WALL), glm::vec3(extent + WALL, ROOM_HEIGHT + WALL, extent + WALL), "bench"));
+        brushes.push_back(makeBoxBrush(glm::vec3(-WALL, 0, -WALL), glm::vec3(0, ROOM_HEIGHT, extent + WALL), "bench"));
+        brushes.push_back(makeBoxBrush(glm::vec3(extent, 0, -WALL), glm::vec3(extent + WALL, ROOM_HEIGHT, extent + WALL), "bench"));
+        brushes.push_back(makeBoxBrush(glm::vec3(0, 0, -WALL), glm::vec3(extent, ROOM_HEIGHT, 0), "bench"));
+        brushes.push_back(makeBoxBrush(glm::vec3(0, 0, extent), glm::vec3(extent, ROOM_HEIGHT, extent + WALL), "bench"));
+
+        for (int i = 1; i < rooms; i++) {
+            for (int j = 0; j < rooms; j++) {
+                AddWallWithDoor(brushes, false, i * ROOM_SIZE - WALL * 0.5f, j * ROOM_SIZE, ROOM_SIZE);
+                AddWallWithDoor(brushes, true, i * ROOM_SIZE - WALL * 0.5f, j * ROOM_SIZE, ROOM_SIZE);
+            }
+        }
+
+        for (int x = 0; x < rooms; x++) {
+            for (int z = 0; z < rooms; z++) {
+                glm::vec3 center((x + 0.5f) * ROOM_SIZE, 0.0f, (z + 0.5f) * ROOM_SIZE);
+                brushes.push_back(makeBoxBrush(center + glm::vec3(-16, 0, -16), center + glm::vec3(16, ROOM_HEIGHT, 16), "bench"));
+            }
+        }
+        return brushes;
+    }
+
+    AABB BrushBounds(const Brush& brush) {
+        AABB bounds(glm::vec3(1e9f), glm::vec3(-1e9f));
+        for (const auto& vertex : BrushConverter::CalculateVertices(brush.planes)) {
+            bounds.Expand(vertex);
+        }
+        return bounds;
+    }
+
+    // Spawn/steal overhead and parallel-for scaling of the job system
+    void BenchmarkJobSystem() {
+        JobSystem jobs;
+        std::printf("\nJob system (%u workers + caller):\n", jobs.GetWorkerCount());
+
+        // Empty jobs from one thread: pure spawn + schedule + counter cost
+        const int emptyJobs = 200000;
+        std::atomic<int> sink(0);
+        JobCounter counter;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < emptyJobs; i++) {
+            jobs.Run([&sink]() { sink.fetch_add(1, std::memory_order_relaxed); }, &counter);
+        }
+        jobs.Wait(counter);
+        double emptyMs = ElapsedMs(start);
+        std::printf("  Spawn + run:     %.0f ns/job (%d empty jobs)\n", emptyMs * 1e6 / emptyJobs, emptyJobs);
+
+        // Fan-out from inside jobs: children land on the spawning worker's deque and get stolen
+        JobSystemStats before = jobs.GetStats();
+        JobCounter nested;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < 1000; i++) {
+            jobs.Run([&]() {
+                for (int j = 0; j < 100; j++) {
+                    jobs.Run([&sink]() { sink.fetch_add(1, std::memory_order_relaxed); }, &nested);
+                }
+            }, &nested);
+        }
+        jobs.Wait(nested);
+        double nestedMs = ElapsedMs(start);
+        JobSystemStats after = jobs.GetStats();
+        size_t nestedJobs = after.jobsExecuted - before.jobsExecuted;
+        std::printf("  Nested fan-out:  %.0f ns/job, %.1f%% stolen (%zu jobs)\n", nestedMs * 1e6 / nestedJobs,
+                    100.0 * (after.jobsStolen - before.jobsStolen) / nestedJobs, nestedJobs);
+
+        // Parallel for over real work vs the same loop on one thread
+        const size_t count = 1 << 22;
+        std::vector<float> values(count);
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < count; i++) {
+            values[i] = std::sqrt(static_cast<float>(i)) * std::sin(static_cast<float>(i));
+        }
+        double serialMs = ElapsedMs(start);
+        start = std::chrono::steady_clock::now();
+        jobs.ParallelFor(count, 16384, [&values](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                values[i] = std::sqrt(static_cast<float>(i)) * std::sin(static_cast<float>(i));
+            }
+        });
+        double parallelMs = ElapsedMs(start);
+        std::printf("  ParallelFor:     %.2f ms vs %.2f ms serial (%.1fx, %zu elements)\n",
+                    parallelMs, serialMs, serialMs / parallelMs, count);
+    }
+
+    // Load-time brush conversion (World::LoadMap CPU stage) on 1..N threads
+    void BenchmarkBrushConversion(int rooms) {
+        std::vector<Brush> brushes = BuildLevel(rooms);
+        std::printf("\nBrush conversion (%dx%d rooms, %zu brushes, collision copies included):\n",
+                    rooms, rooms, brushes.size());
+
+        auto start = std::chrono::steady_clock::now();
+        size_t serialVertices = 0;
+        for (const auto& brush : brushes) {
+            serialVertices += BrushConverter::ConvertBrush(brush, nullptr, true).vertices.size();
+        }
+        double serialMs = ElapsedMs(start);
+        std::printf("  Serial:          %.2f ms\n", serialMs);
+
+        unsigned int maxThreads = std::max(4u, std::thread::hardware_concurrency());
+        for (unsigned int threads = 1; threads <= maxThreads; threads *= 2) {
+            JobSystem jobs(threads);
+            start = std::chrono::steady_clock::now();
+            std::vector<BrushGeometry> converted = BrushConverter::ConvertBrushes(brushes, jobs, nullptr, true);
+            double parallelMs = ElapsedMs(start);
+            size_t vertices = 0;
+            for (const auto& geometry : converted) {
+                vertices += geometry.vertices.size();
+            }
+            std::printf("  %2u workers + caller: %.2f ms (%.1fx)%s\n", threads, parallelMs, serialMs / parallelMs,
+                        vertices == serialVertices ? "" : "  MISMATCH");
+        }
+    }
+
+    // Caller latency and throughput of LOG_INFO, writing on the caller vs the background writer
+    void BenchmarkLogger(bool async, int threads, int messagesPerThread) {
+        Logger& logger = Logger::GetInstance();
+        logger.SetAsync(async);
+        logger.Flush();
+        LoggerStats before = logger.GetStats();
+
+        std::vector<std::vector<double>> latencies(threads);
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&latencies, t, messagesPerThread]() {
+                std::vector<double>& samples = latencies[t];
+                samples.reserve(messagesPerThread);
+                for (int i = 0; i < messagesPerThread; i++) {
+                    auto callStart = std::chrono::steady_clock::now();
+                    LOG_INFO("Benchmark message " + std::to_string(i) + " from thread " + std::to_string(t));
+                    samples.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - callStart).count());
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        logger.Flush();
+        double totalMs = ElapsedMs(start);
+        LoggerStats after = logger.GetStats();
+
+        std::vector<double> all;
+        for (const auto& samples : latencies) {
+            all.insert(all.end(), samples.begin(), samples.end());
+        }
+        std::sort(all.begin(), all.end());
+        double mean = 0.0;
+        for (double sample : all) mean += sample;
+        mean /= all.size();
+        size_t written = after.submitted - before.submitted;
+        std::printf("  %-5s x%d:        %.0f msg/s written, caller mean %.0f ns / p99 %.0f ns, %zu dropped\n",
+                    async ? "async" : "sync", threads, written / (totalMs / 1000.0), mean,
+                    all[all.size() * 99 / 100], after.dropped - before.dropped);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int rooms = argc > 1 ? std::atoi(argv[1]) : 8;
+    int cameras = argc > 2 ? std::atoi(argv[2]) : 1000;
+    if (rooms < 1 || cameras < 1) {
+        std::cerr << "Usage: VibeReaperBench [rooms per side] [camera samples]" << std::endl;
+        return 1;
+    }
+
+    std::srand(1337);
+    std::vector<Brush> brushes = BuildLevel(rooms);
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  VibeReaper Visibility Benchmark" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "Level: " << rooms << "x" << rooms << " rooms, " << brushes.size() << " brushes" << std::endl;
+
+    // Build + cache round trip
+    Visibility visibility;
+    if (!visibility.Build(brushes)) {
+        std::cerr << "PVS build failed" << std::endl;
+        return 1;
+    }
+    const VisibilityStats& built = visibility.GetStats();
+    std::printf("PVS build: %.2f ms (%d leaves, %d empty, %d portals, %d regions, avg %.1f visible)\n",
+                built.buildMs, built.leafCount, built.emptyLeafCount, built.portalCount, built.regionCount,
+                built.averageVisibleLeaves);
+
+    std::string pvsPath = (std::filesystem::temp_directory_path() / "vibereaper_bench.pvs").string();
+    visibility.Save(pvsPath, 1);
+    Visibility cached;
+    cached.Load(pvsPath, 1);
+    std::printf("PVS load:  %.2f ms (%ju bytes)\n", cached.GetStats().buildMs,
+                static_cast<uintmax_t>(std::filesystem::file_size(pvsPath)));
+    std::filesystem::remove(pvsPath);
+
+    // One render object per brush, registered in the leaves it touches (as World does)
+    CullingBounds cullBounds;
+    std::vector<std::vector<uint32_t>> leafObjects(visibility.GetLeafCount());
+    std::vector<int> leaves;
+    for (uint32_t index = 0; index < brushes.size(); index++) {
+        AABB bounds = BrushBounds(brushes[index]);
+        cullBounds.Add(bounds);
+        bounds.min -= glm::vec3(1.0f);
+        bounds.max += glm::vec3(1.0f);
+        visibility.GetLeavesOverlapping(bounds, leaves);
+        for (int leaf : leaves) {
+            leafObjects[leaf].push_back(index);
+        }
+    }
+
+    // Vertex bytes per object in each layout (meshes with large UVs stay float, as in SetupMesh)
+    std::vector<size_t> floatBytes(brushes.size()), packedBytes(brushes.size());
+    size_t totalFloat = 0, totalPacked = 0, floatFallbacks = 0, totalIndices = 0;
+    Logger::GetInstance().SetConsoleOutput(false);  // BrushConverter logs every brush
+    for (uint32_t index = 0; index < brushes.size(); index++) {
+        Mesh mesh = BrushConverter::ConvertBrushToMesh(brushes[index]);
+        bool packable = Mesh::CanPack(mesh.vertices);
+        floatBytes[index] = mesh.vertices.size() * sizeof(Vertex);
+        packedBytes[index] = mesh.vertices.size() * (packable ? sizeof(PackedVertex) : sizeof(Vertex));
+        if (!packable) floatFallbacks++;
+        totalIndices += mesh.indices.size();
+        totalFloat += floatBytes[index];
+        totalPacked += packedBytes[index];
+    }
+    Logger::GetInstance().SetConsoleOutput(true);
+
+    // Random cameras standing in rooms
+    glm::mat4 projection = glm::perspective(glm::radians(75.0f), 16.0f / 9.0f, 0.1f, 4096.0f);
+    std::vector<uint32_t> visibleObjects;
+    std::vector<uint32_t> objectFrame(brushes.size(), 0);
+    double frustumSubmitted = 0.0, pvsSubmitted = 0.0, frustumMs = 0.0, pvsMs = 0.0;
+    double floatFetched = 0.0, packedFetched = 0.0;
+    int fallbacks = 0;
+
+    for (int sample = 0; sample < cameras; sample++) {
+        float extent = rooms * ROOM_SIZE;
+        glm::vec3 position(24.0f + (std::rand() / static_cast<float>(RAND_MAX)) * (extent - 48.0f), 56.0f,
+                           24.0f + (std::rand() / static_cast<float>(RAND_MAX)) * (extent - 48.0f));
+        float yaw = (std::rand() / static_cast<float>(RAND_MAX)) * 6.2831853f;
+        glm::vec3 forward(std::cos(yaw), 0.0f, std::sin(yaw));
+        glm::mat4 view = glm::lookAt(position, position + forward, glm::vec3(0.0f, 1.0f, 0.0f));
+
+        auto start = std::chrono::steady_clock::now();
+        cullBounds.Cull(Frustum::FromMatrices(view, projection), visibleObjects);
+        frustumMs += ElapsedMs(start);
+        frustumSubmitted += visibleObjects.size();
+
+        start = std::chrono::steady_clock::now();
+        int cameraLeaf = visibility.FindLeaf(position);
+        if (cameraLeaf >= 0 && !visibility.IsLeafSolid(cameraLeaf)) {
+            uint32_t frame = static_cast<uint32_t>(sample + 1);
+            for (int leaf = 0; leaf < visibility.GetLeafCount(); leaf++) {
+                if (!visibility.IsLeafVisible(cameraLeaf, leaf)) continue;
+                for (uint32_t index : leafObjects[leaf]) {
+                    objectFrame[index] = frame;
+                }
+            }
+            size_t kept = 0;
+            for (uint32_t index : visibleObjects) {
+                if (objectFrame[index] == frame) kept++;
+            }
+            pvsSubmitted += kept;
+        } else {
+            fallbacks++;
+            pvsSubmitted += visibleObjects.size();
+        }
+        pvsMs += ElapsedMs(start);
+
+        // Vertex data the GPU fetches for what frustum + PVS submits (each vertex once)
+        for (uint32_t index : visibleObjects) {
+            if (cameraLeaf >= 0 && !visibility.IsLeafSolid(cameraLeaf) && objectFrame[index] != static_cast<uint32_t>(sample + 1)) {
+                continue;
+            }
+            floatFetched += floatBytes[index];
+            packedFetched += packedBytes[index];
+        }
+    }
+
+    std::printf("\nObjects submitted per frame (%d cameras):\n", cameras);
+    std::printf("  No culling:      %zu\n", brushes.size());
+    std::printf("  Frustum:         %.1f  (%.4f ms)\n", frustumSubmitted / cameras, frustumMs / cameras);
+    std::printf("  Frustum + PVS:   %.1f  (+%.4f ms)\n", pvsSubmitted / cameras, pvsMs / cameras);
+    std::printf("  Solid-leaf fallbacks: %d\n", fallbacks);
+
+    std::printf("\nVertex data (float %zu B vs packed %zu B per vertex):\n", sizeof(Vertex), sizeof(PackedVertex));
+    std::printf("  Resident:        %.1f KB -> %.1f KB  (%.0f%% saved, %zu meshes kept float)\n",
+                totalFloat / 1024.0, totalPacked / 1024.0, 100.0 - 100.0 * totalPacked / totalFloat, floatFallbacks);
+    std::printf("  Fetched/frame:   %.1f KB -> %.1f KB\n", floatFetched / cameras / 1024.0, packedFetched / cameras / 1024.0);
+    std::printf("Index data (32-bit vs 16-bit):\n");
+    std::printf("  Resident:        %.1f KB -> %.1f KB\n", totalIndices * sizeof(uint32_t) / 1024.0,
+                totalIndices * sizeof(uint16_t) / 1024.0);
+
+    BenchmarkJobSystem();
+    BenchmarkBrushConversion(rooms * 4);
+
+    // Log file only: the console would dominate both modes
+    std::printf("\nLogger (%d messages per thread, file only):\n", 20000);
+    Logger::GetInstance().SetConsoleOutput(false);
+    BenchmarkLogger(false, 1, 20000);
+    BenchmarkLogger(true, 1, 20000);
+    BenchmarkLogger(false, 4, 20000);
+    BenchmarkLogger(true, 4, 20000);
+    Logger::GetInstance().SetAsync(true);
+
+    // Below the runtime level: old-style concatenation still builds the string
+    // at the call site when called directly; the macros skip argument evaluation
+    const int filteredCalls = 1000000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < filteredCalls; i++) {
+        Logger::GetInstance().Debug("Brush has " + std::to_string(i) + " vertices");
+    }
+    double eagerNs = ElapsedMs(start) * 1e6 / filteredCalls;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < filteredCalls; i++) {
+        LOG_CAT_DEBUG(Map, "Brush has {} vertices", i);
+    }
+    double lazyNs = ElapsedMs(start) * 1e6 / filteredCalls;
+    std::printf("  Filtered DEBUG:  %.1f ns eager string vs %.1f ns macro\n", eagerNs, lazyNs);
+
+    // Binary telemetry: format ID + raw arguments into a per-thread buffer
+    std::string binaryPath = (std::filesystem::temp_directory_path() / "vibereaper_bench.log.bin").string();
+    BinaryLog::GetInstance().Open(binaryPath);
+    const int binaryCalls = 1000000;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < binaryCalls; i++) {
+        LOG_BINARY("Frame {}: {} ms, {} visible", i, 16.6f, static_cast<size_t>(i & 1023));
+    }
+    double binaryNs = ElapsedMs(start) * 1e6 / binaryCalls;
+    BinaryLog::GetInstance().Close();
+    BinaryLogStats binaryStats = BinaryLog::GetInstance().GetStats();
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 20000; i++) {
+        LOG_INFO("Frame {}: {} ms, {} visible", i, 16.6f, static_cast<size_t>(i & 1023));
+    }
+    double textNs = ElapsedMs(start) * 1e6 / 20000;
+    Logger::GetInstance().Flush();
+    std::printf("  LOG_BINARY:      %.1f ns/call vs %.0f ns async text, %.1f bytes/record\n",
+                binaryNs, textNs, static_cast<double>(binaryStats.bytes) / binaryStats.records);
+    std::filesystem::remove(binaryPath);
+    Logger::GetInstance().SetConsoleOutput(true);
+    return 0;
+}
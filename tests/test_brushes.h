@@ -0,0 +1,30 @@
+// Brush helpers shared by the unit tests and the benchmarks
+
+#pragma once
+
+#include <string>
+#include <glm/glm.hpp>
+#include "../src/Engine/MapLoader.h"
+
+namespace VibeReaper {
+
+    // Axis-aligned box brush; works in Quake (Z-up) and engine space alike
+    inline Brush makeBoxBrush(const glm::vec3& mins, const glm::vec3& maxs,
+                              const std::string& texture = "test_texture") {
+        Brush brush;
+        const glm::vec3 normals[6] = {
+            { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }
+        };
+        const float distances[6] = { maxs.x, -mins.x, maxs.y, -mins.y, maxs.z, -mins.z };
+
+        for (int i = 0; i < 6; i++) {
+            Plane plane;
+            plane.normal = normals[i];
+            plane.distance = distances[i];
+            plane.texture = texture;
+            brush.planes.push_back(plane);
+        }
+        return brush;
+    }
+
+} // namespace VibeReaper
@@ -0,0 +1,99 @@
+// VibeReaper Log Decoder
+// Turns a binary telemetry log (LOG_BINARY, VibeReaper.log.bin) back into text.
+// Records from all threads are merged by timestamp.
+//
+// Usage:
+//   LogDecoder [VibeReaper.log.bin] [options]
+//
+// Options:
+//   -o <file>         Write text to a file instead of stdout
+//   --source          Append the file:line of each LOG_BINARY call
+//   --grep <text>     Only print records containing <text>
+
+#include "../../src/Utils/BinaryLog.h"
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace VibeReaper;
+
+namespace {
+
+    struct Options {
+        std::string input = "VibeReaper.log.bin";
+        std::string output;
+        std::string filter;
+        bool source = false;
+    };
+
+    void PrintUsage() {
+        std::cout << "Usage: LogDecoder [VibeReaper.log.bin] [-o <file>] [--source] [--grep <text>]" << std::endl;
+    }
+
+    bool ParseArguments(int argc, char* argv[], Options& options) {
+        bool haveInput = false;
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "-o" && i + 1 < argc) {
+                options.output = argv[++i];
+            } else if (arg == "--grep" && i + 1 < argc) {
+                options.filter = argv[++i];
+            } else if (arg == "--source") {
+                options.source = true;
+            } else if (arg == "-h" || arg == "--help") {
+                return false;
+            } else if (!haveInput) {
+                options.input = arg;
+                haveInput = true;
+            } else {
+                std::cerr << "Unknown argument: " << arg << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!ParseArguments(argc, argv, options)) {
+        PrintUsage();
+        return 1;
+    }
+
+    BinaryLogReader reader;
+    if (!reader.Load(options.input)) {
+        std::cerr << reader.GetError() << std::endl;
+        return 1;
+    }
+    if (!reader.GetError().empty()) {
+        // Usually a crash mid-write; everything before it is still valid
+        std::cerr << "Warning: " << reader.GetError() << std::endl;
+    }
+
+    std::ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output);
+        if (!file.is_open()) {
+            std::cerr << "Could not write " << options.output << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = options.output.empty() ? std::cout : file;
+
+    size_t printed = 0;
+    for (const BinaryLogEntry& entry : reader.GetEntries()) {
+        if (!options.filter.empty() && entry.text.find(options.filter) == std::string::npos) continue;
+
+        out << BinaryLogReader::FormatEntry(entry, reader.GetStartTime());
+        if (options.source) {
+            out << "  (" << entry.file << ":" << entry.line << ")";
+        }
+        out << '\n';
+        printed++;
+    }
+
+    std::cerr << printed << " of " << reader.GetEntries().size() << " records" << std::endl;
+    return 0;
+}
@@ -0,0 +1,162 @@
+// VibeReaper Texture Compiler
+// Converts PNG textures into BC1/BC3 compressed KTX files with full mip chains.
+// The engine picks up foo.ktx automatically when it is next to foo.png and not older.
+//
+// Usage:
+//   TextureCompiler <image.png | directory> [options]
+//
+// Options:
+//   -o <file>         Output path (single image only, default: <image>.ktx)
+//   --format <fmt>    bc1, bc3 or auto (default: auto = bc3 if the image has alpha)
+//   --force           Rebuild even if the .ktx is up to date
+
+#include "../../src/Engine/Texture.h"
+#include "../../src/Engine/TextureCompression.h"
+#include "../../src/Utils/Logger.h"
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace VibeReaper;
+
+namespace {
+
+    struct Options {
+        std::string input;
+        std::string output;
+        std::string format = "auto";
+        bool force = false;
+    };
+
+    void PrintUsage() {
+        std::cout << "Usage: TextureCompiler <image.png | directory> [-o <file>] [--format bc1|bc3|auto] [--force]"
+                  << std::endl;
+    }
+
+    bool ParseArguments(int argc, char* argv[], Options& options) {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "-o" && i + 1 < argc) {
+                options.output = argv[++i];
+            } else if (arg == "--format" && i + 1 < argc) {
+                options.format = argv[++i];
+            } else if (arg == "--force") {
+                options.force = true;
+            } else if (arg == "-h" || arg == "--help") {
+                return false;
+            } else if (options.input.empty()) {
+                options.input = arg;
+            } else {
+                std::cerr << "Unknown argument: " << arg << std::endl;
+                return false;
+            }
+        }
+
+        if (options.format != "auto" && options.format != "bc1" && options.format != "bc3") {
+            std::cerr << "Unknown format: " << options.format << std::endl;
+            return false;
+        }
+
+        return !options.input.empty();
+    }
+
+    // Returns false on error
+    bool CompileTexture(const std::string& input, const std::string& output, const Options& options) {
+        auto start = std::chrono::steady_clock::now();
+
+        // Decode exactly like the runtime PNG path so orientation matches
+        int width = 0, height = 0, channels = 0;
+        unsigned char* pixels = Texture::DecodeImage(input, width, height, channels);
+        if (!pixels) {
+            std::cerr << "Failed to decode " << input << std::endl;
+            return false;
+        }
+
+        // Expand to RGBA8 for the encoder
+        std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+        for (size_t i = 0; i < static_cast<size_t>(width) * height; i++) {
+            const unsigned char* src = pixels + i * channels;
+            uint8_t* dst = &rgba[i * 4];
+            if (channels >= 3) {
+                dst[0] = src[0];
+                dst[1] = src[1];
+                dst[2] = src[2];
+                dst[3] = channels == 4 ? src[3] : 255;
+            } else {
+                dst[0] = dst[1] = dst[2] = src[0];
+                dst[3] = channels == 2 ? src[1] : 255;
+            }
+        }
+        Texture::FreeImage(pixels);
+
+        CompressedFormat format = CompressedFormat::BC1;
+        if (options.format == "bc3") {
+            format = CompressedFormat::BC3;
+        } else if (options.format == "auto") {
+            format = TextureCompression::ChooseFormat(rgba.data(), width, height);
+        }
+
+        CompressedImage image = TextureCompression::Compress(rgba.data(), width, height, format);
+        if (!TextureCompression::SaveKTX(output, image)) {
+            std::cerr << "Failed to write " << output << std::endl;
+            return false;
+        }
+
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        size_t sourceBytes = rgba.size() * 4 / 3;
+        std::cout << input << " -> " << output << " (" << width << "x" << height << ", "
+                  << (format == CompressedFormat::BC1 ? "BC1" : "BC3") << ", " << image.mips.size() << " mips, "
+                  << image.GetDataSize() / 1024 << " KB vs " << sourceBytes / 1024 << " KB RGBA, "
+                  << ms << " ms)" << std::endl;
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!ParseArguments(argc, argv, options)) {
+        PrintUsage();
+        return 1;
+    }
+
+    // Keep the console output to our own summary lines (engine log still goes to the file)
+    Logger::GetInstance().SetConsoleOutput(false);
+
+    std::error_code error;
+    std::vector<std::string> inputs;
+    if (std::filesystem::is_directory(options.input, error)) {
+        if (!options.output.empty()) {
+            std::cerr << "-o is only valid for a single image" << std::endl;
+            return 1;
+        }
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(options.input, error)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".png") {
+                inputs.push_back(entry.path().string());
+            }
+        }
+    } else {
+        inputs.push_back(options.input);
+    }
+
+    int compiled = 0, skipped = 0, failed = 0;
+    for (const auto& input : inputs) {
+        std::string output = options.output.empty() ? TextureCompression::GetCompressedPath(input) : options.output;
+
+        if (!options.force && options.output.empty() && TextureCompression::HasUpToDateCompressed(input)) {
+            skipped++;
+            continue;
+        }
+
+        if (CompileTexture(input, output, options)) {
+            compiled++;
+        } else {
+            failed++;
+        }
+    }
+
+    std::cout << compiled << " compiled, " << skipped << " up to date, " << failed << " failed" << std::endl;
+    return failed > 0 ? 1 : 0;
+}